@@ -339,4 +339,17 @@ if (m.hasMatch()) {
 //! [36]
 }
 
+{
+//! [37]
+QRegularExpressionSet filters({
+    QRegularExpression("^ERROR\\b"),
+    QRegularExpression("timeout", QRegularExpression::CaseInsensitiveOption),
+    QRegularExpression("user=(\\w+)"),
+});
+QList<qsizetype> matching = filters.matchingIndexes(u"ERROR: Timeout for user=alice");
+// matching == { 0, 1, 2 }
+bool any = filters.matchesAny(u"INFO: all good"); // false
+//! [37]
+}
+
 }
@@ -440,3 +440,28 @@ auto continuation = future.then(context, [context](Result result) {
                            });
 
 //! [37]
+
+//! [38]
+struct InlineExecutor
+{
+    void execute(QRunnable *runnable)
+    {
+        runnable->run();
+        if (runnable->autoDelete())
+            delete runnable;
+    }
+};
+
+struct IoExecutor
+{
+    QThreadPool *pool;
+    void execute(QRunnable *runnable) { pool->start(runnable); }
+};
+
+QFuture<QByteArray> future = ...;
+auto continuation = future.then(InlineExecutor{}, [](const QByteArray &data) {
+                               return parseHeader(data); // cheap, no need to switch threads
+                           }).then(IoExecutor{&ioPool}, [](const Header &header) {
+                               return readBody(header); // blocking I/O
+                           });
+//! [38]
@@ -497,6 +497,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->drainPostEventInbox();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1621,6 +1622,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     if (!object) {
         locker.threadData = QThreadData::current();
         locker.locker = qt_unique_lock(locker.threadData->postEventList.mutex);
+        locker.threadData->drainPostEventInbox();
         return locker;
     }
 
@@ -1643,9 +1645,98 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     }
 
     Q_ASSERT(locker.threadData);
+    // keep the events in the order they were posted in
+    locker.threadData->drainPostEventInbox();
     return locker;
 }
 
+/*!
+    \internal
+
+    Posts the queued meta call \a event to \a receiver without taking the
+    post event list's mutex, so that threads emitting queued signals at a
+    high rate don't contend with each other or with the receiving thread.
+    The event is pushed onto the list's lock-free inbox and moved into the
+    list when the receiving thread next looks at it.
+
+    Meta call events are posted with Qt::NormalEventPriority. They are
+    offered to QCoreApplication::compressEvent() when they are moved from the
+    inbox into the list, see compressPostedMetaCallEvent().
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QAbstractMetaCallEvent *event)
+{
+    Q_ASSERT(receiver);
+    Q_ASSERT(event);
+
+    Q_TRACE_SCOPE(QCoreApplication_postEvent, receiver, event, event->type());
+
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data;
+
+    // if receiver moves to another thread, follow it. Registering as a
+    // producer before checking again makes QObject::moveToThread() wait for
+    // us, so the event can't be pushed onto the inbox of the old thread once
+    // it has moved the posted events over.
+    for (;;) {
+        // synchronizes with the storeRelease in QObject::moveToThread
+        data = threadData.loadAcquire();
+        if (!data) {
+            // posting during destruction? just delete the event to prevent a leak
+            delete event;
+            return;
+        }
+        data->postEventList.inboxProducers.fetch_add(1, std::memory_order_seq_cst);
+        if (data == threadData.loadAcquire())
+            break;
+        data->postEventList.inboxProducers.fetch_sub(1, std::memory_order_release);
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    ++receiver->d_func()->postedEvents;
+    const bool needsWakeUp = data->postEventList.pushToInbox(receiver, event);
+    data->postEventList.inboxProducers.fetch_sub(1, std::memory_order_release);
+
+    // if the inbox wasn't empty, the thread was woken up when the first
+    // event was pushed and hasn't drained it yet
+    if (needsWakeUp) {
+        if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+            dispatcher->wakeUp();
+    }
+}
+
+/*!
+    \internal
+
+    Called with the post event list's mutex held, when the meta call \a event
+    for \a receiver is moved from the inbox into \a postedEvents. Gives
+    QCoreApplication::compressEvent(), which may be overridden, the same
+    chance to compress the event that postEvent() gives it. Returns \c true
+    if the event was compressed away, in which case it must not be added to
+    the list.
+*/
+bool QCoreApplicationPrivate::compressPostedMetaCallEvent(QObject *receiver,
+                                                          QAbstractMetaCallEvent *event,
+                                                          QPostEventList *postedEvents)
+{
+    QCoreApplication *app = QCoreApplication::self;
+    auto &receiverPostedEvents = receiver->d_func()->postedEvents;
+    // postMetaCallEvent() has counted the event already, postEvent() only
+    // asks about compression if the receiver had other events posted
+    if (!app || receiverPostedEvents.loadRelaxed() <= 1)
+        return false;
+
+    --receiverPostedEvents;
+    event->m_posted = false;
+    if (app->compressEvent(event, receiver, postedEvents)) {
+        Q_TRACE(QCoreApplication_postEvent_event_compressed, receiver, event);
+        return true;
+    }
+    event->m_posted = true;
+    ++receiverPostedEvents;
+    return false;
+}
+
 /*!
     \since 4.3
 
@@ -1803,6 +1894,8 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    // take all events queued without the lock in one go
+    data->drainPostEventInbox();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -2047,6 +2140,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->drainPostEventInbox();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
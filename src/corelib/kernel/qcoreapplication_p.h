@@ -125,6 +125,9 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void postMetaCallEvent(QObject *receiver, QAbstractMetaCallEvent *event);
+    static bool compressPostedMetaCallEvent(QObject *receiver, QAbstractMetaCallEvent *event,
+                                            QPostEventList *postedEvents);
 #endif // QT_NO_QOBJECT
 
     int &argc;
@@ -174,12 +174,176 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0 && !initEpoll())
+        qWarning("QEventDispatcherUNIX: epoll is unavailable, falling back to poll()");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
     // cleanup timers
     timerList.clearTimers();
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+}
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+static constexpr uint32_t toEpollEvents(short events)
+{
+    uint32_t result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static constexpr short fromEpollEvents(uint32_t events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    return result;
+}
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        qErrnoWarning("QEventDispatcherUNIX: epoll_create1");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1) {
+        qErrnoWarning("QEventDispatcherUNIX: epoll_ctl on the thread pipe");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+int QEventDispatcherUNIXPrivate::processEpollEvents(QDeadlineTimer deadline)
+{
+    // fds that epoll cannot watch are reported on every iteration, like
+    // poll() would, so don't block while there are any
+    if (!epollFallbackFds.isEmpty())
+        deadline = QDeadlineTimer();
+
+    epoll_event events[256];
+    int ready;
+    do {
+        int timeout = -1;
+        if (!deadline.isForever()) {
+            // round up, so we don't wake up just before a timer is due
+            constexpr nanoseconds maxTimeout = milliseconds(std::numeric_limits<int>::max());
+            const nanoseconds remaining = qMin(deadline.remainingTimeAsDuration(), maxTimeout);
+            timeout = int(std::chrono::ceil<milliseconds>(remaining).count());
+        }
+        ready = epoll_wait(epollFd, events, int(std::size(events)), timeout);
+    } while (ready == -1 && errno == EINTR);
+
+    if (ready == -1) {
+        qErrnoWarning("epoll_wait");
+        if (QT_CONFIG(poll_exit_on_error))
+            abort();
+        return 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < ready; ++i) {
+        const int fd = events[i].data.fd;
+        const short revents = fromEpollEvents(events[i].events);
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = revents;
+            nevents += threadPipe.check(pfd);
+            continue;
+        }
+
+        auto it = socketNotifiers.constFind(fd);
+        if (it != socketNotifiers.cend())
+            markPendingSocketNotifier(it, revents);
+    }
+
+    // take a copy: a POLLNVAL report disables the notifier, which edits the hash
+    const QHash<int, short> fallbackFds = epollFallbackFds;
+    for (auto fb = fallbackFds.cbegin(); fb != fallbackFds.cend(); ++fb) {
+        auto it = socketNotifiers.constFind(fb.key());
+        if (it != socketNotifiers.cend())
+            markPendingSocketNotifier(it, fb.value());
+    }
+
+    return nevents + activateSocketNotifiers();
+}
+#endif // QT_EVENTDISPATCHER_UNIX_EPOLL
+
+void QEventDispatcherUNIXPrivate::updateSocketNotifierInterest(int fd, short oldEvents,
+                                                               short newEvents)
+{
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (epollFd < 0 || oldEvents == newEvents)
+        return;
+
+    epoll_event ev = {};
+    ev.events = toEpollEvents(newEvents);
+    ev.data.fd = fd;
+    const int op = !oldEvents ? EPOLL_CTL_ADD : newEvents ? EPOLL_CTL_MOD : EPOLL_CTL_DEL;
+
+    if (op == EPOLL_CTL_DEL) {
+        // may fail with EBADF if the fd was closed first, which is fine
+        epoll_ctl(epollFd, op, fd, &ev);
+        epollFallbackFds.remove(fd);
+        return;
+    }
+
+    if (epoll_ctl(epollFd, op, fd, &ev) == 0)
+        return;
+
+    switch (errno) {
+    case EEXIST:
+        // the fd was closed and reused while a duplicate kept the old registration alive
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0)
+            return;
+        break;
+    case ENOENT:
+        // the fd was closed and reused while the notifier was still registered
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+            return;
+        break;
+    case EPERM:
+        // regular files and directories: always readable and writable for poll()
+        epollFallbackFds.insert(fd, newEvents);
+        return;
+    case EBADF:
+        epollFallbackFds.insert(fd, POLLNVAL);
+        return;
+    }
+    qErrnoWarning("QEventDispatcherUNIX: epoll_ctl for socket %d", fd);
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(oldEvents);
+    Q_UNUSED(newEvents);
+#endif
 }
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
@@ -203,38 +367,45 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
-
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+        auto it = socketNotifiers.constFind(pfd.fd);
+        Q_ASSERT(it != socketNotifiers.cend());
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
-
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+        markPendingSocketNotifier(it, pfd.revents);
+    }
 
-            if (!notifier)
-                continue;
+    pollfds.clear();
+}
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifier(QHash<int, QSocketNotifierSetUNIX>::const_iterator it,
+                                                            short revents)
+{
+    const QSocketNotifierSetUNIX &sn_set = it.value();
+    const int fd = it.key();
+
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     fd, socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -354,12 +525,14 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
 
     Q_D(QEventDispatcherUNIX);
     QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+    const short oldEvents = sn_set.events();
 
     if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
     sn_set.notifiers[type] = notifier;
+    d->updateSocketNotifierInterest(sockfd, oldEvents, sn_set.events());
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -398,7 +571,9 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+    const short oldEvents = sn_set.events();
     sn_set.notifiers[type] = nullptr;
+    d->updateSocketNotifierInterest(sockfd, oldEvents, sn_set.events());
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -443,6 +618,16 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         // ensures the code in the do-while loop in qt_safe_poll runs at least once.
     }
 
+    int nevents = 0;
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->processEpollEvents(deadline);
+        if (include_timers)
+            nevents += d->activateTimers();
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -453,7 +638,6 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
     switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), deadline)) {
     case -1:
         qErrnoWarning("qt_safe_poll");
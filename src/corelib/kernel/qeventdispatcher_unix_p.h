@@ -23,6 +23,11 @@
 #include "QtCore/qhash.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if defined(Q_OS_LINUX) && __has_include(<sys/epoll.h>)
+#  include <sys/epoll.h>
+#  define QT_EVENTDISPATCHER_UNIX_EPOLL
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -100,8 +105,11 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifier(QHash<int, QSocketNotifierSetUNIX>::const_iterator it,
+                                   short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
+    void updateSocketNotifierInterest(int fd, short oldEvents, short newEvents);
 
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
@@ -111,6 +119,17 @@ public:
 
     QTimerInfoList timerList;
     QAtomicInt interrupt; // bool
+
+#ifdef QT_EVENTDISPATCHER_UNIX_EPOLL
+    // Opt-in backend (QT_EVENT_DISPATCHER_EPOLL=1) keeping a persistent
+    // interest set in the kernel instead of rebuilding pollfds every iteration
+    bool initEpoll();
+    int processEpollEvents(QDeadlineTimer deadline);
+
+    int epollFd = -1;
+    // fds epoll_ctl refused, with the revents poll() would report for them
+    QHash<int, short> epollFallbackFds;
+#endif
 };
 
 inline QSocketNotifierSetUNIX::QSocketNotifierSetUNIX() noexcept
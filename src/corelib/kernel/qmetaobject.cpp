@@ -16,6 +16,7 @@
 // interface for the non-thread support case
 #include <qthread.h>
 #include "private/qthread_p.h"
+#include "private/qcoreapplication_p.h"
 #if QT_CONFIG(thread)
 #include <qsemaphore.h>
 #endif
@@ -1649,17 +1650,17 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
 
         for (int i = 1; i < parameterCount; ++i) {
             types[i] = QMetaType(metaTypes[i]);
-            args[i] = types[i].create(argv[i]);
+            args[i] = event->createArg(types[i], argv[i]);
         }
 
-        QCoreApplication::postEvent(object, event.release());
+        QCoreApplicationPrivate::postMetaCallEvent(object, event.release());
     } else if (type == Qt::BlockingQueuedConnection) {
 #if QT_CONFIG(thread)
         if (receiverInSameThread)
             qWarning("QMetaObject::invokeMethod: Dead lock detected");
 
         QSemaphore semaphore;
-        QCoreApplication::postEvent(object, new QMetaCallEvent(std::move(slot), nullptr, -1, argv, &semaphore));
+        QCoreApplicationPrivate::postMetaCallEvent(object, new QMetaCallEvent(std::move(slot), nullptr, -1, argv, &semaphore));
         semaphore.acquire();
 #endif // QT_CONFIG(thread)
     } else {
@@ -2784,9 +2785,9 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         // now create copies of our parameters using those meta types
         for (int i = 1; i < paramCount; ++i)
-            args[i] = types[i].create(parameters[i]);
+            args[i] = event->createArg(types[i], parameters[i]);
 
-        QCoreApplication::postEvent(object, event.release());
+        QCoreApplicationPrivate::postMetaCallEvent(object, event.release());
     } else { // blocking queued connection
 #if QT_CONFIG(thread)
         if (receiverInSameThread()) {
@@ -2796,8 +2797,8 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
         }
 
         QSemaphore semaphore;
-        QCoreApplication::postEvent(object, new QMetaCallEvent(idx_offset, idx_relative, callFunction,
-                                                        nullptr, -1, param, &semaphore));
+        QCoreApplicationPrivate::postMetaCallEvent(object, new QMetaCallEvent(idx_offset, idx_relative, callFunction,
+                                                                              nullptr, -1, param, &semaphore));
         semaphore.acquire();
 #endif // QT_CONFIG(thread)
     }
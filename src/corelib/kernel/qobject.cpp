@@ -480,6 +480,34 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+/*
+    Allocates a block of \a nargs arguments laid out like the one of a
+    QMetaCallEvent, holding copies of the values in \a argv of the given
+    \a types. The return value is left null.
+*/
+static void **createArgsBlock(int nargs, const QMetaType *types, void **argv)
+{
+    constexpr size_t each = sizeof(void*) + sizeof(QMetaType);
+    void **args = static_cast<void **>(calloc(nargs, each));
+    Q_CHECK_PTR(args);
+    QMetaType *blockTypes = reinterpret_cast<QMetaType *>(args + nargs);
+    for (int n = 0; n < nargs; ++n)
+        blockTypes[n] = types[n];
+    for (int n = 1; n < nargs; ++n)
+        args[n] = types[n].create(argv[n]);
+    return args;
+}
+
+static void destroyArgsBlock(void **args, int nargs)
+{
+    const QMetaType *types = reinterpret_cast<QMetaType *>(args + nargs);
+    for (int n = 0; n < nargs; ++n) {
+        if (types[n].isValid() && args[n])
+            types[n].destroy(args[n]);
+    }
+    free(args);
+}
+
 /*!
     \internal
  */
@@ -599,11 +627,32 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotO,
     \internal
  */
 QMetaCallEvent::~QMetaCallEvent()
+{
+    if (coalescedConnection_) {
+        if (void **pending = releaseCoalescedConnection())
+            destroyArgsBlock(pending, d.nargs_);
+    }
+    destroyArgs();
+}
+
+/*!
+    \internal
+
+    Destroys the arguments of this event and frees the memory holding them.
+ */
+void QMetaCallEvent::destroyArgs()
 {
     if (d.nargs_) {
+        const quintptr storageBegin = quintptr(argStorage_);
+        const quintptr storageEnd = storageBegin + sizeof(argStorage_);
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (t[i].isValid() && d.args_[i])
+            if (!t[i].isValid() || !d.args_[i])
+                continue;
+            const quintptr arg = quintptr(d.args_[i]);
+            if (arg >= storageBegin && arg < storageEnd)
+                t[i].destruct(d.args_[i]);
+            else
                 t[i].destroy(d.args_[i]);
         }
         if (reinterpret_cast<void *>(d.args_) != reinterpret_cast<void *>(prealloc_))
@@ -616,6 +665,14 @@ QMetaCallEvent::~QMetaCallEvent()
  */
 void QMetaCallEvent::placeMetaCall(QObject *object)
 {
+    // from here on, emissions over the connection post a new event
+    if (coalescedConnection_) {
+        if (void **pending = releaseCoalescedConnection()) {
+            destroyArgs();
+            d.args_ = pending;
+        }
+    }
+
     if (d.slotObj_) {
         d.slotObj_->call(object, d.args_);
     } else if (d.callFunction_ && d.method_offset_ <= object->metaObject()->methodOffset()) {
@@ -626,6 +683,260 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+
+    Makes this event the pending call of the Qt::CoalescedConnection \a c to
+    \a receiver: until it is delivered, emissions over \a c update its
+    arguments instead of posting another event. The signalSlotLock() of
+    \a receiver must be locked.
+ */
+void QMetaCallEvent::setCoalescedConnection(QObjectPrivate::Connection *c, const QObject *receiver)
+{
+    Q_ASSERT(!c->pendingCall);
+    c->ref();
+    c->pendingCall = this;
+    coalescedConnection_ = c;
+    coalescedReceiver_ = receiver;
+}
+
+/*!
+    \internal
+
+    Makes copies of \a argv the arguments this pending call of a
+    Qt::CoalescedConnection is made with. The arguments of the event itself are
+    never modified, as event filters may be looking at them in the receiver's
+    thread; the copies are kept aside and replace them only once the call is
+    made. The signalSlotLock() of the receiver must be locked.
+ */
+void QMetaCallEvent::setPendingArgs(void **argv)
+{
+    Q_ASSERT(coalescedConnection_);
+    void **args = createArgsBlock(d.nargs_, types(), argv);
+    if (void **previous = std::exchange(pendingArgs_, args))
+        destroyArgsBlock(previous, d.nargs_);
+}
+
+/*!
+    \internal
+
+    Returns a copy of \a copy of type \a type for use as an argument of this
+    event, like QMetaType::create(). Small values are stored inside the event
+    itself; they must not be passed to QMetaType::destroy(), the destructor of
+    the event takes care of all arguments.
+ */
+void *QMetaCallEvent::createArg(QMetaType type, const void *copy)
+{
+    QThreadData *data = QThreadData::current(false);
+    QMetaCallEventPool *pool = data ? data->metaCallEventPool : nullptr;
+
+    const size_t size = size_t(type.sizeOf());
+    const size_t align = size_t(type.alignOf());
+    if (size && align && align <= alignof(std::max_align_t)) {
+        const size_t offset = (argStorageUsed_ + align - 1) & ~(align - 1);
+        if (offset + size <= sizeof(argStorage_)) {
+            void *arg = type.construct(argStorage_ + offset, copy);
+            if (arg) {
+                argStorageUsed_ = uint(offset + size);
+                if (pool)
+                    ++pool->counters.inlineArgs;
+            }
+            return arg;
+        }
+    }
+
+    if (pool)
+        ++pool->counters.heapArgs;
+    return type.create(copy);
+}
+
+/*!
+    \internal
+
+    Returns the allocation counters of the calling thread's QMetaCallEvent
+    pool.
+ */
+QMetaCallEvent::AllocationCounters QMetaCallEvent::allocationCounters()
+{
+    QThreadData *data = QThreadData::current(false);
+    if (data && data->metaCallEventPool)
+        return data->metaCallEventPool->counters;
+    return {};
+}
+
+void *QMetaCallEvent::operator new(size_t size)
+{
+    return QMetaCallEventPool::allocate(size);
+}
+
+void QMetaCallEvent::operator delete(void *ptr, size_t) noexcept
+{
+    QMetaCallEventPool::deallocate(ptr);
+}
+
+/*
+    QMetaCallEventPool recycles the memory of QMetaCallEvents, so that queued
+    connections don't need a round trip through the allocator for every
+    emission.
+
+    Every block has a header pointing to the pool of the thread that allocated
+    it. Queued calls are usually freed by the receiving thread, which gives the
+    block back to the owning pool through a lock-free stack; the owner takes
+    them all in one go once its own cache runs empty.
+
+    The pool lives as long as its QThreadData and the blocks it handed out.
+*/
+void *QMetaCallEventPool::allocate(size_t size)
+{
+    QMetaCallEventPool *pool = nullptr;
+    // subclasses use the global allocator
+    if (size == sizeof(QMetaCallEvent)) {
+        QThreadData *data = QThreadData::current();
+        pool = data->metaCallEventPool;
+        if (!pool)
+            pool = data->metaCallEventPool = new QMetaCallEventPool;
+    }
+
+    Block *block = nullptr;
+    if (pool) {
+        ++pool->counters.allocated;
+        block = pool->take();
+        if (block)
+            ++pool->counters.reused;
+    }
+    if (!block) {
+        block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+        block->owner = pool;
+        if (pool)
+            pool->ref.fetch_add(1, std::memory_order_relaxed);
+    }
+    return block + 1;
+}
+
+void QMetaCallEventPool::deallocate(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    Block *block = static_cast<Block *>(ptr) - 1;
+    QMetaCallEventPool *owner = block->owner;
+    if (!owner) {
+        ::operator delete(block);
+        return;
+    }
+
+    QThreadData *data = QThreadData::current(false);
+    if (data && data->metaCallEventPool == owner)
+        owner->recycle(block);
+    else
+        owner->giveBack(block);
+}
+
+// Called when the owning QThreadData is destroyed. Blocks still in use are
+// freed when they are given back.
+void QMetaCallEventPool::release(QMetaCallEventPool *pool)
+{
+    if (!pool)
+        return;
+
+    while (Block *block = pool->cached) {
+        pool->cached = block->next;
+        pool->freeBlock(block);
+    }
+    pool->cachedCount = 0;
+
+    // pairs with the load in giveBack(): either we see the block it pushed,
+    // or it sees that there's no owner to take it anymore
+    pool->orphaned.store(true, std::memory_order_seq_cst);
+    pool->freeReturnedBlocks();
+    pool->deref();
+}
+
+QMetaCallEventPool::Block *QMetaCallEventPool::take()
+{
+    if (!cached && returned.load(std::memory_order_relaxed)) {
+        Block *block = returned.exchange(nullptr, std::memory_order_seq_cst);
+        while (block) {
+            Block *next = block->next;
+            ++counters.returnedByOthers;
+            recycle(block);
+            block = next;
+        }
+    }
+
+    Block *block = cached;
+    if (block) {
+        cached = block->next;
+        --cachedCount;
+    }
+    return block;
+}
+
+void QMetaCallEventPool::recycle(Block *block)
+{
+    if (cachedCount >= MaxCachedBlocks) {
+        freeBlock(block);
+        return;
+    }
+    block->next = cached;
+    cached = block;
+    ++cachedCount;
+}
+
+void QMetaCallEventPool::giveBack(Block *block)
+{
+    // the owner may release the pool concurrently, keep it alive until we're done
+    ref.fetch_add(1, std::memory_order_relaxed);
+
+    Block *head = returned.load(std::memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!returned.compare_exchange_weak(head, block, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed));
+    if (orphaned.load(std::memory_order_seq_cst))
+        freeReturnedBlocks();
+
+    deref();
+}
+
+void QMetaCallEventPool::freeReturnedBlocks()
+{
+    Block *block = returned.exchange(nullptr, std::memory_order_seq_cst);
+    while (block) {
+        Block *next = block->next;
+        freeBlock(block);
+        block = next;
+    }
+}
+
+void QMetaCallEventPool::freeBlock(Block *block)
+{
+    ::operator delete(block);
+    deref();
+}
+
+void QMetaCallEventPool::deref()
+{
+    if (ref.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+}
+
+// Returns the arguments set by setPendingArgs(), if any; the caller owns them.
+void **QMetaCallEvent::releaseCoalescedConnection()
+{
+    QObjectPrivate::Connection *c;
+    void **pending;
+    {
+        QMutexLocker locker(signalSlotLock(coalescedReceiver_));
+        c = std::exchange(coalescedConnection_, nullptr);
+        Q_ASSERT(c->pendingCall == this);
+        c->pendingCall = nullptr;
+        pending = std::exchange(pendingArgs_, nullptr);
+    }
+    c->deref();
+    return pending;
+}
+
 QMetaCallEvent* QMetaCallEvent::create_impl(QtPrivate::SlotObjUniquePtr slotObj,
                                             const QObject *sender, int signal_index,
                                             size_t argc, const void* const argp[],
@@ -638,7 +949,7 @@ QMetaCallEvent* QMetaCallEvent::create_impl(QtPrivate::SlotObjUniquePtr slotObj,
     QMetaType *types = metaCallEvent->types();
     for (size_t i = 0; i < argc; ++i) {
         types[i] = metaTypes[i];
-        args[i] = types[i].create(argp[i]);
+        args[i] = metaCallEvent->createArg(types[i], argp[i]);
         Q_CHECK_PTR(!i || args[i]);
     }
 
@@ -1693,6 +2004,8 @@ bool QObject::moveToThread(QThread *targetThread QT6_IMPL_NEW_OVERLOAD_TAIL)
 
     QOrderedMutexLocker locker(&currentData->postEventList.mutex,
                                &targetData->postEventList.mutex);
+    currentData->drainPostEventInbox();
+    targetData->drainPostEventInbox();
 
     // keep currentData alive (since we've got it locked)
     currentData->ref();
@@ -1709,6 +2022,11 @@ bool QObject::moveToThread(QThread *targetThread QT6_IMPL_NEW_OVERLOAD_TAIL)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // events pushed onto the inbox while we were moving the posted events
+    // are forwarded to targetData by drainPostEventInbox()
+    currentData->postEventList.waitForInboxProducers();
+    currentData->drainPostEventInbox();
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3614,6 +3932,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3631,6 +3952,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3957,6 +4279,14 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
+    if (QMetaCallEvent *pending = c->pendingCall) {
+        // coalesced connection with a call still waiting in the event queue:
+        // just give it the latest arguments
+        if (nargs > 1)
+            pending->setPendingArgs(argv);
+        return;
+    }
+
     SlotObjectGuard slotObjectGuard { c->isSlotObject ? c->slotObj : nullptr };
     locker.unlock();
 
@@ -3975,7 +4305,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             types[n] = QMetaType(argumentTypes[n - 1]);
 
         for (int n = 1; n < nargs; ++n)
-            args[n] = types[n].create(argv[n]);
+            args[n] = ev->createArg(types[n], argv[n]);
     }
 
     if (c->isSingleShot && !QObjectPrivate::removeConnection(c)) {
@@ -3991,7 +4321,18 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    if (c->isCoalesced) {
+        if (c->pendingCall) {
+            // another thread posted a call while we were unlocked
+            locker.unlock();
+            delete ev;
+            queued_activate(sender, signal, c, argv);
+            return;
+        }
+        ev->setCoalescedConnection(c, receiver);
+    }
+
+    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
 }
 
 template <bool callbacks_enabled>
@@ -4098,7 +4439,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                         new QMetaCallEvent(c->slotObj, sender, signal_index, argv, &semaphore) :
                         new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction,
                                            sender, signal_index, argv, &semaphore);
-                    QCoreApplication::postEvent(receiver, ev);
+                    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
                 }
                 semaphore.acquire();
                 continue;
@@ -5286,6 +5627,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5304,6 +5648,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
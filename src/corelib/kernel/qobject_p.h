@@ -27,6 +27,7 @@
 #include <QtCore/qshareddata.h>
 #include "QtCore/private/qproperty_p.h"
 
+#include <atomic>
 #include <string>
 
 QT_BEGIN_NAMESPACE
@@ -358,11 +359,17 @@ public:
     inline int signalId() const { return signalId_; }
 
 private:
+    friend class QPostEventList;
+    friend class QThreadData;
+
     int signalId_;
     const QObject *sender_;
 #if QT_CONFIG(thread)
     QSemaphore *semaphore_;
 #endif
+    // links for QPostEventList's lock-free inbox
+    QObject *inboxReceiver_ = nullptr;
+    QAbstractMetaCallEvent *inboxNext_ = nullptr;
 };
 
 class Q_CORE_EXPORT QMetaCallEvent : public QAbstractMetaCallEvent
@@ -421,7 +428,28 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    void setCoalescedConnection(QObjectPrivate::Connection *c, const QObject *receiver);
+    void setPendingArgs(void **argv);
+
+    void *createArg(QMetaType type, const void *copy);
+
+    struct AllocationCounters
+    {
+        quint64 allocated = 0;          // events allocated by the thread
+        quint64 reused = 0;             // of those, taken from the thread's pool
+        quint64 returnedByOthers = 0;   // blocks freed by other threads and handed back
+        quint64 inlineArgs = 0;         // arguments stored inside the event
+        quint64 heapArgs = 0;           // arguments allocated separately
+    };
+    static AllocationCounters allocationCounters();
+
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size) noexcept;
+
 private:
+    void **releaseCoalescedConnection();
+    void destroyArgs();
+
     static QMetaCallEvent *create_impl(QtPrivate::QSlotObjectBase *slotObj, const QObject *sender,
                                        int signal_index, size_t argc, const void * const argp[],
                                        const QMetaType metaTypes[])
@@ -444,8 +472,52 @@ private:
         ushort method_offset_;
         ushort method_relative_;
     } d;
+    // set while this is the pending call of a Qt::CoalescedConnection
+    QObjectPrivate::Connection *coalescedConnection_ = nullptr;
+    const QObject *coalescedReceiver_ = nullptr;
+    // latest arguments of the coalesced connection, installed when the call is made
+    void **pendingArgs_ = nullptr;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+    // and for their values, if they are small
+    alignas(std::max_align_t) char argStorage_[6 * sizeof(void *)];
+    uint argStorageUsed_ = 0;
+};
+
+// Per-thread cache of QMetaCallEvent allocations, owned by QThreadData
+class QMetaCallEventPool
+{
+public:
+    static void *allocate(size_t size);
+    static void deallocate(void *ptr) noexcept;
+    static void release(QMetaCallEventPool *pool);
+
+    QMetaCallEvent::AllocationCounters counters;
+
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        QMetaCallEventPool *owner;
+        Block *next;
+    };
+    static constexpr int MaxCachedBlocks = 256;
+
+    Block *take();
+    void recycle(Block *block);
+    void giveBack(Block *block);
+    void freeReturnedBlocks();
+    void freeBlock(Block *block);
+    void deref();
+
+    // only accessed by the owning thread
+    Block *cached = nullptr;
+    int cachedCount = 0;
+    // blocks freed by other threads
+    std::atomic<Block *> returned = nullptr;
+    // one for the owning QThreadData, plus one per block and per thread
+    // currently giving a block back
+    std::atomic<qsizetype> ref = 1;
+    std::atomic<bool> orphaned = false;
 };
 
 class QBoolBlocker
@@ -82,6 +82,9 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
         QtPrivate::QSlotObjectBase *slotObj;
     };
     QAtomicPointer<const int> argumentTypes;
+    // the call of a Qt::CoalescedConnection waiting in the event queue,
+    // protected by the receiver's signalSlotLock()
+    QMetaCallEvent *pendingCall = nullptr;
     QAtomicInt ref_{
         2
     }; // ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
@@ -93,7 +96,8 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
-    Connection() : ownArgumentTypes(true) { }
+    ushort isCoalesced : 1;
+    Connection() : ownArgumentTypes(true), isCoalesced(false) { }
     ~Connection();
     int method() const
     {
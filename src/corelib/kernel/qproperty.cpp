@@ -7,14 +7,19 @@
 #include <qscopedvaluerollback.h>
 #include <QScopeGuard>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QThread>
 #include <QtCore/qmetaobject.h>
 
 #include "qobject_p.h"
+#include "private/qduplicatetracker_p.h"
+#include "private/qthread_p.h"
 
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcQPropertyBinding, "qt.qproperty.binding");
+Q_LOGGING_CATEGORY(lcQPropertyBindingProfile, "qt.qproperty.binding.profile");
 
 using namespace QtPrivate;
 
@@ -121,7 +126,8 @@ struct QPropertyDelayedNotifications
         Change notifications are sent later with notify (following the logic of separating
         binding updates and notifications used in non-deferred updates).
      */
-     void evaluateBindings(PendingBindingObserverList &bindingObservers, qsizetype index, QBindingStatus *status) {
+     void evaluateBindings(PendingBindingObserverList &bindingObservers, qsizetype index,
+                           QBindingStatus *status, QDuplicateTracker<QPropertyBindingPrivate *> &evaluated) {
         auto *delayed = delayedProperties + index;
         auto *bindingData = delayed->originalBindingData;
         if (!bindingData)
@@ -134,10 +140,25 @@ struct QPropertyDelayedNotifications
                 observer->prev = reinterpret_cast<QPropertyObserver **>(&bindingData->d_ptr);
         }
 
+        // Like QPropertyObserverPointer::evaluateBindings(), but a binding that
+        // depends on several properties of the group is evaluated only once:
+        // the values of all of them are final, and if one of its inputs is a
+        // binding that changes later on, that one re-evaluates it anyway.
         QPropertyBindingDataPointer bindingDataPointer{bindingData};
-        QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
-        if (observer)
-            observer.evaluateBindings(bindingObservers, status);
+        QPropertyObserver *observer = bindingDataPointer.firstObserver().ptr;
+        while (observer) {
+            QPropertyObserver *next = observer->next.data();
+            if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesBinding
+                    && !evaluated.hasSeen(observer->binding)) {
+                auto bindingToEvaluate = observer->binding;
+                QPropertyObserverNodeProtector protector(observer);
+                QBindingObserverPtr bindingObserver(observer);
+                if (bindingToEvaluate->evaluateRecursive_inline(bindingObservers, status))
+                    bindingObservers.push_back(std::move(bindingObserver));
+                next = protector.next();
+            }
+            observer = next;
+        }
     }
 
     /*!
@@ -166,6 +187,7 @@ struct QPropertyDelayedNotifications
 };
 
 Q_CONSTINIT static thread_local QBindingStatus bindingStatus;
+Q_CONSTINIT static thread_local bool automaticUpdateGroups = false;
 
 /*!
     \since 6.2
@@ -218,11 +240,12 @@ void Qt::endPropertyUpdateGroup()
     groupUpdateData = nullptr;
     // ensures that bindings are kept alive until endPropertyUpdateGroup concludes
     PendingBindingObserverList bindingObservers;
+    QDuplicateTracker<QPropertyBindingPrivate *> evaluatedBindings;
     // update all delayed properties
     auto start = data;
     while (data) {
         for (qsizetype i = 0; i < data->used; ++i)
-            data->evaluateBindings(bindingObservers, i, status);
+            data->evaluateBindings(bindingObservers, i, status, evaluatedBindings);
         data = data->next;
     }
     // notify all delayed notifications from binding evaluation
@@ -273,6 +296,173 @@ void Qt::endPropertyUpdateGroup()
     Calls Qt::endPropertyUpdateGroup().
 */
 
+/*!
+    \internal
+
+    Enables or disables automatic property update groups for the calling
+    thread, depending on \a enable.
+
+    When enabled, the first property change outside of an update group that
+    happens while an event is being delivered opens an implicit group. It is
+    ended when the delivery of that event returns, so that all property
+    changes made by one event handler cause only one round of binding
+    evaluations and change notifications. Outside of event delivery,
+    properties are updated immediately as usual.
+
+    Like with explicit groups, bindings depending on a changed property are
+    not up to date until the group ends.
+*/
+void QtPrivate::setAutomaticPropertyUpdateGroups(bool enable)
+{
+    automaticUpdateGroups = enable;
+}
+
+/*!
+    \internal
+
+    Returns whether automatic property update groups are enabled for the
+    calling thread.
+*/
+bool QtPrivate::automaticPropertyUpdateGroups()
+{
+    return automaticUpdateGroups;
+}
+
+/*
+    Opens the automatic update group for the event currently delivered in this
+    thread. QScopedScopeLevelCounter ends it once that event has been handled.
+*/
+static QPropertyDelayedNotifications *beginAutomaticUpdateGroup()
+{
+    QThreadData *data = QThreadData::current(false);
+    if (!data || data->scopeLevel == 0)
+        return nullptr; // not delivering an event
+    Q_ASSERT(!data->propertyUpdateGroupScopeLevel);
+    Qt::beginPropertyUpdateGroup();
+    data->propertyUpdateGroupScopeLevel = data->scopeLevel;
+    return bindingStatus.groupUpdateData;
+}
+
+Q_CONSTINIT QBasicAtomicInteger<bool> QPropertyBindingProfiler::enabled = Q_BASIC_ATOMIC_INITIALIZER(false);
+
+namespace {
+struct QPropertyBindingProfilerData
+{
+    QMutex mutex;
+    QHash<const QPropertyBindingPrivate *, QPropertyBindingProfiler::Statistics> statistics;
+};
+}
+Q_GLOBAL_STATIC(QPropertyBindingProfilerData, bindingProfilerData)
+
+/*!
+    Enables or disables collecting binding statistics in all threads,
+    depending on \a enable. Statistics collected so far are kept.
+*/
+void QPropertyBindingProfiler::setEnabled(bool enable)
+{
+    enabled.storeRelaxed(enable);
+}
+
+/*!
+    Returns the statistics collected for \a binding. Statistics of bindings
+    that have been destroyed are discarded.
+*/
+QPropertyBindingProfiler::Statistics QPropertyBindingProfiler::statistics(const QPropertyBindingPrivate *binding)
+{
+    QPropertyBindingProfilerData *data = bindingProfilerData();
+    QMutexLocker locker(&data->mutex);
+    return data->statistics.value(binding);
+}
+
+/*!
+    Discards all statistics collected so far.
+*/
+void QPropertyBindingProfiler::reset()
+{
+    QPropertyBindingProfilerData *data = bindingProfilerData();
+    QMutexLocker locker(&data->mutex);
+    data->statistics.clear();
+}
+
+/*!
+    Logs the statistics of the \a maxBindings bindings that were evaluated
+    most often to the \c{qt.qproperty.binding.profile} logging category.
+*/
+void QPropertyBindingProfiler::report(qsizetype maxBindings)
+{
+    if (!lcQPropertyBindingProfile().isInfoEnabled())
+        return;
+
+    QList<Statistics> all;
+    {
+        QPropertyBindingProfilerData *data = bindingProfilerData();
+        QMutexLocker locker(&data->mutex);
+        all = data->statistics.values();
+    }
+    auto byEvaluations = [](const Statistics &a, const Statistics &b) {
+        return a.evaluations > b.evaluations;
+    };
+    const qsizetype count = qMin(maxBindings, all.size());
+    std::partial_sort(all.begin(), all.begin() + count, all.end(), byEvaluations);
+
+    qCInfo(lcQPropertyBindingProfile, "%lld bindings evaluated, the %lld evaluated most often:",
+           qlonglong(all.size()), qlonglong(count));
+    for (qsizetype i = 0; i < count; ++i) {
+        const Statistics &s = all.at(i);
+        qCInfo(lcQPropertyBindingProfile,
+               "  %s:%u (%s): %llu evaluations, %llu changes, %llu observers notified, %lld us",
+               s.location.fileName ? s.location.fileName : "<unknown>", s.location.line,
+               s.location.functionName ? s.location.functionName : "",
+               s.evaluations, s.valueChanges, s.observersNotified,
+               qlonglong(std::chrono::duration_cast<std::chrono::microseconds>(s.evaluationTime).count()));
+    }
+}
+
+/*!
+    Records an evaluation of \a binding which took \a time, and which
+    \a changed the value of the property.
+*/
+void QPropertyBindingProfiler::recordEvaluation(const QPropertyBindingPrivate *binding,
+                                                bool changed, std::chrono::nanoseconds time)
+{
+    QPropertyBindingProfilerData *data = bindingProfilerData();
+    QMutexLocker locker(&data->mutex);
+    auto it = data->statistics.find(binding);
+    if (it == data->statistics.end()) {
+        it = data->statistics.insert(binding, {});
+        it->location = binding->sourceLocation();
+    }
+    ++it->evaluations;
+    if (changed)
+        ++it->valueChanges;
+    it->evaluationTime += time;
+}
+
+/*!
+    Records that \a binding notified \a observers observers of a change.
+*/
+void QPropertyBindingProfiler::recordNotification(const QPropertyBindingPrivate *binding,
+                                                  quint64 observers)
+{
+    QPropertyBindingProfilerData *data = bindingProfilerData();
+    QMutexLocker locker(&data->mutex);
+    auto it = data->statistics.find(binding);
+    if (it != data->statistics.end())
+        it->observersNotified += observers;
+}
+
+/*!
+    Discards the statistics of \a binding, which is being destroyed.
+*/
+void QPropertyBindingProfiler::forget(const QPropertyBindingPrivate *binding)
+{
+    if (!bindingProfilerData.exists())
+        return;
+    QPropertyBindingProfilerData *data = bindingProfilerData();
+    QMutexLocker locker(&data->mutex);
+    data->statistics.remove(binding);
+}
+
 
 // check everything stored in QPropertyBindingPrivate's union is trivially destructible
 // (though the compiler would also complain if that weren't the case)
@@ -281,6 +471,7 @@ static_assert(std::is_trivially_destructible_v<std::byte[sizeof(QPropertyBinding
 
 QPropertyBindingPrivate::~QPropertyBindingPrivate()
 {
+    QPropertyBindingProfiler::forget(this);
     if (firstObserver)
         firstObserver.unlink();
     if (vtable->size)
@@ -338,6 +529,12 @@ QPropertyBindingPrivate::NotificationState QPropertyBindingPrivate::notifyNonRec
     updating = true;
     if (firstObserver) {
         firstObserver.noSelfDependencies(this);
+        if (Q_UNLIKELY(QPropertyBindingProfiler::isEnabled())) {
+            quint64 observers = 0;
+            for (QPropertyObserver *o = firstObserver.ptr; o; o = o->next.data())
+                ++observers;
+            QPropertyBindingProfiler::recordNotification(this, observers);
+        }
         firstObserver.notify(propertyDataPtr);
     }
     if (hasStaticObserver)
@@ -663,6 +860,12 @@ QPropertyBindingData::NotificationResult QPropertyBindingData::notifyObserver_he
         delay->addProperty(this, propertyDataPtr);
         return Delayed;
     }
+    if (Q_UNLIKELY(automaticUpdateGroups) && status == &bindingStatus) {
+        if (QPropertyDelayedNotifications *delay = beginAutomaticUpdateGroup()) {
+            delay->addProperty(this, propertyDataPtr);
+            return Delayed;
+        }
+    }
 
     observer.evaluateBindings(bindingObservers, status);
     return Evaluated;
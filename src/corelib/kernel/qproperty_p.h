@@ -24,6 +24,7 @@
 #include <vector>
 #include <QtCore/QVarLengthArray>
 
+#include <chrono>
 #include <memory>
 
 QT_BEGIN_NAMESPACE
@@ -31,6 +32,9 @@ QT_BEGIN_NAMESPACE
 namespace QtPrivate {
     Q_CORE_EXPORT bool isAnyBindingEvaluating();
     struct QBindingStatusAccessToken {};
+
+    Q_CORE_EXPORT void setAutomaticPropertyUpdateGroups(bool enable);
+    Q_CORE_EXPORT bool automaticPropertyUpdateGroups();
 }
 
 
@@ -446,6 +450,41 @@ public:
     }
 };
 
+/*!
+    \internal
+
+    Collects statistics about binding evaluations, to find the bindings that
+    are evaluated far more often than expected. It is disabled by default,
+    and then only costs an atomic load per evaluation.
+*/
+class Q_CORE_EXPORT QPropertyBindingProfiler
+{
+public:
+    struct Statistics
+    {
+        QPropertyBindingSourceLocation location;
+        quint64 evaluations = 0;
+        quint64 valueChanges = 0;
+        quint64 observersNotified = 0;
+        std::chrono::nanoseconds evaluationTime = {};
+    };
+
+    static void setEnabled(bool enable);
+    static bool isEnabled() { return enabled.loadRelaxed(); }
+
+    static Statistics statistics(const QPropertyBindingPrivate *binding);
+    static void reset();
+    static void report(qsizetype maxBindings = 20);
+
+    static void recordEvaluation(const QPropertyBindingPrivate *binding, bool changed,
+                                 std::chrono::nanoseconds time);
+    static void recordNotification(const QPropertyBindingPrivate *binding, quint64 observers);
+    static void forget(const QPropertyBindingPrivate *binding);
+
+private:
+    static QBasicAtomicInteger<bool> enabled;
+};
+
 inline void QPropertyBindingDataPointer::setFirstObserver(QPropertyObserver *observer)
 {
     if (auto *b = binding()) {
@@ -856,6 +895,9 @@ inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObse
 
     auto bindingFunctor =  reinterpret_cast<std::byte *>(this) +
             QPropertyBindingPrivate::getSizeEnsuringAlignment();
+    const bool profiling = QPropertyBindingProfiler::isEnabled();
+    const auto evaluationStart = profiling ? std::chrono::steady_clock::now()
+                                           : std::chrono::steady_clock::time_point{};
     bool changed = false;
     if (hasBindingWrapper) {
         changed = staticBindingWrapper(metaType, propertyDataPtr,
@@ -863,6 +905,10 @@ inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObse
     } else {
         changed = vtable->call(metaType, propertyDataPtr, bindingFunctor);
     }
+    if (Q_UNLIKELY(profiling)) {
+        QPropertyBindingProfiler::recordEvaluation(this, changed,
+                                                   std::chrono::steady_clock::now() - evaluationStart);
+    }
     // If there was a change, we must set pendingNotify.
     // If there was not, we must not clear it, as that only should happen in notifyRecursive
     pendingNotify = pendingNotify || changed;
@@ -4,6 +4,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -25,7 +26,187 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
  * timerBitVec array is used for keeping track of timer identifiers.
  */
 
-QTimerInfoList::QTimerInfoList() = default;
+QTimerWheel::QTimerWheel(TimePoint now)
+    : currentTick(tickOf(now))
+{
+}
+
+qint64 QTimerWheel::tickOf(TimePoint tp)
+{
+    return floor<milliseconds>(tp.time_since_epoch()).count();
+}
+
+QTimerInfo *&QTimerWheel::slotHead(uint wheelSlot)
+{
+    return wheelSlot == OverflowSlot ? overflow : buckets[wheelSlot];
+}
+
+void QTimerWheel::link(QTimerInfo *t, uint wheelSlot)
+{
+    QTimerInfo *&head = slotHead(wheelSlot);
+    t->wheelNext = head;
+    if (head)
+        head->wheelPrev = &t->wheelNext;
+    t->wheelPrev = &head;
+    t->wheelSlot = wheelSlot;
+    head = t;
+    if (wheelSlot != OverflowSlot)
+        occupied[wheelSlot / SlotCount] |= quint64(1) << (wheelSlot % SlotCount);
+}
+
+/*
+    Unlinks all timers of the slot and returns the first one.
+*/
+QTimerInfo *QTimerWheel::takeSlot(uint wheelSlot)
+{
+    QTimerInfo *t = std::exchange(slotHead(wheelSlot), nullptr);
+    if (wheelSlot != OverflowSlot)
+        occupied[wheelSlot / SlotCount] &= ~(quint64(1) << (wheelSlot % SlotCount));
+    return t;
+}
+
+/*
+    Links the timer into the lowest level whose window around currentTick
+    contains its timeout.
+*/
+void QTimerWheel::place(QTimerInfo *t)
+{
+    // timers that are already due go into the current slot
+    const qint64 tick = std::max(tickOf(t->timeout), currentTick);
+    const quint64 differentBits = quint64(tick) ^ quint64(currentTick);
+    const int level = differentBits ? (63 - qCountLeadingZeroBits(differentBits)) / LevelBits : 0;
+    if (level < LevelCount) {
+        const int slot = int(tick >> (level * LevelBits)) & (SlotCount - 1);
+        link(t, level * SlotCount + slot);
+    } else {
+        link(t, OverflowSlot);
+    }
+}
+
+void QTimerWheel::insert(QTimerInfo *t)
+{
+    Q_ASSERT(!t->wheelPrev);
+    place(t);
+    ++count;
+
+    if (cachedFirstValid && (!cachedFirst || lessThan(t, cachedFirst)))
+        cachedFirst = t;
+}
+
+void QTimerWheel::remove(QTimerInfo *t)
+{
+    Q_ASSERT(t->wheelPrev);
+    *t->wheelPrev = t->wheelNext;
+    if (t->wheelNext)
+        t->wheelNext->wheelPrev = t->wheelPrev;
+    if (t->wheelSlot != OverflowSlot && !buckets[t->wheelSlot])
+        occupied[t->wheelSlot / SlotCount] &= ~(quint64(1) << (t->wheelSlot % SlotCount));
+    t->wheelNext = nullptr;
+    t->wheelPrev = nullptr;
+    --count;
+
+    if (t == cachedFirst)
+        cachedFirstValid = false;
+}
+
+/*
+    Returns the earliest slot holding timers, along with the tick at which it
+    starts. The timers of the overflow slot all time out after the current
+    window of the top level, so it starts with the next one.
+*/
+auto QTimerWheel::nextSlot() const -> std::optional<NextSlot>
+{
+    for (int level = 0; level < LevelCount; ++level) {
+        if (!occupied[level])
+            continue;
+        const int shift = level * LevelBits;
+        const int slot = qCountTrailingZeroBits(occupied[level]);
+        // slots before the one of currentTick have been emptied when it got there
+        Q_ASSERT(slot >= (int(currentTick >> shift) & (SlotCount - 1)));
+        const qint64 windowStart = (currentTick >> (shift + LevelBits)) << (shift + LevelBits);
+        const qint64 start = std::max(windowStart + (qint64(slot) << shift), currentTick);
+        return NextSlot{ start, level, uint(level * SlotCount + slot) };
+    }
+    if (overflow) {
+        constexpr int shift = LevelCount * LevelBits;
+        return NextSlot{ ((currentTick >> shift) + 1) << shift, LevelCount, OverflowSlot };
+    }
+    return std::nullopt;
+}
+
+void QTimerWheel::advance(TimePoint now, QList<QTimerInfo *> &expired)
+{
+    const qint64 nowTick = tickOf(now);
+    while (const auto next = nextSlot()) {
+        if (next->start > nowTick)
+            break;
+
+        // no timer times out before the slot, so the wheel can jump there
+        currentTick = next->start;
+
+        if (next->level == 0) {
+            // all timers of the slot are due, unless it's the one of now
+            QTimerInfo *t = takeSlot(next->wheelSlot);
+            while (t) {
+                QTimerInfo *nextInSlot = std::exchange(t->wheelNext, nullptr);
+                t->wheelPrev = nullptr;
+                if (next->start < nowTick || t->timeout <= now) {
+                    --count;
+                    if (t == cachedFirst)
+                        cachedFirstValid = false;
+                    expired.append(t);
+                } else {
+                    link(t, next->wheelSlot);
+                }
+                t = nextInSlot;
+            }
+            if (next->start == nowTick)
+                break;
+        } else {
+            // redistribute the timers to the lower levels
+            QTimerInfo *t = takeSlot(next->wheelSlot);
+            while (t) {
+                QTimerInfo *nextInSlot = std::exchange(t->wheelNext, nullptr);
+                t->wheelPrev = nullptr;
+                place(t);
+                t = nextInSlot;
+            }
+        }
+    }
+    currentTick = std::max(currentTick, nowTick);
+}
+
+/*
+    Returns the timer with the earliest timeout, or \nullptr if the wheel is
+    empty. Since the levels are ordered, it's in the first non-empty slot.
+*/
+QTimerInfo *QTimerWheel::first()
+{
+    if (!cachedFirstValid) {
+        cachedFirst = nullptr;
+        if (const auto next = nextSlot()) {
+            for (QTimerInfo *t = slotHead(next->wheelSlot); t; t = t->wheelNext) {
+                if (!cachedFirst || lessThan(t, cachedFirst))
+                    cachedFirst = t;
+            }
+        }
+        cachedFirstValid = true;
+    }
+    return cachedFirst;
+}
+
+QTimerInfoList::QTimerInfoList()
+    : wheel(steady_clock::now())
+{
+}
+
+void QTimerInfoList::clearTimers()
+{
+    qDeleteAll(timersById);
+    timersById.clear();
+    dueTimers.clear();
+    wheel = QTimerWheel(updateCurrentTime());
+}
 
 steady_clock::time_point QTimerInfoList::updateCurrentTime() const
 {
@@ -33,17 +214,25 @@ steady_clock::time_point QTimerInfoList::updateCurrentTime() const
     return currentTime;
 }
 
+/*
+    Returns the timer with the earliest timeout. The due timers all time out
+    before the ones in the wheel.
+*/
+QTimerInfo *QTimerInfoList::firstTimer()
+{
+    return dueTimers.isEmpty() ? wheel.first() : dueTimers.constFirst();
+}
+
 /*! \internal
     Updates the currentTime member to the current time, and returns \c true if
     the first timer's timeout is in the future (after currentTime).
-
-    The list is sorted by timeout, thus it's enough to check the first timer only.
 */
 bool QTimerInfoList::hasPendingTimers()
 {
-    if (timers.isEmpty())
+    QTimerInfo *first = firstTimer();
+    if (!first)
         return false;
-    return updateCurrentTime() < timers.at(0)->timeout;
+    return updateCurrentTime() < first->timeout;
 }
 
 static bool byTimeout(const QTimerInfo *a, const QTimerInfo *b)
@@ -54,8 +243,13 @@ static bool byTimeout(const QTimerInfo *a, const QTimerInfo *b)
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    timers.insert(std::upper_bound(timers.cbegin(), timers.cend(), ti, byTimeout),
-                  ti);
+    ti->sequence = nextSequence++;
+    if (ti->timeout <= dueLimit) {
+        dueTimers.insert(std::upper_bound(dueTimers.cbegin(), dueTimers.cend(), ti, byTimeout),
+                         ti);
+    } else {
+        wheel.insert(ti);
+    }
 }
 
 static constexpr milliseconds roundToMillisecond(nanoseconds val)
@@ -241,11 +435,25 @@ std::optional<QTimerInfoList::Duration> QTimerInfoList::timerWait()
 
     auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
     // Find first waiting timer not already active
-    auto it = std::find_if(timers.cbegin(), timers.cend(), isWaiting);
-    if (it == timers.cend())
+    QTimerInfo *t = nullptr;
+    auto it = std::find_if(dueTimers.cbegin(), dueTimers.cend(), isWaiting);
+    if (it != dueTimers.cend()) {
+        t = *it;
+    } else {
+        t = wheel.first();
+        if (t && !isWaiting(t)) {
+            // only happens in a nested event loop, don't bother with the wheel
+            t = nullptr;
+            for (QTimerInfo *candidate : std::as_const(timersById)) {
+                if (isWaiting(candidate) && (!t || QTimerWheel::lessThan(candidate, t)))
+                    t = candidate;
+            }
+        }
+    }
+    if (!t)
         return std::nullopt;
 
-    Duration timeToWait = (*it)->timeout - now;
+    Duration timeToWait = t->timeout - now;
     if (timeToWait > 0ns)
         return roundToMillisecond(timeToWait);
     return 0ms;
@@ -260,15 +468,14 @@ QTimerInfoList::Duration QTimerInfoList::remainingDuration(Qt::TimerId timerId)
 {
     const steady_clock::time_point now = updateCurrentTime();
 
-    auto it = findTimerById(timerId);
-    if (it == timers.cend()) {
+    const QTimerInfo *t = findTimerById(timerId);
+    if (!t) {
 #ifndef QT_NO_DEBUG
         qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", int(timerId));
 #endif
         return Duration::min();
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return t->timeout - now;
     return 0ms;
@@ -314,56 +521,67 @@ void QTimerInfoList::registerTimer(Qt::TimerId timerId, QTimerInfoList::Duration
             t->timeout += 1s;
     }
 
+    timersById.insert(timerId, t);
     timerInsert(t);
 }
 
-bool QTimerInfoList::unregisterTimer(Qt::TimerId timerId)
+/*
+    Removes the timer from the wheel or the due timers and deletes it. The
+    caller takes care of timersById.
+*/
+void QTimerInfoList::removeTimer(QTimerInfo *t)
 {
-    auto it = findTimerById(timerId);
-    if (it == timers.cend())
-        return false; // id not found
-
     // set timer inactive
-    QTimerInfo *t = *it;
     if (t == firstTimerInfo)
         firstTimerInfo = nullptr;
     if (t->activateRef)
         *(t->activateRef) = nullptr;
+    if (t->wheelPrev)
+        wheel.remove(t);
+    else
+        dueTimers.removeOne(t);
     delete t;
-    timers.erase(it);
-    return true;
 }
 
-bool QTimerInfoList::unregisterTimers(QObject *object)
+bool QTimerInfoList::unregisterTimer(Qt::TimerId timerId)
 {
-    if (timers.isEmpty())
-        return false;
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
 
-    auto associatedWith = [this](QObject *o) {
-        return [this, o](auto &t) {
-            if (t->obj == o) {
-                if (t == firstTimerInfo)
-                    firstTimerInfo = nullptr;
-                if (t->activateRef)
-                    *(t->activateRef) = nullptr;
-                delete t;
-                return true;
-            }
-            return false;
-        };
-    };
+    removeTimer(t);
+    return true;
+}
 
-    qsizetype count = timers.removeIf(associatedWith(object));
-    return count > 0;
+bool QTimerInfoList::unregisterTimers(QObject *object)
+{
+    bool removed = false;
+    for (auto it = timersById.begin(); it != timersById.end(); ) {
+        if (it.value()->obj == object) {
+            removeTimer(it.value());
+            it = timersById.erase(it);
+            removed = true;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
 }
 
 auto QTimerInfoList::registeredTimers(QObject *object) const -> QList<TimerInfo>
 {
-    QList<TimerInfo> list;
-    for (const auto &t : timers) {
+    QVarLengthArray<const QTimerInfo *, 16> timers;
+    for (const QTimerInfo *t : timersById) {
         if (t->obj == object)
-            list.emplaceBack(TimerInfo{t->interval, t->id, t->timerType});
+            timers.append(t);
     }
+    // same order as they'll time out
+    std::sort(timers.begin(), timers.end(), QTimerWheel::lessThan);
+
+    QList<TimerInfo> list;
+    list.reserve(timers.size());
+    for (const QTimerInfo *t : timers)
+        list.emplaceBack(TimerInfo{t->interval, t->id, t->timerType});
     return list;
 }
 
@@ -372,26 +590,28 @@ auto QTimerInfoList::registeredTimers(QObject *object) const -> QList<TimerInfo>
 */
 int QTimerInfoList::activateTimers()
 {
-    if (qt_disable_lowpriority_timers || timers.isEmpty())
+    if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
     firstTimerInfo = nullptr;
 
     const steady_clock::time_point now = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << now;
-    // Find out how many timer have expired
-    auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
-    // Find first one still active (list is sorted by timeout)
-    auto it = std::find_if(timers.cbegin(), timers.cend(), stillActive);
-    auto maxCount = it - timers.cbegin();
+    // Take the timers that have expired out of the wheel, they time out after
+    // the ones that were already due
+    const qsizetype alreadyDue = dueTimers.size();
+    wheel.advance(now, dueTimers);
+    std::sort(dueTimers.begin() + alreadyDue, dueTimers.end(), QTimerWheel::lessThan);
+    dueLimit = std::max<QTimerInfo::TimePoint>(dueLimit, now);
+    auto maxCount = dueTimers.size();
 
     int n_act = 0;
     //fire the timers.
     while (maxCount--) {
-        if (timers.isEmpty())
+        if (dueTimers.isEmpty())
             break;
 
-        QTimerInfo *currentTimerInfo = timers.constFirst();
+        QTimerInfo *currentTimerInfo = dueTimers.constFirst();
         if (now < currentTimerInfo->timeout)
             break; // no timer has expired
 
@@ -406,14 +626,9 @@ int QTimerInfoList::activateTimers()
         }
 
         // determine next timeout time
+        dueTimers.removeFirst();
         calculateNextTimeout(currentTimerInfo, now);
-        if (timers.size() > 1) {
-            // Find where "currentTimerInfo" should be in the list so as
-            // to keep the list ordered by timeout
-            auto afterCurrentIt = timers.begin() + 1;
-            auto iter = std::upper_bound(afterCurrentIt, timers.end(), currentTimerInfo, byTimeout);
-            currentTimerInfo = *std::rotate(timers.begin(), afterCurrentIt, iter);
-        }
+        timerInsert(currentTimerInfo);
 
         if (currentTimerInfo->interval > 0ms)
             n_act++;
@@ -18,6 +18,7 @@
 #include <QtCore/private/qglobal_p.h>
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timespec
 #include <chrono>
@@ -40,6 +41,73 @@ struct QTimerInfo
     Qt::TimerType timerType; // - timer type
     QObject *obj = nullptr; // - object to receive event
     QTimerInfo **activateRef = nullptr; // - ref from activateTimers
+    quint64 sequence = 0;               // - insertion order, among equal timeouts
+    QTimerInfo *wheelNext = nullptr;    // - next timer in the same timer wheel slot
+    QTimerInfo **wheelPrev = nullptr;   // - ref to this timer in the wheel, null if not in it
+    uint wheelSlot = 0;                 // - timer wheel slot (level * SlotCount + slot)
+};
+
+// Hierarchical timing wheel with a resolution of one millisecond, holding the
+// timers that are not due yet. Inserting and removing a timer is O(1).
+//
+// Each level has 64 slots, covering 64 times the range of the level below.
+// A timer is stored in the lowest level whose window around currentTick
+// contains its timeout, so all timers of a level time out after those of the
+// levels below it. When currentTick reaches a slot of a higher level, its
+// timers are redistributed to the lower levels.
+class QTimerWheel
+{
+public:
+    using TimePoint = QTimerInfo::TimePoint;
+
+    explicit QTimerWheel(TimePoint now);
+
+    bool isEmpty() const { return count == 0; }
+
+    void insert(QTimerInfo *t);
+    void remove(QTimerInfo *t);
+
+    // Moves the timers whose timeout is not after now to expired.
+    void advance(TimePoint now, QList<QTimerInfo *> &expired);
+
+    QTimerInfo *first();
+
+    static bool lessThan(const QTimerInfo *a, const QTimerInfo *b)
+    {
+        if (a->timeout != b->timeout)
+            return a->timeout < b->timeout;
+        return a->sequence < b->sequence;
+    }
+
+private:
+    static constexpr int LevelBits = 6;
+    static constexpr int SlotCount = 1 << LevelBits;
+    static constexpr int LevelCount = 6;
+    // slot used for the timers beyond the range of the top level
+    static constexpr uint OverflowSlot = LevelCount * SlotCount;
+
+    struct NextSlot
+    {
+        qint64 start;
+        int level;
+        uint wheelSlot;
+    };
+    std::optional<NextSlot> nextSlot() const;
+    void place(QTimerInfo *t);
+    void link(QTimerInfo *t, uint wheelSlot);
+    QTimerInfo *takeSlot(uint wheelSlot);
+    QTimerInfo *&slotHead(uint wheelSlot);
+
+    static qint64 tickOf(TimePoint tp);
+
+    QTimerInfo *buckets[LevelCount * SlotCount] = {};
+    QTimerInfo *overflow = nullptr;
+    quint64 occupied[LevelCount] = {};
+    qint64 currentTick;
+    qsizetype count = 0;
+    // the result of first(), if still valid
+    QTimerInfo *cachedFirst = nullptr;
+    bool cachedFirstValid = false;
 };
 
 class Q_CORE_EXPORT QTimerInfoList
@@ -65,28 +133,31 @@ public:
     int activateTimers();
     bool hasPendingTimers();
 
-    void clearTimers()
-    {
-        qDeleteAll(timers);
-        timers.clear();
-    }
+    void clearTimers();
 
-    bool isEmpty() const { return timers.empty(); }
+    bool isEmpty() const { return timersById.isEmpty(); }
 
-    qsizetype size() const { return timers.size(); }
+    qsizetype size() const { return timersById.size(); }
 
-    auto findTimerById(Qt::TimerId timerId) const
+    QTimerInfo *findTimerById(Qt::TimerId timerId) const
     {
-        auto matchesId = [timerId](const auto &t) { return t->id == timerId; };
-        return std::find_if(timers.cbegin(), timers.cend(), matchesId);
+        return timersById.value(timerId);
     }
 
 private:
     std::chrono::steady_clock::time_point updateCurrentTime() const;
+    QTimerInfo *firstTimer();
+    void removeTimer(QTimerInfo *t);
 
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo = nullptr;
-    QList<QTimerInfo *> timers;
+    // timers that timed out before or at dueLimit, sorted by timeout
+    QList<QTimerInfo *> dueTimers;
+    QTimerInfo::TimePoint dueLimit = {};
+    // all other timers
+    QTimerWheel wheel;
+    QHash<Qt::TimerId, QTimerInfo *> timersById;
+    quint64 nextSequence = 0;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,973 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcborvalueview.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qfloat16.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <private/qstringconverter_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// same limit as QCborValue::fromCbor()
+static constexpr int maximumRecursionDepth = 1024;
+
+// containers with at most this many elements are searched without an index
+static constexpr qsizetype linearSearchLimit = 8;
+
+enum MajorType : quint8 {
+    UnsignedIntegerType = 0,
+    NegativeIntegerType = 1,
+    ByteStringType = 2,
+    TextStringType = 3,
+    ArrayType = 4,
+    MapType = 5,
+    TagType = 6,
+    SimpleTypesType = 7
+};
+
+enum AdditionalInformation : quint8 {
+    HalfPrecisionFloat = 25,
+    SinglePrecisionFloat = 26,
+    DoublePrecisionFloat = 27,
+    IndefiniteLength = 31
+};
+
+static constexpr uchar BreakByte = 0xff;
+
+namespace {
+struct Header
+{
+    quint64 value = 0;      // the integer, length, count, tag or simple type
+    qsizetype size = 0;     // bytes taken by the initial byte and the argument
+    quint8 major = 0;
+    quint8 info = 0;        // the additional information of the initial byte
+
+    bool isIndefinite() const { return info == IndefiniteLength; }
+    bool isFloat() const
+    { return major == SimpleTypesType && info >= HalfPrecisionFloat && info <= DoublePrecisionFloat; }
+};
+} // unnamed namespace
+
+// Decodes the initial byte and argument of the item at \a p. Returns false
+// if they are truncated or use a reserved encoding.
+static bool readHeader(const uchar *p, const uchar *end, Header *h) noexcept
+{
+    if (!p || p >= end)
+        return false;
+
+    h->major = *p >> 5;
+    h->info = *p & 0x1f;
+    h->size = 1;
+    if (h->info < 24) {
+        h->value = h->info;
+        return true;
+    }
+    if (h->info == IndefiniteLength) {
+        // strings and containers, or the break that ends them
+        h->value = 0;
+        return (h->major >= ByteStringType && h->major <= MapType) || h->major == SimpleTypesType;
+    }
+    if (h->info > DoublePrecisionFloat)
+        return false;
+
+    const qsizetype n = qsizetype(1) << (h->info - 24);
+    if (end - p - 1 < n)
+        return false;
+    switch (n) {
+    case 1: h->value = p[1]; break;
+    case 2: h->value = qFromBigEndian<quint16>(p + 1); break;
+    case 4: h->value = qFromBigEndian<quint32>(p + 1); break;
+    case 8: h->value = qFromBigEndian<quint64>(p + 1); break;
+    }
+    h->size += n;
+    return true;
+}
+
+// Returns the end of the item at \a p, or \nullptr if the item is malformed,
+// truncated or too deeply nested.
+static const uchar *skipItem(const uchar *p, const uchar *end, int depth = 0) noexcept
+{
+    Header h;
+    if (!readHeader(p, end, &h))
+        return nullptr;
+    p += h.size;
+
+    switch (h.major) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+        return p;
+
+    case SimpleTypesType:
+        return h.isIndefinite() ? nullptr : p;     // a break outside of a container
+
+    case ByteStringType:
+    case TextStringType:
+        if (!h.isIndefinite())
+            return quint64(end - p) < h.value ? nullptr : p + h.value;
+
+        // chunks of definite length and of the same type, then a break
+        for (;;) {
+            if (p == end)
+                return nullptr;
+            if (*p == BreakByte)
+                return p + 1;
+            Header chunk;
+            if (!readHeader(p, end, &chunk) || chunk.major != h.major || chunk.isIndefinite())
+                return nullptr;
+            p += chunk.size;
+            if (quint64(end - p) < chunk.value)
+                return nullptr;
+            p += chunk.value;
+        }
+
+    case ArrayType:
+    case MapType: {
+        if (depth >= maximumRecursionDepth)
+            return nullptr;
+        if (h.isIndefinite()) {
+            for (quint64 i = 0; ; ++i) {
+                if (p == end)
+                    return nullptr;
+                if (*p == BreakByte)
+                    return (h.major == MapType && (i & 1)) ? nullptr : p + 1;
+                p = skipItem(p, end, depth + 1);
+                if (!p)
+                    return nullptr;
+            }
+        }
+
+        // each item takes at least one byte, which also rules out overflows
+        quint64 count = h.value;
+        if (h.major == MapType) {
+            if (count > quint64(end - p) / 2)
+                return nullptr;
+            count *= 2;
+        }
+        if (count > quint64(end - p))
+            return nullptr;
+        while (count--) {
+            p = skipItem(p, end, depth + 1);
+            if (!p)
+                return nullptr;
+        }
+        return p;
+    }
+
+    case TagType:
+        if (depth >= maximumRecursionDepth)
+            return nullptr;
+        return skipItem(p, end, depth + 1);
+    }
+    Q_UNREACHABLE_RETURN(nullptr);
+}
+
+// Calls \a f with each chunk of the string that \a h is the header of.
+// Returns false if the string is malformed or truncated.
+template <typename F>
+static bool forEachChunk(const uchar *p, const uchar *end, const Header &h, F f)
+{
+    p += h.size;
+    if (!h.isIndefinite()) {
+        if (quint64(end - p) < h.value)
+            return false;
+        f(QByteArrayView(p, qsizetype(h.value)));
+        return true;
+    }
+    for (;;) {
+        if (p == end)
+            return false;
+        if (*p == BreakByte)
+            return true;
+        Header chunk;
+        if (!readHeader(p, end, &chunk) || chunk.major != h.major || chunk.isIndefinite())
+            return false;
+        p += chunk.size;
+        if (quint64(end - p) < chunk.value)
+            return false;
+        f(QByteArrayView(p, qsizetype(chunk.value)));
+        p += chunk.value;
+    }
+}
+
+using EncodedKey = QVarLengthArray<char, 64>;
+
+// Appends an initial byte and argument with the shortest encoding.
+static void appendHeader(EncodedKey &out, quint8 major, quint64 value)
+{
+    const char initial = char(major << 5);
+    if (value < 24) {
+        out.append(char(initial | value));
+    } else if (value <= 0xff) {
+        out.append(char(initial | 24));
+        out.append(char(value));
+    } else if (value <= 0xffff) {
+        out.append(char(initial | 25));
+        const quint16 v = qToBigEndian(quint16(value));
+        out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    } else if (value <= 0xffffffffU) {
+        out.append(char(initial | 26));
+        const quint32 v = qToBigEndian(quint32(value));
+        out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    } else {
+        out.append(char(initial | 27));
+        const quint64 v = qToBigEndian(value);
+        out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    }
+}
+
+static void encodeKey(EncodedKey &out, qint64 key)
+{
+    if (key < 0)
+        appendHeader(out, NegativeIntegerType, quint64(-1 - key));
+    else
+        appendHeader(out, UnsignedIntegerType, quint64(key));
+}
+
+static void encodeKey(EncodedKey &out, QAnyStringView key)
+{
+    key.visit([&out](auto key) {
+        using View = decltype(key);
+        if constexpr (std::is_same_v<View, QUtf8StringView>) {
+            appendHeader(out, TextStringType, quint64(key.size()));
+            out.append(reinterpret_cast<const char *>(key.data()), key.size());
+        } else {
+            // convert after the largest possible header, then move it in place
+            constexpr qsizetype maxHeader = 9;
+            out.resize(maxHeader + 3 * key.size());
+            char *dataEnd;
+            if constexpr (std::is_same_v<View, QLatin1StringView>) {
+                dataEnd = QUtf8::convertFromLatin1(out.data() + maxHeader, key);
+            } else {
+                QStringConverter::State state;
+                dataEnd = QUtf8::convertFromUnicode(out.data() + maxHeader, key, &state);
+            }
+            const qsizetype length = dataEnd - out.data() - maxHeader;
+            EncodedKey header;
+            appendHeader(header, TextStringType, quint64(length));
+            memmove(out.data() + header.size(), out.data() + maxHeader, length);
+            memcpy(out.data(), header.data(), header.size());
+            out.resize(header.size() + length);
+        }
+    });
+}
+
+// Returns the key from \a p to \a keyEnd in the encoding that the lookup
+// functions use: integers and text strings with the shortest header and of
+// definite length. If the key isn't encoded like that already, the
+// canonical form is created in \a storage. Other keys are returned as they
+// are; they can't match any lookup.
+static QByteArrayView canonicalKey(const uchar *p, const uchar *keyEnd, EncodedKey &storage)
+{
+    const QByteArrayView raw(p, keyEnd - p);
+    Header h;
+    if (!readHeader(p, keyEnd, &h))
+        return raw;
+
+    switch (h.major) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+    case TextStringType:
+        break;
+    default:
+        return raw;
+    }
+
+    if (!h.isIndefinite()) {
+        storage.clear();
+        appendHeader(storage, h.major, h.value);
+        if (storage.size() == h.size)
+            return raw;
+        storage.append(reinterpret_cast<const char *>(p) + h.size, raw.size() - h.size);
+        return QByteArrayView(storage.data(), storage.size());
+    }
+
+    QVarLengthArray<char, 64> text;
+    forEachChunk(p, keyEnd, h, [&text](QByteArrayView chunk) {
+        text.append(chunk.data(), chunk.size());
+    });
+    storage.clear();
+    appendHeader(storage, TextStringType, quint64(text.size()));
+    storage.append(text.data(), text.size());
+    return QByteArrayView(storage.data(), storage.size());
+}
+
+// The index of a container view is built completely before it is published
+// and never modified afterwards. Copies of the view share it, and concurrent
+// const calls may read it, without locking.
+class QCborContainerViewIndex : public QSharedData
+{
+public:
+    QList<const uchar *> elements;              // arrays: where each element starts
+    QHash<QByteArray, const uchar *> values;    // maps: the value of each canonical key
+    qsizetype size = 0;                         // the number of elements
+};
+
+using QCborContainerViewIndexPointer = QAtomicPointer<const QCborContainerViewIndex>;
+
+static const QCborContainerViewIndex *copyIndex(const QCborContainerViewIndexPointer &index) noexcept
+{
+    // the index is only replaced by non-const functions, so it can't be
+    // released between these two lines
+    const QCborContainerViewIndex *d = index.loadAcquire();
+    if (d)
+        d->ref.ref();
+    return d;
+}
+
+static void releaseIndex(const QCborContainerViewIndex *d) noexcept
+{
+    if (d && !d->ref.deref())
+        delete d;
+}
+
+// Publishes \a built unless another thread has published an index first, and
+// returns the index in use.
+static const QCborContainerViewIndex *
+publishIndex(QCborContainerViewIndexPointer &index, QCborContainerViewIndex *built) noexcept
+{
+    built->ref.ref();
+    const QCborContainerViewIndex *current = nullptr;
+    if (index.testAndSetOrdered(nullptr, built, current))
+        return built;
+    delete built;   // equivalent to the one already there
+    return current;
+}
+
+/*!
+    \class QCborValueView
+    \inmodule QtCore
+    \ingroup cbor
+    \ingroup qtserialization
+    \reentrant
+    \since 6.8
+
+    \brief The QCborValueView class provides read-only access to an encoded
+    CBOR value without decoding it.
+
+    QCborValue::fromCbor() decodes a complete CBOR stream into memory,
+    copying all strings and byte arrays. QCborValueView instead navigates the
+    encoded data where it is, for instance in a file mapped with
+    QFile::map(). Creating a view costs nothing, and only the parts of the
+    data that are accessed are ever read, which allows querying very large
+    archives with little memory:
+
+    \code
+    QFile file(u"archive.cbor"_s);
+    file.open(QIODevice::ReadOnly);
+    const uchar *data = file.map(0, file.size());
+    QCborValueView root(QByteArrayView(data, file.size()));
+    const QCborMapView entry = root.toMap().value(u"entries").toArray().at(123456).toMap();
+    qDebug() << entry.value(u"name").toString() << entry.value(u"size").toInteger();
+    \endcode
+
+    Like QStringView, QCborValueView doesn't own the data: it has to remain
+    valid and unchanged for as long as the view, and any view obtained from
+    it, is used.
+
+    The data is not validated up front. A value that is malformed or
+    truncated has the type QCborValue::Invalid, and containers stop at the
+    first such element. The views never read outside of the data given to
+    the constructor. Text strings are not checked for valid UTF-8 either.
+
+    Unlike QCborValue, QCborValueView doesn't interpret tags: tagged values
+    such as dates have the type QCborValue::Tag, and taggedValue() returns
+    the value they contain. Use toCborValue() to decode a value, with all of
+    its contents, into a QCborValue.
+
+    \sa QCborArrayView, QCborMapView, QCborValue, QCborStreamReader
+*/
+
+/*!
+    \fn QCborValueView::QCborValueView()
+
+    Constructs an invalid view.
+*/
+
+/*!
+    \fn QCborValueView::QCborValueView(QByteArrayView encoded)
+
+    Constructs a view of the first CBOR item in \a encoded. Data after the
+    first item is ignored.
+*/
+
+/*!
+    Returns the type of the value. For strings and for the number of elements
+    of containers, this only looks at the beginning of the encoded value.
+
+    Integers that don't fit into a qint64 have the type QCborValue::Double,
+    as in QCborValue. The additional types that QCborValue uses for some
+    tags are not recognized; they have the type QCborValue::Tag.
+*/
+QCborValue::Type QCborValueView::type() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h))
+        return QCborValue::Invalid;
+
+    switch (h.major) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+        return h.value > quint64(std::numeric_limits<qint64>::max())
+                ? QCborValue::Double : QCborValue::Integer;
+    case ByteStringType:
+    case TextStringType:
+        if (!h.isIndefinite() && quint64(end - ptr - h.size) < h.value)
+            return QCborValue::Invalid;
+        return h.major == ByteStringType ? QCborValue::ByteArray : QCborValue::String;
+    case ArrayType:
+        return QCborValue::Array;
+    case MapType:
+        return QCborValue::Map;
+    case TagType:
+        return QCborValue::Tag;
+    case SimpleTypesType:
+        if (h.isFloat())
+            return QCborValue::Double;
+        if (h.isIndefinite())
+            return QCborValue::Invalid;
+        return QCborValue::Type(QCborValue::SimpleType + int(h.value));
+    }
+    Q_UNREACHABLE_RETURN(QCborValue::Invalid);
+}
+
+/*!
+    Returns the integer value, if this is an integer. Otherwise returns
+    \a defaultValue.
+
+    \sa toDouble()
+*/
+qint64 QCborValueView::toInteger(qint64 defaultValue) const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.value > quint64(std::numeric_limits<qint64>::max()))
+        return defaultValue;
+    if (h.major == UnsignedIntegerType)
+        return qint64(h.value);
+    if (h.major == NegativeIntegerType)
+        return -1 - qint64(h.value);
+    return defaultValue;
+}
+
+/*!
+    Returns the floating point value, if this is a floating point number of
+    any precision. Integers are converted to \c double. Otherwise returns
+    \a defaultValue.
+
+    \sa toInteger()
+*/
+double QCborValueView::toDouble(double defaultValue) const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h))
+        return defaultValue;
+    if (h.major == UnsignedIntegerType)
+        return double(h.value);
+    if (h.major == NegativeIntegerType)
+        return -1 - double(h.value);
+    if (!h.isFloat())
+        return defaultValue;
+
+    switch (h.info) {
+    case HalfPrecisionFloat: {
+        const quint16 bits = quint16(h.value);
+        qfloat16 f;
+        memcpy(static_cast<void *>(&f), &bits, sizeof(f));
+        return double(f);
+    }
+    case SinglePrecisionFloat: {
+        const quint32 bits = quint32(h.value);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return double(f);
+    }
+    default: {
+        double d;
+        memcpy(&d, &h.value, sizeof(d));
+        return d;
+    }
+    }
+}
+
+/*!
+    Returns the boolean value, if this is \c true or \c false. Otherwise
+    returns \a defaultValue.
+*/
+bool QCborValueView::toBool(bool defaultValue) const noexcept
+{
+    switch (type()) {
+    case QCborValue::True:
+        return true;
+    case QCborValue::False:
+        return false;
+    default:
+        return defaultValue;
+    }
+}
+
+/*!
+    Returns the simple type, if this is a simple type, including \c false,
+    \c true, \c null and \c undefined. Otherwise returns \a defaultValue.
+*/
+QCborSimpleType QCborValueView::toSimpleType(QCborSimpleType defaultValue) const noexcept
+{
+    return isSimpleType() ? QCborSimpleType(type() & 0xff) : defaultValue;
+}
+
+/*!
+    Returns a view of the bytes, if this is a byte array that is encoded in
+    one piece. Otherwise, including for byte arrays that are encoded in
+    chunks, returns a null view.
+
+    \sa toByteArray(), toUtf8StringView()
+*/
+QByteArrayView QCborValueView::toByteArrayView() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != ByteStringType || h.isIndefinite()
+            || quint64(end - ptr - h.size) < h.value) {
+        return QByteArrayView();
+    }
+    return QByteArrayView(ptr + h.size, qsizetype(h.value));
+}
+
+/*!
+    Returns a view of the text, if this is a text string that is encoded in
+    one piece. Otherwise, including for strings that are encoded in chunks,
+    returns a null view.
+
+    \sa toString(), toByteArrayView()
+*/
+QUtf8StringView QCborValueView::toUtf8StringView() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != TextStringType || h.isIndefinite()
+            || quint64(end - ptr - h.size) < h.value) {
+        return QUtf8StringView();
+    }
+    return QUtf8StringView(ptr + h.size, qsizetype(h.value));
+}
+
+/*!
+    Returns a copy of the bytes, if this is a byte array. Otherwise returns
+    \a defaultValue.
+
+    \sa toByteArrayView()
+*/
+QByteArray QCborValueView::toByteArray(const QByteArray &defaultValue) const
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != ByteStringType)
+        return defaultValue;
+
+    QByteArray result;
+    if (!forEachChunk(ptr, end, h, [&result](QByteArrayView chunk) { result += chunk; }))
+        return defaultValue;
+    return result;
+}
+
+/*!
+    Returns the text, if this is a text string. Otherwise returns
+    \a defaultValue.
+
+    \sa toUtf8StringView()
+*/
+QString QCborValueView::toString(const QString &defaultValue) const
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != TextStringType)
+        return defaultValue;
+    if (!h.isIndefinite()) {
+        const QUtf8StringView text = toUtf8StringView();
+        return text.isNull() ? defaultValue : text.toString();
+    }
+
+    QByteArray utf8;
+    if (!forEachChunk(ptr, end, h, [&utf8](QByteArrayView chunk) { utf8 += chunk; }))
+        return defaultValue;
+    return QString::fromUtf8(utf8);
+}
+
+/*!
+    Returns the tag number, if this is a tagged value. Otherwise returns
+    \a defaultValue.
+
+    \sa taggedValue()
+*/
+QCborTag QCborValueView::tag(QCborTag defaultValue) const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != TagType)
+        return defaultValue;
+    return QCborTag(h.value);
+}
+
+/*!
+    Returns a view of the value that the tag applies to, if this is a tagged
+    value. Otherwise returns an invalid view.
+
+    \sa tag()
+*/
+QCborValueView QCborValueView::taggedValue() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, end, &h) || h.major != TagType)
+        return QCborValueView();
+    return QCborValueView(ptr + h.size, end);
+}
+
+/*!
+    Returns a view of the array, if this is an array. Otherwise returns an
+    empty array view.
+*/
+QCborArrayView QCborValueView::toArray() const noexcept
+{
+    if (!isArray())
+        return QCborArrayView();
+    return QCborArrayView(ptr, end);
+}
+
+/*!
+    Returns a view of the map, if this is a map. Otherwise returns an empty
+    map view.
+*/
+QCborMapView QCborValueView::toMap() const noexcept
+{
+    if (!isMap())
+        return QCborMapView();
+    return QCborMapView(ptr, end);
+}
+
+/*!
+    Returns the encoded bytes of this value, including all of its contents.
+    Returns an empty view if the value is malformed or truncated.
+
+    This reads the complete value, which for large containers takes time
+    proportional to their encoded size.
+*/
+QByteArrayView QCborValueView::encoded() const noexcept
+{
+    const uchar *itemEnd = skipItem(ptr, end);
+    if (!itemEnd)
+        return QByteArrayView();
+    return QByteArrayView(ptr, itemEnd - ptr);
+}
+
+/*!
+    Decodes this value, with all of its contents, into a QCborValue. Returns
+    an invalid QCborValue if the value is malformed or truncated.
+
+    \sa QCborValue::fromCbor()
+*/
+QCborValue QCborValueView::toCborValue() const
+{
+    const QByteArrayView data = encoded();
+    if (data.isEmpty())
+        return QCborValue(QCborValue::Invalid);
+    return QCborValue::fromCbor(data.data(), data.size());
+}
+
+/*!
+    \class QCborArrayView
+    \inmodule QtCore
+    \ingroup cbor
+    \ingroup qtserialization
+    \reentrant
+    \since 6.8
+
+    \brief The QCborArrayView class provides read-only access to an encoded
+    CBOR array.
+
+    Iterating over the array reads each element once. The first call to at()
+    for an index beyond the first few elements reads the complete array and
+    remembers where each element starts, so that further calls take
+    constant time. That index is shared by copies of the view made after it
+    was built. It is never modified once built, so those copies can be used
+    in different threads.
+
+    \sa QCborValueView, QCborMapView
+*/
+
+/*!
+    Constructs a copy of \a other, sharing its index if it has one.
+*/
+QCborArrayView::QCborArrayView(const QCborArrayView &other) noexcept
+    : ptr(other.ptr), limit(other.limit), index(copyIndex(other.index))
+{
+}
+
+/*!
+    Destroys the view.
+*/
+QCborArrayView::~QCborArrayView()
+{
+    releaseIndex(index.loadRelaxed());
+}
+
+/*!
+    Makes this view a copy of \a other, sharing its index if it has one.
+*/
+QCborArrayView &QCborArrayView::operator=(const QCborArrayView &other) noexcept
+{
+    QCborArrayView copy(other);
+    swap(copy);
+    return *this;
+}
+
+/*!
+    Returns the number of elements. For arrays of indefinite length, this
+    reads the complete array the first time it is called.
+*/
+qsizetype QCborArrayView::size() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, limit, &h))
+        return 0;
+    if (!h.isIndefinite())
+        return qsizetype(qMin(h.value, quint64(limit - ptr)));
+
+    return ensureIndex()->size;
+}
+
+/*!
+    Returns a view of the element at index \a i, or an invalid view if
+    \a i is out of range.
+*/
+QCborValueView QCborArrayView::at(qsizetype i) const
+{
+    if (i < 0)
+        return QCborValueView();
+
+    if (i < linearSearchLimit && !index.loadAcquire()) {
+        auto it = constBegin();
+        for ( ; i && it != constEnd(); --i)
+            ++it;
+        return *it;
+    }
+
+    const QCborContainerViewIndex *d = ensureIndex();
+    if (i >= d->elements.size())
+        return QCborValueView();
+    return QCborValueView(d->elements.at(i), limit);
+}
+
+const QCborContainerViewIndex *QCborArrayView::ensureIndex() const
+{
+    if (const QCborContainerViewIndex *d = index.loadAcquire())
+        return d;
+
+    auto built = new QCborContainerViewIndex;
+    for (auto it = constBegin(); it != constEnd(); ++it)
+        built->elements.append(it.pos);
+    built->size = built->elements.size();
+    return publishIndex(index, built);
+}
+
+/*!
+    Returns an iterator to the first element.
+*/
+QCborArrayView::ConstIterator QCborArrayView::constBegin() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, limit, &h) || h.major != ArrayType)
+        return ConstIterator();
+    const uchar *first = ptr + h.size;
+    if (h.isIndefinite()) {
+        if (first != limit && *first == BreakByte)
+            return ConstIterator();
+        return ConstIterator(first, limit, -1);
+    }
+    if (h.value == 0 || h.value > quint64(limit - first))
+        return ConstIterator();
+    return ConstIterator(first, limit, qint64(h.value));
+}
+
+void QCborArrayView::advance(const uchar *&pos, const uchar *limit, qint64 &remaining) noexcept
+{
+    const uchar *next = skipItem(pos, limit);
+    if (remaining > 0)
+        --remaining;
+    if (!next || remaining == 0 || (remaining < 0 && next != limit && *next == BreakByte))
+        pos = nullptr;
+    else
+        pos = next;     // at the end of the data, the element is invalid
+}
+
+/*!
+    \class QCborMapView
+    \inmodule QtCore
+    \ingroup cbor
+    \ingroup qtserialization
+    \reentrant
+    \since 6.8
+
+    \brief The QCborMapView class provides read-only access to an encoded
+    CBOR map.
+
+    Maps with a few pairs are searched by reading them from the beginning.
+    For larger maps, the first lookup reads the complete map and builds a
+    hash table of its keys, so that further lookups take constant time. That
+    index is shared by copies of the view made after it was built. It is
+    never modified once built, so those copies can be used in different
+    threads.
+
+    Lookups compare integer keys by value and text string keys by their
+    UTF-8 contents, regardless of how the key is encoded. Keys of other
+    types can only be reached by iterating. If a key occurs more than once,
+    lookups find the first occurrence.
+
+    \sa QCborValueView, QCborArrayView
+*/
+
+/*!
+    Constructs a copy of \a other, sharing its index if it has one.
+*/
+QCborMapView::QCborMapView(const QCborMapView &other) noexcept
+    : ptr(other.ptr), limit(other.limit), index(copyIndex(other.index))
+{
+}
+
+/*!
+    Destroys the view.
+*/
+QCborMapView::~QCborMapView()
+{
+    releaseIndex(index.loadRelaxed());
+}
+
+/*!
+    Makes this view a copy of \a other, sharing its index if it has one.
+*/
+QCborMapView &QCborMapView::operator=(const QCborMapView &other) noexcept
+{
+    QCborMapView copy(other);
+    swap(copy);
+    return *this;
+}
+
+/*!
+    Returns the number of key-value pairs. For maps of indefinite length,
+    this reads the complete map the first time it is called.
+*/
+qsizetype QCborMapView::size() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, limit, &h))
+        return 0;
+    if (!h.isIndefinite())
+        return qsizetype(qMin(h.value, quint64(limit - ptr)));
+
+    return ensureIndex()->size;
+}
+
+/*!
+    Returns a view of the value for the integer \a key, or an invalid view
+    if the map doesn't contain it.
+*/
+QCborValueView QCborMapView::value(qint64 key) const
+{
+    EncodedKey encodedKey;
+    encodeKey(encodedKey, key);
+    return find(QByteArrayView(encodedKey.data(), encodedKey.size()));
+}
+
+/*!
+    Returns a view of the value for the text string \a key, or an invalid
+    view if the map doesn't contain it.
+*/
+QCborValueView QCborMapView::value(QAnyStringView key) const
+{
+    EncodedKey encodedKey;
+    encodeKey(encodedKey, key);
+    return find(QByteArrayView(encodedKey.data(), encodedKey.size()));
+}
+
+QCborValueView QCborMapView::find(QByteArrayView encodedKey) const
+{
+    if (!index.loadAcquire()) {
+        Header h;
+        if (!readHeader(ptr, limit, &h))
+            return QCborValueView();
+        if (!h.isIndefinite() && h.value <= quint64(linearSearchLimit)) {
+            EncodedKey storage;
+            for (auto it = constBegin(); it != constEnd(); ++it) {
+                if (!it.valuePos)
+                    break;
+                if (canonicalKey(it.keyPos, it.valuePos, storage) == encodedKey)
+                    return it.value();
+            }
+            return QCborValueView();
+        }
+    }
+
+    const QCborContainerViewIndex *d = ensureIndex();
+    const auto it = d->values.constFind(
+            QByteArray::fromRawData(encodedKey.data(), encodedKey.size()));
+    if (it == d->values.cend())
+        return QCborValueView();
+    return QCborValueView(*it, limit);
+}
+
+const QCborContainerViewIndex *QCborMapView::ensureIndex() const
+{
+    if (const QCborContainerViewIndex *d = index.loadAcquire())
+        return d;
+
+    auto built = new QCborContainerViewIndex;
+    EncodedKey storage;
+    for (auto it = constBegin(); it != constEnd(); ++it) {
+        ++built->size;
+        if (!it.valuePos)
+            continue;
+        const QByteArrayView key = canonicalKey(it.keyPos, it.valuePos, storage);
+        QByteArray hashKey = key.data() == storage.data()
+                ? key.toByteArray() : QByteArray::fromRawData(key.data(), key.size());
+        if (!built->values.contains(hashKey))
+            built->values.insert(std::move(hashKey), it.valuePos);
+    }
+    return publishIndex(index, built);
+}
+
+/*!
+    Returns an iterator to the first key-value pair.
+*/
+QCborMapView::ConstIterator QCborMapView::constBegin() const noexcept
+{
+    Header h;
+    if (!readHeader(ptr, limit, &h) || h.major != MapType)
+        return ConstIterator();
+    const uchar *first = ptr + h.size;
+    qint64 remaining = -1;
+    if (h.isIndefinite()) {
+        if (first != limit && *first == BreakByte)
+            return ConstIterator();
+    } else {
+        if (h.value == 0 || h.value > quint64(limit - first))
+            return ConstIterator();
+        remaining = qint64(h.value);
+    }
+    return ConstIterator(first, skipItem(first, limit), limit, remaining);
+}
+
+void QCborMapView::advance(const uchar *&keyPos, const uchar *&valuePos, const uchar *limit,
+                           qint64 &remaining) noexcept
+{
+    const uchar *next = valuePos ? skipItem(valuePos, limit) : nullptr;
+    if (remaining > 0)
+        --remaining;
+    if (!next || remaining == 0 || (remaining < 0 && next != limit && *next == BreakByte)) {
+        keyPos = valuePos = nullptr;
+    } else {
+        keyPos = next;
+        valuePos = skipItem(next, limit);
+    }
+}
+
+QT_END_NAMESPACE
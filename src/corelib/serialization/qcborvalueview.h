@@ -0,0 +1,251 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCBORVALUEVIEW_H
+#define QCBORVALUEVIEW_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qutf8stringview.h>
+
+#include <iterator>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class QCborArrayView;
+class QCborMapView;
+
+class QCborContainerViewIndex;
+
+class Q_CORE_EXPORT QCborValueView
+{
+public:
+    constexpr QCborValueView() noexcept = default;
+    explicit QCborValueView(QByteArrayView encoded) noexcept
+        : ptr(reinterpret_cast<const uchar *>(encoded.data())),
+          end(reinterpret_cast<const uchar *>(encoded.data() + encoded.size()))
+    {
+        if (ptr == end)
+            ptr = end = nullptr;
+    }
+
+    QCborValue::Type type() const noexcept;
+    bool isInteger() const noexcept { return type() == QCborValue::Integer; }
+    bool isByteArray() const noexcept { return type() == QCborValue::ByteArray; }
+    bool isString() const noexcept { return type() == QCborValue::String; }
+    bool isArray() const noexcept { return type() == QCborValue::Array; }
+    bool isMap() const noexcept { return type() == QCborValue::Map; }
+    bool isTag() const noexcept { return type() == QCborValue::Tag; }
+    bool isFalse() const noexcept { return type() == QCborValue::False; }
+    bool isTrue() const noexcept { return type() == QCborValue::True; }
+    bool isBool() const noexcept { return isFalse() || isTrue(); }
+    bool isNull() const noexcept { return type() == QCborValue::Null; }
+    bool isUndefined() const noexcept { return type() == QCborValue::Undefined; }
+    bool isDouble() const noexcept { return type() == QCborValue::Double; }
+    bool isSimpleType() const noexcept
+    { return (type() & ~0xff) == QCborValue::SimpleType; }
+    bool isInvalid() const noexcept { return type() == QCborValue::Invalid; }
+
+    qint64 toInteger(qint64 defaultValue = 0) const noexcept;
+    double toDouble(double defaultValue = 0) const noexcept;
+    bool toBool(bool defaultValue = false) const noexcept;
+    QCborSimpleType toSimpleType(QCborSimpleType defaultValue = QCborSimpleType::Undefined) const noexcept;
+
+    QByteArrayView toByteArrayView() const noexcept;
+    QUtf8StringView toUtf8StringView() const noexcept;
+    QByteArray toByteArray(const QByteArray &defaultValue = {}) const;
+    QString toString(const QString &defaultValue = {}) const;
+
+    QCborTag tag(QCborTag defaultValue = QCborTag(-1)) const noexcept;
+    QCborValueView taggedValue() const noexcept;
+
+    QCborArrayView toArray() const noexcept;
+    QCborMapView toMap() const noexcept;
+
+    QByteArrayView encoded() const noexcept;
+    QCborValue toCborValue() const;
+
+private:
+    friend class QCborArrayView;
+    friend class QCborMapView;
+    constexpr QCborValueView(const uchar *ptr, const uchar *end) noexcept
+        : ptr(ptr), end(end) {}
+
+    const uchar *ptr = nullptr;     // start of the item
+    const uchar *end = nullptr;     // end of the buffer
+};
+Q_DECLARE_TYPEINFO(QCborValueView, Q_RELOCATABLE_TYPE);
+
+class Q_CORE_EXPORT QCborArrayView
+{
+public:
+    class ConstIterator
+    {
+        friend class QCborArrayView;
+        const uchar *pos = nullptr;
+        const uchar *end = nullptr;
+        qint64 remaining = 0;       // -1 for an array of indefinite length
+        constexpr ConstIterator(const uchar *pos, const uchar *end, qint64 remaining) noexcept
+            : pos(pos), end(end), remaining(remaining) {}
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = QCborValueView;
+        using reference = QCborValueView;
+        using pointer = void;
+
+        constexpr ConstIterator() = default;
+
+        QCborValueView operator*() const noexcept { return QCborValueView(pos, end); }
+        ConstIterator &operator++() noexcept
+        {
+            QCborArrayView::advance(pos, end, remaining);
+            return *this;
+        }
+        ConstIterator operator++(int) noexcept
+        {
+            ConstIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.pos == rhs.pos; }
+        friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.pos != rhs.pos; }
+    };
+    using const_iterator = ConstIterator;
+
+    QCborArrayView() noexcept = default;
+    QCborArrayView(const QCborArrayView &other) noexcept;
+    QCborArrayView(QCborArrayView &&other) noexcept
+        : ptr(other.ptr), limit(other.limit), index(other.index.fetchAndStoreRelaxed(nullptr)) {}
+    ~QCborArrayView();
+    QCborArrayView &operator=(const QCborArrayView &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QCborArrayView)
+    void swap(QCborArrayView &other) noexcept
+    {
+        std::swap(ptr, other.ptr);
+        std::swap(limit, other.limit);
+        index.storeRelaxed(other.index.fetchAndStoreRelaxed(index.loadRelaxed()));
+    }
+
+    qsizetype size() const noexcept;
+    bool isEmpty() const noexcept { return constBegin() == constEnd(); }
+    QCborValueView at(qsizetype i) const;
+    QCborValueView operator[](qsizetype i) const { return at(i); }
+    QCborValueView first() const noexcept { return *constBegin(); }
+
+    ConstIterator begin() const noexcept { return constBegin(); }
+    ConstIterator constBegin() const noexcept;
+    ConstIterator end() const noexcept { return constEnd(); }
+    ConstIterator constEnd() const noexcept { return ConstIterator(); }
+
+private:
+    friend class QCborValueView;
+    QCborArrayView(const uchar *ptr, const uchar *limit) noexcept
+        : ptr(ptr), limit(limit) {}
+    static void advance(const uchar *&pos, const uchar *limit, qint64 &remaining) noexcept;
+    const QCborContainerViewIndex *ensureIndex() const;
+
+    const uchar *ptr = nullptr;
+    const uchar *limit = nullptr;   // end of the buffer
+    // set once, to an index that is never modified afterwards
+    mutable QAtomicPointer<const QCborContainerViewIndex> index;
+};
+
+class Q_CORE_EXPORT QCborMapView
+{
+public:
+    class ConstIterator
+    {
+        friend class QCborMapView;
+        const uchar *keyPos = nullptr;
+        const uchar *valuePos = nullptr;
+        const uchar *end = nullptr;
+        qint64 remaining = 0;       // -1 for a map of indefinite length
+        constexpr ConstIterator(const uchar *keyPos, const uchar *valuePos, const uchar *end,
+                                qint64 remaining) noexcept
+            : keyPos(keyPos), valuePos(valuePos), end(end), remaining(remaining) {}
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = std::pair<QCborValueView, QCborValueView>;
+        using reference = value_type;
+        using pointer = void;
+
+        constexpr ConstIterator() = default;
+
+        value_type operator*() const noexcept { return { key(), value() }; }
+        QCborValueView key() const noexcept { return QCborValueView(keyPos, end); }
+        QCborValueView value() const noexcept { return QCborValueView(valuePos, end); }
+        ConstIterator &operator++() noexcept
+        {
+            QCborMapView::advance(keyPos, valuePos, end, remaining);
+            return *this;
+        }
+        ConstIterator operator++(int) noexcept
+        {
+            ConstIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.keyPos == rhs.keyPos; }
+        friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.keyPos != rhs.keyPos; }
+    };
+    using const_iterator = ConstIterator;
+
+    QCborMapView() noexcept = default;
+    QCborMapView(const QCborMapView &other) noexcept;
+    QCborMapView(QCborMapView &&other) noexcept
+        : ptr(other.ptr), limit(other.limit), index(other.index.fetchAndStoreRelaxed(nullptr)) {}
+    ~QCborMapView();
+    QCborMapView &operator=(const QCborMapView &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QCborMapView)
+    void swap(QCborMapView &other) noexcept
+    {
+        std::swap(ptr, other.ptr);
+        std::swap(limit, other.limit);
+        index.storeRelaxed(other.index.fetchAndStoreRelaxed(index.loadRelaxed()));
+    }
+
+    qsizetype size() const noexcept;
+    bool isEmpty() const noexcept { return constBegin() == constEnd(); }
+
+    QCborValueView value(qint64 key) const;
+    QCborValueView value(QAnyStringView key) const;
+    QCborValueView operator[](qint64 key) const { return value(key); }
+    QCborValueView operator[](QAnyStringView key) const { return value(key); }
+    bool contains(qint64 key) const { return !value(key).isInvalid(); }
+    bool contains(QAnyStringView key) const { return !value(key).isInvalid(); }
+
+    ConstIterator begin() const noexcept { return constBegin(); }
+    ConstIterator constBegin() const noexcept;
+    ConstIterator end() const noexcept { return constEnd(); }
+    ConstIterator constEnd() const noexcept { return ConstIterator(); }
+
+private:
+    friend class QCborValueView;
+    QCborMapView(const uchar *ptr, const uchar *limit) noexcept
+        : ptr(ptr), limit(limit) {}
+    static void advance(const uchar *&keyPos, const uchar *&valuePos, const uchar *limit,
+                        qint64 &remaining) noexcept;
+    QCborValueView find(QByteArrayView encodedKey) const;
+    const QCborContainerViewIndex *ensureIndex() const;
+
+    const uchar *ptr = nullptr;
+    const uchar *limit = nullptr;   // end of the buffer
+    // set once, to an index that is never modified afterwards
+    mutable QAtomicPointer<const QCborContainerViewIndex> index;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCBORVALUEVIEW_H
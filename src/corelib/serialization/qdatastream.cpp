@@ -1420,6 +1420,103 @@ qint64 QDataStream::writeRawData(const char *s, qint64 len)
     return ret;
 }
 
+/*!
+    \fn template <typename T> qint64 QDataStream::readRawSpan(T *data, qint64 count)
+    \since 6.8
+
+    Reads \a count elements of type \c T from the stream into \a data and
+    returns the number of elements read. If an error occurs, this function
+    returns -1.
+
+    \c T must be an integral type other than \c bool, \c float or \c
+    double. Each element is read as \c{sizeof(T)} bytes in the stream's
+    byteOrder(). Unlike operator>>(), this function doesn't apply
+    floatingPointPrecision() and reads the whole span with a single device
+    read, so it is much faster for large amounts of data.
+
+    The buffer \a data must be preallocated.
+
+    \sa writeRawSpan(), readRawData()
+*/
+
+/*!
+    \fn template <typename T> qint64 QDataStream::writeRawSpan(const T *data, qint64 count)
+    \since 6.8
+
+    Writes \a count elements of type \c T from \a data to the stream and
+    returns the number of elements written, or -1 on error.
+
+    \c T must be an integral type other than \c bool, \c float or \c
+    double. Each element is written as \c{sizeof(T)} bytes in the stream's
+    byteOrder(), byte-swapping in blocks if that differs from the host byte
+    order. Unlike operator<<(), this function doesn't apply
+    floatingPointPrecision().
+
+    QList of such types uses this function when the stream's settings
+    encode the elements the same way as operator<<() does.
+
+    \sa readRawSpan(), writeRawData()
+*/
+
+/*!
+    \internal
+
+    Reads \a count elements of \a size bytes each and swaps them to host
+    byte order in place.
+*/
+qint64 QDataStream::readSwappedBlock(void *data, qint64 count, qsizetype size)
+{
+    CHECK_STREAM_PRECOND(-1)
+    const qint64 len = readBlock(static_cast<char *>(data), count * size);
+    if (len < 0)
+        return -1;
+    const qint64 n = len / size;
+    if (!noswap) {
+        switch (size) {
+        case 2: qbswap<2>(data, n, data); break;
+        case 4: qbswap<4>(data, n, data); break;
+        case 8: qbswap<8>(data, n, data); break;
+        }
+    }
+    return n;
+}
+
+/*!
+    \internal
+
+    Writes \a count elements of \a size bytes each, swapped to the stream's
+    byte order through a buffer on the stack.
+*/
+qint64 QDataStream::writeSwappedBlock(const void *data, qint64 count, qsizetype size)
+{
+    CHECK_STREAM_WRITE_PRECOND(-1)
+    const char *src = static_cast<const char *>(data);
+    if (noswap || size == 1) {
+        const qint64 written = writeRawData(src, count * size);
+        return written < 0 ? -1 : written / size;
+    }
+
+    char buffer[16 * 1024];
+    qint64 done = 0;
+    while (done < count) {
+        const qint64 n = qMin(count - done, qint64(sizeof(buffer)) / size);
+        switch (size) {
+        case 2: qbswap<2>(src + done * size, n, buffer); break;
+        case 4: qbswap<4>(src + done * size, n, buffer); break;
+        case 8: qbswap<8>(src + done * size, n, buffer); break;
+        }
+        const qint64 written = dev->write(buffer, n * size);
+        if (written != n * size) {
+            q_status = WriteFailed;
+            if (written < 0)
+                return done ? done : -1;
+            return done + written / size;
+        }
+        done += n;
+    }
+    return done;
+}
+
 /*!
     \since 4.1
 
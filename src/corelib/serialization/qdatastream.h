@@ -42,6 +42,12 @@ template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c);
 template <typename Container>
 QDataStream &writeAssociativeMultiContainer(QDataStream &s, const Container &c);
+
+// Types that QDataStream can read and write in bulk, as a plain byte-swapped
+// copy of their object representation
+template <typename T>
+constexpr bool IsRawSpanType = (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+                               || std::is_same_v<T, float> || std::is_same_v<T, double>;
 }
 class Q_CORE_EXPORT QDataStream : public QIODeviceBase
 {
@@ -206,6 +212,13 @@ public:
     qint64 writeRawData(const char *, qint64 len);
     qint64 skipRawData(qint64 len);
 
+    template <typename T, std::enable_if_t<QtPrivate::IsRawSpanType<T>, bool> = true>
+    qint64 readRawSpan(T *data, qint64 count)
+    { return readSwappedBlock(data, count, sizeof(T)); }
+    template <typename T, std::enable_if_t<QtPrivate::IsRawSpanType<T>, bool> = true>
+    qint64 writeRawSpan(const T *data, qint64 count)
+    { return writeSwappedBlock(data, count, sizeof(T)); }
+
     void startTransaction();
     bool commitTransaction();
     void rollbackTransaction();
@@ -234,6 +247,10 @@ private:
     int readBlock(char *data, int len);
 #endif
     qint64 readBlock(char *data, qint64 len);
+    qint64 readSwappedBlock(void *data, qint64 count, qsizetype size);
+    qint64 writeSwappedBlock(const void *data, qint64 count, qsizetype size);
+    template <typename T>
+    inline bool hasRawSpanEncoding() const noexcept;
     static inline qint64 readQSizeType(QDataStream &s);
     static inline bool writeQSizeType(QDataStream &s, qint64 value);
     static constexpr quint32 NullCode = 0xffffffffu;
@@ -295,9 +312,27 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
         s.setStatus(QDataStream::SizeLimitExceeded);
         return s;
     }
+    using T = typename Container::value_type;
+    if constexpr (IsRawSpanType<T> && std::is_same_v<Container, QList<T>>) {
+        if (s.hasRawSpanEncoding<T>()) {
+            // grow in steps like readBytes(), so that a corrupt size can't
+            // make us allocate far more than the data actually read
+            qsizetype step = 1024 * 1024 / sizeof(T);
+            for (qsizetype done = 0; done < n; step *= 2) {
+                const qsizetype count = qMin(step, n - done);
+                c.resizeForOverwrite(done + count);
+                if (s.readRawSpan(c.data() + done, count) != count) {
+                    c.clear();
+                    break;
+                }
+                done += count;
+            }
+            return s;
+        }
+    }
     c.reserve(n);
     for (qsizetype i = 0; i < n; ++i) {
-        typename Container::value_type t;
+        T t;
         s >> t;
         if (s.status() != QDataStream::Ok) {
             c.clear();
@@ -365,7 +400,14 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
 {
     if (!QDataStream::writeQSizeType(s, c.size()))
         return s;
-    for (const typename Container::value_type &t : c)
+    using T = typename Container::value_type;
+    if constexpr (IsRawSpanType<T> && std::is_same_v<Container, QList<T>>) {
+        if (s.hasRawSpanEncoding<T>()) {
+            s.writeRawSpan(c.constData(), c.size());
+            return s;
+        }
+    }
+    for (const T &t : c)
         s << t;
 
     return s;
@@ -483,6 +525,22 @@ bool QDataStream::writeQSizeType(QDataStream &s, qint64 value)
     return true;
 }
 
+// Whether operator<<() and operator>>() encode T the same way as
+// writeRawSpan() and readRawSpan(), so that containers can use the latter.
+template <typename T>
+bool QDataStream::hasRawSpanEncoding() const noexcept
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        if (version() < QDataStream::Qt_4_6)
+            return true;
+        return fpPrecision == (sizeof(T) == sizeof(double) ? DoublePrecision : SinglePrecision);
+    } else if constexpr (sizeof(T) == sizeof(qint64)) {
+        return version() >= QDataStream::Qt_3_3; // older versions write two 32-bit halves
+    } else {
+        return true;
+    }
+}
+
 inline QDataStream &QDataStream::operator>>(char &i)
 { return *this >> reinterpret_cast<qint8&>(i); }
 
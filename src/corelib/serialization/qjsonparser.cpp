@@ -8,6 +8,7 @@
 #include <qdebug.h>
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
+#include "qjsonscanner_p.h"
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
@@ -257,16 +258,7 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    json = skipSpace(json, end);
     return (json < end);
 }
 
@@ -862,6 +854,9 @@ bool Parser::parseString()
     bool isAscii = true;
     while (json < end) {
         char32_t ch = 0;
+        json = findStringSpecial(json, end);
+        if (json == end)
+            break;
         if (*json == '"')
             break;
         if (*json == '\\') {
@@ -904,6 +899,11 @@ bool Parser::parseString()
     QString ucs4;
     while (json < end) {
         char32_t ch = 0;
+        const char *plain = json;
+        json = findStringSpecial(json, end);
+        ucs4.append(QLatin1StringView(plain, json - plain));
+        if (json == end)
+            break;
         if (*json == '"')
             break;
         else if (*json == '\\') {
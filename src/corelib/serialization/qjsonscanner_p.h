@@ -0,0 +1,135 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONSCANNER_P_H
+#define QJSONSCANNER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/qalgorithms.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QJsonPrivate {
+
+// Bulk scanning helpers shared by the JSON parsers. They look at sixteen
+// bytes at a time where SSE2 or Neon is available and fall back to a plain
+// loop for the tail and on other architectures.
+
+constexpr bool isSpace(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Returns true if \a c ends the plain part of a string: the closing quote,
+// the start of an escape sequence, or the lead byte of a multi-byte UTF-8
+// sequence that the caller has to decode.
+constexpr bool isStringSpecial(char c) noexcept
+{
+    return c == '"' || c == '\\' || uchar(c) >= 0x80;
+}
+
+#if defined(__ARM_NEON__)
+// Returns a mask with four bits set for each non-zero byte in \a v.
+inline quint64 neonNibbleMask(uint8x16_t v) noexcept
+{
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+// Returns the first byte in [\a ptr, \a end) that is not JSON whitespace,
+// or \a end.
+inline const char *skipSpace(const char *ptr, const char *end) noexcept
+{
+    // Compact documents have no whitespace between tokens and indented ones
+    // mostly have a newline followed by a few spaces, so don't set up the
+    // vector registers unless there is a longer run.
+    for (int i = 0; i < 4; ++i, ++ptr) {
+        if (ptr == end || !isSpace(*ptr))
+            return ptr;
+    }
+
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lineFeed = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i isWhite = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                          _mm_cmpeq_epi8(data, tab)),
+                                             _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                                          _mm_cmpeq_epi8(data, carriageReturn)));
+        const uint mask = ~uint(_mm_movemask_epi8(isWhite)) & 0xffff;
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr));
+        const uint8x16_t isWhite = vorrq_u8(vorrq_u8(vceqq_u8(data, vdupq_n_u8(' ')),
+                                                     vceqq_u8(data, vdupq_n_u8('\t'))),
+                                            vorrq_u8(vceqq_u8(data, vdupq_n_u8('\n')),
+                                                     vceqq_u8(data, vdupq_n_u8('\r'))));
+        const quint64 mask = ~neonNibbleMask(isWhite);
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask) / 4;
+    }
+#endif
+
+    while (ptr != end && isSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+// Returns the first byte in [\a ptr, \a end) for which isStringSpecial() is
+// true, or \a end. Everything before it is plain ASCII that needs neither
+// decoding nor unescaping.
+inline const char *findStringSpecial(const char *ptr, const char *end) noexcept
+{
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                             _mm_cmpeq_epi8(data, backslash));
+        // the sign bit of each byte is set for non-ASCII bytes already
+        const uint mask = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr));
+        const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, vdupq_n_u8('"')),
+                                                     vceqq_u8(data, vdupq_n_u8('\\'))),
+                                            vcgeq_u8(data, vdupq_n_u8(0x80)));
+        const quint64 mask = neonNibbleMask(special);
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask) / 4;
+    }
+#endif
+
+    while (ptr != end && !isStringSpecial(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+} // namespace QJsonPrivate
+
+QT_END_NAMESPACE
+
+#endif // QJSONSCANNER_P_H
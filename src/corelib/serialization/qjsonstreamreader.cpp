@@ -0,0 +1,1004 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <private/qjsonscanner_p.h>
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+static constexpr int nestingLimit = 1024;
+static constexpr qsizetype minimumReadSize = 16 * 1024;
+
+class QJsonStreamReaderPrivate
+{
+    Q_DECLARE_TR_FUNCTIONS(QJsonStreamReader)
+public:
+    // what the grammar allows at the current position
+    enum State : quint8 {
+        ExpectValue,            // top level, after a name separator or a value separator in an array
+        ExpectValueOrEnd,       // after a begin-array
+        ExpectName,             // after a value separator in an object
+        ExpectNameOrEnd,        // after a begin-object
+        ExpectNameSeparator,    // after a name
+        ExpectSeparatorOrEnd    // after a value in a container
+    };
+
+    // result of scanning for the next token
+    enum ScanResult : quint8 {
+        Scanned,
+        NeedData,               // the data ended between two tokens
+        IncompleteToken,        // the data ended inside a token
+        Failed
+    };
+
+    void reset();
+    bool readMore();
+    bool isDataComplete() const;
+
+    ScanResult scanToken();
+    ScanResult scanValue(char c);
+    ScanResult scanString();
+    ScanResult scanNumber();
+    ScanResult scanLiteral(QByteArrayView literal, QJsonStreamReader::TokenType token);
+    ScanResult startContainer(char c);
+    ScanResult endContainer();
+    ScanResult fail(QJsonParseError::ParseError code, qsizetype at);
+    void setPrematureEnd(qsizetype at);
+    void finishValue();
+    void unescapeString();
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;              // position of the next unread byte in buffer
+    qint64 bufferOffset = 0;        // offset of buffer[0] in the stream
+    bool dataComplete = false;      // only used when there is no device
+
+    QVarLengthArray<char, 32> containers;  // '{' or '[' for each open container
+    State state = ExpectValue;
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    qsizetype tokenBegin = 0;       // the token in buffer, without the quotation marks
+    qsizetype tokenEnd = 0;
+    bool tokenHasEscapes = false;
+    bool tokenIsInteger = false;
+
+    QString unescaped;              // the text of a string with escape sequences
+    mutable QString textCache;
+    mutable QByteArray utf8Cache;
+    mutable bool textCached = false;
+    mutable bool utf8Cached = false;
+
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QString errorString;
+    qint64 errorOffset = 0;
+    qint64 endOffset = 0;           // stream offset up to which the data was scanned
+};
+
+void QJsonStreamReaderPrivate::reset()
+{
+    buffer.clear();
+    pos = 0;
+    bufferOffset = 0;
+    dataComplete = false;
+    containers.clear();
+    state = ExpectValue;
+    type = QJsonStreamReader::NoToken;
+    tokenBegin = tokenEnd = 0;
+    tokenHasEscapes = tokenIsInteger = false;
+    unescaped.clear();
+    textCache.clear();
+    utf8Cache.clear();
+    textCached = utf8Cached = false;
+    error = QJsonStreamReader::NoError;
+    errorString.clear();
+    errorOffset = 0;
+    endOffset = 0;
+}
+
+/*
+    Reads more data from the device. Reads at least as much as the buffer
+    already holds after pos, so that rescanning a token that spans many reads
+    doesn't become quadratic.
+*/
+bool QJsonStreamReaderPrivate::readMore()
+{
+    if (!device)
+        return false;
+    if (pos > 0) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        tokenBegin -= pos;
+        tokenEnd -= pos;
+        pos = 0;
+    }
+    const QByteArray data = device->read(qMax(minimumReadSize, buffer.size()));
+    if (data.isEmpty())
+        return false;
+    buffer.append(data);
+    return true;
+}
+
+/*
+    Returns true if no more data will follow the data in the buffer. Only
+    then can a number at the end of the buffer be known to be complete.
+*/
+bool QJsonStreamReaderPrivate::isDataComplete() const
+{
+    if (device)
+        return !device->isSequential() && device->atEnd();
+    return dataComplete;
+}
+
+QJsonStreamReaderPrivate::ScanResult
+QJsonStreamReaderPrivate::fail(QJsonParseError::ParseError code, qsizetype at)
+{
+    type = QJsonStreamReader::Invalid;
+    error = QJsonStreamReader::NotWellFormedError;
+    errorString = QJsonParseError{int(bufferOffset + at), code}.errorString();
+    errorOffset = bufferOffset + at;
+    return Failed;
+}
+
+void QJsonStreamReaderPrivate::setPrematureEnd(qsizetype at)
+{
+    type = QJsonStreamReader::Invalid;
+    error = QJsonStreamReader::PrematureEndOfDocumentError;
+    errorString = tr("Premature end of document.");
+    errorOffset = bufferOffset + at;
+    endOffset = bufferOffset + buffer.size();
+}
+
+void QJsonStreamReaderPrivate::finishValue()
+{
+    state = containers.isEmpty() ? ExpectValue : ExpectSeparatorOrEnd;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::startContainer(char c)
+{
+    if (containers.size() >= nestingLimit)
+        return fail(QJsonParseError::DeepNesting, pos);
+    containers.append(c);
+    tokenBegin = pos++;
+    tokenEnd = pos;
+    if (c == '{') {
+        type = QJsonStreamReader::StartObject;
+        state = ExpectNameOrEnd;
+    } else {
+        type = QJsonStreamReader::StartArray;
+        state = ExpectValueOrEnd;
+    }
+    return Scanned;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::endContainer()
+{
+    type = containers.last() == '{' ? QJsonStreamReader::EndObject
+                                    : QJsonStreamReader::EndArray;
+    containers.removeLast();
+    tokenBegin = pos++;
+    tokenEnd = pos;
+    finishValue();
+    return Scanned;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanToken()
+{
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    for (;;) {
+        pos = QJsonPrivate::skipSpace(data + pos, data + size) - data;
+        // UTF-8 byte order mark at the beginning of the stream
+        if (bufferOffset + pos == 0 && size > 0 && uchar(data[0]) == 0xef) {
+            if (size < 3)
+                return isDataComplete() ? fail(QJsonParseError::IllegalValue, 0) : IncompleteToken;
+            if (uchar(data[1]) == 0xbb && uchar(data[2]) == 0xbf) {
+                pos = 3;
+                continue;
+            }
+        }
+        if (pos == size)
+            return NeedData;
+
+        const char c = data[pos];
+        const bool inObject = !containers.isEmpty() && containers.last() == '{';
+        switch (state) {
+        case ExpectNameSeparator:
+            if (c != ':')
+                return fail(QJsonParseError::MissingNameSeparator, pos);
+            ++pos;
+            state = ExpectValue;
+            continue;
+
+        case ExpectSeparatorOrEnd:
+            if (c == ',') {
+                ++pos;
+                state = inObject ? ExpectName : ExpectValue;
+                continue;
+            }
+            if (c == (inObject ? '}' : ']'))
+                return endContainer();
+            return fail(inObject ? QJsonParseError::UnterminatedObject
+                                 : QJsonParseError::MissingValueSeparator, pos);
+
+        case ExpectNameOrEnd:
+            if (c == '}')
+                return endContainer();
+            Q_FALLTHROUGH();
+        case ExpectName:
+            if (c == '"') {
+                const ScanResult result = scanString();
+                if (result == Scanned) {
+                    type = QJsonStreamReader::Name;
+                    state = ExpectNameSeparator;
+                }
+                return result;
+            }
+            return fail(c == '}' ? QJsonParseError::MissingObject
+                                 : QJsonParseError::UnterminatedObject, pos);
+
+        case ExpectValueOrEnd:
+            if (c == ']')
+                return endContainer();
+            Q_FALLTHROUGH();
+        case ExpectValue:
+            return scanValue(c);
+        }
+        Q_UNREACHABLE_RETURN(Failed);
+    }
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanValue(char c)
+{
+    switch (c) {
+    case '{':
+    case '[':
+        return startContainer(c);
+    case '"': {
+        const ScanResult result = scanString();
+        if (result == Scanned) {
+            type = QJsonStreamReader::String;
+            finishValue();
+        }
+        return result;
+    }
+    case 't':
+        return scanLiteral("true", QJsonStreamReader::Bool);
+    case 'f':
+        return scanLiteral("false", QJsonStreamReader::Bool);
+    case 'n':
+        return scanLiteral("null", QJsonStreamReader::Null);
+    case ']':
+    case '}':
+        return fail(containers.isEmpty() ? QJsonParseError::IllegalValue
+                                         : QJsonParseError::MissingObject, pos);
+    default:
+        if (c == '-' || isAsciiDigit(c))
+            return scanNumber();
+        return fail(QJsonParseError::IllegalValue, pos);
+    }
+}
+
+QJsonStreamReaderPrivate::ScanResult
+QJsonStreamReaderPrivate::scanLiteral(QByteArrayView literal,
+                                      QJsonStreamReader::TokenType token)
+{
+    const QByteArrayView available = QByteArrayView(buffer).sliced(pos);
+    if (available.size() < literal.size()) {
+        if (!literal.startsWith(available))
+            return fail(QJsonParseError::IllegalValue, pos);
+        return isDataComplete() ? fail(QJsonParseError::IllegalValue, pos) : IncompleteToken;
+    }
+    if (!available.startsWith(literal))
+        return fail(QJsonParseError::IllegalValue, pos);
+    type = token;
+    tokenBegin = pos;
+    tokenEnd = pos += literal.size();
+    finishValue();
+    return Scanned;
+}
+
+/*
+    number = [ minus ] int [ frac ] [ exp ]
+
+    The number ends at the first byte that can't continue it. If the data ends
+    first, the number is only complete when no more data can follow.
+*/
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanNumber()
+{
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    qsizetype i = pos;
+    bool isInteger = true;
+    bool valid = true;
+    const auto digits = [&] {
+        const qsizetype start = i;
+        while (i < size && isAsciiDigit(data[i]))
+            ++i;
+        return i > start;
+    };
+
+    if (data[i] == '-')
+        ++i;
+    if (i < size && data[i] == '0')
+        ++i;
+    else
+        valid = digits() || i == size;
+    if (valid && i < size && data[i] == '.') {
+        ++i;
+        isInteger = false;
+        valid = digits() || i == size;
+    }
+    if (valid && i < size && (data[i] == 'e' || data[i] == 'E')) {
+        ++i;
+        isInteger = false;
+        if (i < size && (data[i] == '-' || data[i] == '+'))
+            ++i;
+        valid = digits() || i == size;
+    }
+
+    if (!valid)
+        return fail(QJsonParseError::IllegalNumber, pos);
+    if (i == size && !isDataComplete())
+        return IncompleteToken;
+    if (!isAsciiDigit(data[i - 1]))
+        return fail(QJsonParseError::IllegalNumber, pos);
+
+    type = QJsonStreamReader::Number;
+    tokenBegin = pos;
+    tokenEnd = pos = i;
+    tokenIsInteger = isInteger;
+    finishValue();
+    return Scanned;
+}
+
+/*
+    Scans the string starting at the quotation mark at pos, validating the
+    UTF-8 and the escape sequences. Strings without escape sequences are
+    returned in place; the others are decoded by unescapeString().
+*/
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanString()
+{
+    const char *data = buffer.constData();
+    const qsizetype size = buffer.size();
+    qsizetype i = pos + 1;
+    bool hasEscapes = false;
+    const auto incomplete = [&] {
+        return isDataComplete() ? fail(QJsonParseError::UnterminatedString, pos)
+                                : IncompleteToken;
+    };
+
+    for (;;) {
+        i = QJsonPrivate::findStringSpecial(data + i, data + size) - data;
+        if (i == size)
+            return incomplete();
+        const uchar c = data[i];
+        if (c == '"')
+            break;
+        if (c == '\\') {
+            hasEscapes = true;
+            if (i + 1 == size)
+                return incomplete();
+            if (data[i + 1] != 'u') {
+                i += 2;
+                continue;
+            }
+            if (size - i < 6)
+                return incomplete();
+            for (qsizetype j = i + 2; j < i + 6; ++j) {
+                if (fromHex(data[j]) < 0)
+                    return fail(QJsonParseError::IllegalEscapeSequence, i);
+            }
+            i += 6;
+            continue;
+        }
+        char32_t ch;
+        char32_t *dst = &ch;
+        const uchar *src = reinterpret_cast<const uchar *>(data + i + 1);
+        const uchar *end = reinterpret_cast<const uchar *>(data + size);
+        const qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(c, dst, src, end);
+        if (res == QUtf8BaseTraits::EndOfString)
+            return incomplete();
+        if (res < 0)
+            return fail(QJsonParseError::IllegalUTF8String, i);
+        i = reinterpret_cast<const char *>(src) - data;
+    }
+
+    tokenBegin = pos + 1;
+    tokenEnd = i;
+    tokenHasEscapes = hasEscapes;
+    pos = i + 1;
+    if (hasEscapes)
+        unescapeString();
+    return Scanned;
+}
+
+// The string has been validated by scanString().
+void QJsonStreamReaderPrivate::unescapeString()
+{
+    unescaped.clear();
+    const char *data = buffer.constData();
+    qsizetype i = tokenBegin;
+    while (i < tokenEnd) {
+        const void *backslash = memchr(data + i, '\\', tokenEnd - i);
+        const qsizetype next = backslash ? static_cast<const char *>(backslash) - data : tokenEnd;
+        unescaped.append(QUtf8StringView(data + i, next - i));
+        if (next == tokenEnd)
+            break;
+
+        const char escaped = data[next + 1];
+        i = next + 2;
+        switch (escaped) {
+        case 'b': unescaped.append(u'\b'); break;
+        case 'f': unescaped.append(u'\f'); break;
+        case 'n': unescaped.append(u'\n'); break;
+        case 'r': unescaped.append(u'\r'); break;
+        case 't': unescaped.append(u'\t'); break;
+        case 'u': {
+            char16_t ch = 0;
+            for (qsizetype j = i; j < i + 4; ++j)
+                ch = char16_t((ch << 4) | fromHex(data[j]));
+            unescaped.append(QChar(ch));
+            i += 4;
+            break;
+        }
+        default:
+            // like QJsonDocument, accept any other escaped character as itself
+            unescaped.append(QLatin1Char(escaped));
+            break;
+        }
+    }
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \since 6.8
+    \brief The QJsonStreamReader class provides a fast pull parser for JSON.
+
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+
+    QJsonDocument::fromJson() parses a complete document into memory before
+    the caller sees any of it. QJsonStreamReader instead reports the document
+    as a sequence of tokens, one for each call to readNext(), without
+    building a tree. This allows processing documents that are larger than
+    the available memory, extracting a few values from a large document
+    without materializing the rest, and parsing data as it arrives over the
+    network.
+
+    \code
+    QJsonStreamReader reader(&file);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isName() && reader.text() == "id"_L1) {
+            reader.readNext();
+            ids.append(reader.toInteger());
+        }
+    }
+    if (reader.hasError())
+        qWarning() << reader.errorString() << "at offset" << reader.offset();
+    \endcode
+
+    The reader accepts a sequence of top-level values, which may be separated
+    by whitespace. This makes it suitable for formats such as newline
+    delimited JSON, where each line of a file holds one value. Use
+    readValue() to materialize each of them as a QJsonValue.
+
+    The data can come from a QIODevice, set with setDevice(), or be added in
+    chunks with addData(). If the data ends in the middle of a token or of a
+    container, readNext() returns Invalid and error() returns
+    PrematureEndOfDocumentError. This error is recoverable: when more data
+    is available, call readNext() again to continue. When the data ends
+    after a complete top-level value, readNext() returns EndDocument.
+
+    The text of the current token is accessible with text() and utf8Text(),
+    which return views. utf8Text() doesn't copy strings without escape
+    sequences. The views remain valid until the next call to readNext(),
+    addData() or clear().
+
+    Strings and names are validated the same way as by
+    QJsonDocument::fromJson(). Numbers must follow the JSON grammar strictly,
+    and containers may be nested at most 1024 levels deep. Duplicate names
+    in an object are reported as they occur.
+
+    \sa QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken The reader has not yet read anything.
+    \value Invalid An error has occurred, reported in error() and
+           errorString().
+    \value EndDocument The reader has read all available top-level values.
+    \value StartObject The beginning of an object.
+    \value EndObject The end of an object.
+    \value StartArray The beginning of an array.
+    \value EndArray The end of an array.
+    \value Name The name of an object member, available in text(). The next
+           token is the value of the member.
+    \value String A string, available in text().
+    \value Number A number, available with toDouble() and toInteger().
+    \value Bool A boolean, available with toBool().
+    \value Null A null value.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError No error has occurred.
+    \value CustomError A custom error has been raised with raiseError().
+    \value NotWellFormedError The data is not valid JSON.
+    \value PrematureEndOfDocumentError The data ended in the middle of a
+           token or a container. If more data arrives, reading can continue.
+*/
+
+/*!
+    Constructs a stream reader without data.
+
+    \sa setDevice(), addData()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads from \a data.
+
+    Since \a data is known to be complete, a number at its end is reported,
+    unless more data is added with addData().
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    Q_D(QJsonStreamReader);
+    d->buffer = data;
+    d->dataComplete = true;
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader() = default;
+
+/*!
+    Sets the device to read from to \a device, and resets the reader. The
+    reader doesn't take ownership of the device.
+
+    When reading from a sequential device, such as a socket, the reader
+    can't tell whether a number at the end of the data read so far is
+    complete; it is reported as soon as the next byte arrives.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamReader);
+    d->reset();
+    d->device = device;
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if none is set.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->device;
+}
+
+/*!
+    Adds \a data for the reader to read. This function does nothing if the
+    reader has a device().
+
+    After adding data, a number at the end of the data is only reported when
+    more data follows it, since the reader can't tell whether the number is
+    complete.
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(QByteArrayView data)
+{
+    Q_D(QJsonStreamReader);
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    if (d->pos > 0) {
+        d->buffer.remove(0, d->pos);
+        d->bufferOffset += d->pos;
+        d->tokenBegin -= d->pos;
+        d->tokenEnd -= d->pos;
+        d->pos = 0;
+    }
+    d->buffer.append(data);
+    d->dataComplete = false;
+}
+
+/*!
+    Removes the data and the device from the reader, and resets it to its
+    initial state.
+
+    \sa setDevice(), addData()
+*/
+void QJsonStreamReader::clear()
+{
+    Q_D(QJsonStreamReader);
+    d->reset();
+    d->device = nullptr;
+}
+
+/*!
+    Returns \c true if the reader has read all available data or has stopped
+    because of an error; otherwise returns \c false.
+
+    A PrematureEndOfDocumentError doesn't stop the reader for good: after more
+    data becomes available, atEnd() returns \c false again.
+
+    \sa readNext(), hasError()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->error == PrematureEndOfDocumentError
+        || (d->error == NoError && d->type == EndDocument)) {
+        if (d->device)
+            return d->device->atEnd();
+        return d->bufferOffset + d->buffer.size() == d->endOffset;
+    }
+    return d->error != NoError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    After an error, except for PrematureEndOfDocumentError, this function
+    keeps returning Invalid.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    Q_D(QJsonStreamReader);
+    if (d->error != NoError && d->error != PrematureEndOfDocumentError)
+        return Invalid;
+    d->error = NoError;
+    d->errorString.clear();
+    d->textCached = d->utf8Cached = false;
+    d->tokenHasEscapes = d->tokenIsInteger = false;
+
+    // the token functions don't consume anything when they need more data, so
+    // scanning simply restarts after reading more
+    for (;;) {
+        switch (d->scanToken()) {
+        case QJsonStreamReaderPrivate::Scanned:
+        case QJsonStreamReaderPrivate::Failed:
+            return d->type;
+        case QJsonStreamReaderPrivate::IncompleteToken:
+            if (d->readMore())
+                continue;
+            d->setPrematureEnd(d->pos);
+            return d->type;
+        case QJsonStreamReaderPrivate::NeedData:
+            if (d->readMore())
+                continue;
+            if (d->containers.isEmpty() && d->state == QJsonStreamReaderPrivate::ExpectValue) {
+                d->type = EndDocument;
+                d->tokenBegin = d->tokenEnd = d->pos;
+                d->endOffset = d->bufferOffset + d->buffer.size();
+            } else if (d->isDataComplete()) {
+                d->fail(d->containers.last() == '{' ? QJsonParseError::UnterminatedObject
+                                                    : QJsonParseError::UnterminatedArray,
+                        d->pos);
+            } else {
+                d->setPrematureEnd(d->pos);
+            }
+            return d->type;
+        }
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type;
+}
+
+/*!
+    Returns the number of containers that enclose the current position. For
+    a StartObject or StartArray token, this includes the container that
+    starts; for an EndObject or EndArray token, it doesn't include the
+    container that ends.
+*/
+int QJsonStreamReader::depth() const
+{
+    Q_D(const QJsonStreamReader);
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in bytes from the beginning of the data of the current
+    token. After an error, returns the offset where the error was detected.
+*/
+qint64 QJsonStreamReader::offset() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->error != NoError)
+        return d->errorOffset;
+    qsizetype begin = d->tokenBegin;
+    if (d->type == Name || d->type == String)
+        --begin; // the quotation mark
+    return d->bufferOffset + begin;
+}
+
+/*!
+    Returns the text of a Name, String or Number token, with the escape
+    sequences of strings resolved. For other tokens, returns an empty view.
+
+    The view remains valid until the next call to readNext(), addData() or
+    clear().
+
+    \sa utf8Text()
+*/
+QStringView QJsonStreamReader::text() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->type != Name && d->type != String && d->type != Number)
+        return {};
+    if (d->tokenHasEscapes)
+        return d->unescaped;
+    if (!d->textCached) {
+        d->textCache = QString::fromUtf8(utf8Text());
+        d->textCached = true;
+    }
+    return d->textCache;
+}
+
+/*!
+    Returns the text of a Name, String or Number token as UTF-8, with the
+    escape sequences of strings resolved. For other tokens, returns an empty
+    view.
+
+    For strings without escape sequences, the view refers to the data being
+    read, so this function doesn't copy or convert anything. Escape sequences
+    for lone UTF-16 surrogates can't be represented in UTF-8; use text() to
+    read them.
+
+    The view remains valid until the next call to readNext(), addData() or
+    clear().
+
+    \sa text()
+*/
+QByteArrayView QJsonStreamReader::utf8Text() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->type != Name && d->type != String && d->type != Number)
+        return {};
+    if (d->tokenHasEscapes) {
+        if (!d->utf8Cached) {
+            d->utf8Cache = d->unescaped.toUtf8();
+            d->utf8Cached = true;
+        }
+        return d->utf8Cache;
+    }
+    return QByteArrayView(d->buffer).sliced(d->tokenBegin, d->tokenEnd - d->tokenBegin);
+}
+
+/*!
+    Returns the value of a Bool token. For other tokens, returns \c false.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Bool && d->buffer.at(d->tokenBegin) == 't';
+}
+
+/*!
+    Returns the value of a Number token. For other tokens, returns 0.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    if (tokenType() != Number)
+        return 0;
+    return utf8Text().toDouble();
+}
+
+/*!
+    Returns the value of a Number token if it is an integer that fits into
+    a qint64. Otherwise, returns \a defaultValue.
+
+    Like QJsonValue::toInteger(), this function accepts numbers written with
+    a fraction or an exponent, as long as their value is integral.
+
+    \sa toDouble()
+*/
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->type != Number)
+        return defaultValue;
+    if (d->tokenIsInteger) {
+        bool ok;
+        const qint64 n = utf8Text().toLongLong(&ok);
+        if (ok)
+            return n;
+    }
+    qint64 n;
+    if (convertDoubleTo(toDouble(), &n))
+        return n;
+    return defaultValue;
+}
+
+/*!
+    Reads the value that starts at the current token and returns it. If the
+    current token is StartObject or StartArray, reads up to and including
+    the matching EndObject or EndArray token.
+
+    Numbers are converted the same way as by QJsonDocument::fromJson().
+
+    If the current token doesn't start a value, or if an error occurs while
+    reading, returns an undefined QJsonValue. If the data ends before the
+    value is complete, the part read so far is lost; when reading data that
+    arrives in chunks, add complete values before calling this function.
+
+    \sa skipCurrentValue()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    Q_D(QJsonStreamReader);
+    switch (d->type) {
+    case String:
+        return text().toString();
+    case Number:
+        if (d->tokenIsInteger) {
+            bool ok;
+            const qint64 n = utf8Text().toLongLong(&ok);
+            if (ok)
+                return n;
+        }
+        {
+            const double value = toDouble();
+            qint64 n;
+            if (convertDoubleTo(value, &n))
+                return n;
+            return value;
+        }
+    case Bool:
+        return toBool();
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            const QJsonValue value = readValue();
+            if (hasError())
+                return QJsonValue(QJsonValue::Undefined);
+            array.append(value);
+        }
+        return array;
+    }
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString name = text().toString();
+            readNext();
+            const QJsonValue value = readValue();
+            if (hasError())
+                return QJsonValue(QJsonValue::Undefined);
+            object.insert(name, value);
+        }
+        if (hasError())
+            return QJsonValue(QJsonValue::Undefined);
+        return object;
+    }
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Skips the rest of the current object or array, if the current token is
+    StartObject or StartArray. The reader is then positioned on the
+    matching EndObject or EndArray token. For other tokens, this function
+    does nothing.
+
+    \sa readValue()
+*/
+void QJsonStreamReader::skipCurrentValue()
+{
+    Q_D(QJsonStreamReader);
+    if (d->type != StartObject && d->type != StartArray)
+        return;
+    const qsizetype level = d->containers.size();
+    while (readNext() != Invalid) {
+        if ((d->type == EndObject || d->type == EndArray) && d->containers.size() < level)
+            return;
+    }
+}
+
+/*!
+    Raises a CustomError with the message \a message. Use this function to
+    report semantic errors, such as missing members, the same way as
+    syntax errors.
+
+    \sa error(), errorString()
+*/
+void QJsonStreamReader::raiseError(const QString &message)
+{
+    Q_D(QJsonStreamReader);
+    d->errorOffset = offset();
+    d->type = Invalid;
+    d->error = CustomError;
+    d->errorString = message;
+}
+
+/*!
+    Returns the error message set when the error occurred.
+
+    \sa error(), raiseError()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->errorString;
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error occurred.
+
+    \sa errorString(), raiseError(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->error;
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error has occurred; otherwise returns \c false.
+
+    \sa error()
+*/
+
+QT_END_NAMESPACE
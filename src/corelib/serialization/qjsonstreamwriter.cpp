@@ -0,0 +1,649 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamwriter.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qlocale.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <private/qcborvalue_p.h>
+#include <private/qjson_p.h>
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+#include <charconv>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+// output is passed on to the device once the buffer holds this much
+static constexpr qsizetype flushThreshold = 16 * 1024;
+
+// the longest expansion of a single code unit: "\u001f"
+static constexpr qsizetype maxEscapeSize = 6;
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container
+    {
+        char close;             // '}' or ']'
+        bool empty = true;
+    };
+
+    QByteArray &output() { return array ? *array : buffer; }
+
+    bool checkCanWriteValue(const char *what);
+    void beginValue();
+    void endValue();
+    void writeSeparatorAndIndent(QByteArray &out);
+    void startContainer(char open, char close);
+    void endContainer(char close);
+    void writeEscaped(QAnyStringView text);
+    template <bool IsUtf8, typename Char>
+    void writeEscaped(const Char *src, const Char *end);
+    void flushIfFull();
+    void flush();
+
+    QIODevice *device = nullptr;
+    QByteArray *array = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Container, 16> containers;
+    QJsonDocument::JsonFormat format = QJsonDocument::Indented;
+    bool nameWritten = false;
+    bool topLevelWritten = false;
+    bool hasError = false;
+};
+
+bool QJsonStreamWriterPrivate::checkCanWriteValue(const char *what)
+{
+    if (containers.isEmpty() || containers.last().close == ']' || nameWritten)
+        return true;
+    qWarning("QJsonStreamWriter: %s written in an object without a name", what);
+    return false;
+}
+
+void QJsonStreamWriterPrivate::writeSeparatorAndIndent(QByteArray &out)
+{
+    const bool compact = format == QJsonDocument::Compact;
+    Container &container = containers.last();
+    if (!container.empty)
+        out += compact ? "," : ",\n";
+    container.empty = false;
+    if (!compact)
+        out.append(4 * containers.size(), ' ');
+}
+
+void QJsonStreamWriterPrivate::beginValue()
+{
+    QByteArray &out = output();
+    if (nameWritten) {
+        nameWritten = false;
+    } else if (!containers.isEmpty()) {
+        writeSeparatorAndIndent(out);
+    } else if (topLevelWritten && format == QJsonDocument::Compact) {
+        // a sequence of top-level values, one per line
+        out += '\n';
+    }
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty()) {
+        topLevelWritten = true;
+        if (format == QJsonDocument::Indented)
+            output() += '\n';
+    }
+    flushIfFull();
+}
+
+void QJsonStreamWriterPrivate::startContainer(char open, char close)
+{
+    beginValue();
+    QByteArray &out = output();
+    out += open;
+    if (format == QJsonDocument::Indented)
+        out += '\n';
+    containers.append(Container{ close });
+}
+
+void QJsonStreamWriterPrivate::endContainer(char close)
+{
+    if (containers.isEmpty() || containers.last().close != close) {
+        qWarning("QJsonStreamWriter: %s called without a matching start",
+                 close == '}' ? "endObject()" : "endArray()");
+        return;
+    }
+    if (nameWritten) {
+        qWarning("QJsonStreamWriter: endObject() called after a name without a value");
+        return;
+    }
+
+    QByteArray &out = output();
+    const bool wasEmpty = containers.last().empty;
+    containers.removeLast();
+    if (format == QJsonDocument::Indented) {
+        if (!wasEmpty)
+            out += '\n';
+        out.append(4 * containers.size(), ' ');
+    }
+    out += close;
+    endValue();
+}
+
+static inline uchar hexdig(uint u)
+{
+    return (u < 0xa ? '0' + u : 'a' + u - 0xa);
+}
+
+static inline uchar *writeEscapedAscii(uchar *cursor, uint u)
+{
+    *cursor++ = '\\';
+    switch (u) {
+    case '"':  *cursor++ = '"'; break;
+    case '\\': *cursor++ = '\\'; break;
+    case 0x8:  *cursor++ = 'b'; break;
+    case 0xc:  *cursor++ = 'f'; break;
+    case 0xa:  *cursor++ = 'n'; break;
+    case 0xd:  *cursor++ = 'r'; break;
+    case 0x9:  *cursor++ = 't'; break;
+    default:
+        *cursor++ = 'u';
+        *cursor++ = '0';
+        *cursor++ = '0';
+        *cursor++ = hexdig(u >> 4);
+        *cursor++ = hexdig(u & 0xf);
+        break;
+    }
+    return cursor;
+}
+
+// Returns true if the code unit \a u is copied to the output unchanged.
+// UTF-8 input is passed through as it is; Latin-1 and UTF-16 input has to
+// be converted above US-ASCII.
+template <bool IsUtf8, typename Char> static constexpr bool isPlain(Char u)
+{
+    return u >= 0x20 && u != '"' && u != '\\' && (IsUtf8 || u < 0x80);
+}
+
+template <bool IsUtf8, typename Char>
+void QJsonStreamWriterPrivate::writeEscaped(const Char *src, const Char *end)
+{
+    QByteArray &out = output();
+    qsizetype used = out.size();
+    out.resize(used + qMax(end - src, maxEscapeSize));
+    uchar *cursor = reinterpret_cast<uchar *>(out.data()) + used;
+    uchar *limit = reinterpret_cast<uchar *>(out.data()) + out.size() - maxEscapeSize;
+
+    while (src != end) {
+        if (cursor > limit) {
+            used = cursor - reinterpret_cast<uchar *>(out.data());
+            out.resize(used + 2 * (end - src) + maxEscapeSize);
+            cursor = reinterpret_cast<uchar *>(out.data()) + used;
+            limit = reinterpret_cast<uchar *>(out.data()) + out.size() - maxEscapeSize;
+        }
+
+        // copy the plain run that fits without checking the space per byte
+        const Char *runEnd = src + qMin(end - src, limit - cursor + 1);
+        while (src != runEnd && isPlain<IsUtf8>(*src))
+            *cursor++ = uchar(*src++);
+        if (src == runEnd)
+            continue;
+
+        const char32_t u = *src++;
+        if (u < 0x80) {
+            cursor = writeEscapedAscii(cursor, u);
+        } else if constexpr (sizeof(Char) == 1) {
+            // Latin-1; UTF-8 never gets here
+            *cursor++ = uchar(0xc0 | (u >> 6));
+            *cursor++ = uchar(0x80 | (u & 0x3f));
+        } else if constexpr (std::is_same_v<Char, char16_t>) {
+            if (QUtf8Functions::toUtf8<QUtf8BaseTraits>(char16_t(u), cursor, src, end) < 0) {
+                // unpaired surrogate, like QJsonDocument::toJson()
+                *cursor++ = '\\';
+                *cursor++ = 'u';
+                *cursor++ = hexdig(u >> 12 & 0x0f);
+                *cursor++ = hexdig(u >> 8 & 0x0f);
+                *cursor++ = hexdig(u >> 4 & 0x0f);
+                *cursor++ = hexdig(u & 0x0f);
+            }
+        }
+    }
+
+    out.truncate(cursor - reinterpret_cast<uchar *>(out.data()));
+}
+
+void QJsonStreamWriterPrivate::writeEscaped(QAnyStringView text)
+{
+    QByteArray &out = output();
+    out += '"';
+    text.visit([this](auto text) {
+        using View = decltype(text);
+        if constexpr (std::is_same_v<View, QStringView>) {
+            writeEscaped<false>(text.utf16(), text.utf16() + text.size());
+        } else {
+            constexpr bool IsUtf8 = std::is_same_v<View, QUtf8StringView>;
+            const auto *data = reinterpret_cast<const uchar *>(text.data());
+            writeEscaped<IsUtf8>(data, data + text.size());
+        }
+    });
+    output() += '"';
+}
+
+void QJsonStreamWriterPrivate::flushIfFull()
+{
+    if (device && buffer.size() >= flushThreshold)
+        flush();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (buffer.isEmpty())
+        return;
+    if (!device || device->write(buffer) != buffer.size())
+        hasError = true;
+    // keep the capacity for the next round
+    buffer.truncate(0);
+}
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \since 6.8
+    \brief The QJsonStreamWriter class writes JSON incrementally.
+
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+
+    QJsonDocument::toJson() needs the complete document as a tree of
+    QJsonObject and QJsonArray values, and returns all of the text in one
+    QByteArray. QJsonStreamWriter instead writes each value as it is
+    produced, so exporting a large data set needs neither the tree nor the
+    complete text in memory.
+
+    \code
+    QJsonStreamWriter writer(&file);
+    writer.startArray();
+    for (const Record &record : records) {
+        writer.startObject();
+        writer.writeName(u"id");
+        writer.writeInteger(record.id);
+        writer.writeName(u"title");
+        writer.writeString(record.title);
+        writer.endObject();
+    }
+    writer.endArray();
+    \endcode
+
+    Inside an object, each value has to be preceded by a call to
+    writeName(). Calls that would produce invalid JSON, such as writing a
+    value in an object without a name or ending an array with endObject(),
+    are ignored with a warning.
+
+    When writing to a QIODevice, the writer collects the output in a buffer
+    and passes it on to the device whenever the buffer holds 16 kB or more,
+    as well as in flush() and in the destructor. When constructed with a
+    QByteArray, it appends to the array directly.
+
+    The output of the writer is identical to the output of
+    QJsonDocument::toJson() with the same format for the same document. More
+    than one top-level value can be written; they are separated by newlines,
+    which makes the writer suitable for newline delimited JSON.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter, QXmlStreamWriter
+*/
+
+/*!
+    Constructs a writer without a device. Call setDevice() before writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a writer that writes to \a device. The device must be open
+    for writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : QJsonStreamWriter()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a writer that appends to \a array.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *array)
+    : QJsonStreamWriter()
+{
+    d_ptr->array = array;
+}
+
+/*!
+    Flushes the remaining output to the device and destroys the writer.
+    Containers that are still open are not closed.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    Q_D(QJsonStreamWriter);
+    d->flush();
+}
+
+/*!
+    Sets the current device to \a device, after flushing the output that was
+    written so far to the previous device. If the writer was writing to a
+    QByteArray, it stops doing so.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamWriter);
+    d->flush();
+    d->device = device;
+    d->array = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray or has no device.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->device;
+}
+
+/*!
+    Sets the output format to \a format. The default is
+    QJsonDocument::Indented, as for QJsonDocument::toJson(). The format
+    should be set before writing the first value.
+
+    \sa format()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    Q_D(QJsonStreamWriter);
+    d->format = format;
+}
+
+/*!
+    Returns the output format.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->format;
+}
+
+/*!
+    Starts an object. Write its members with pairs of writeName() and a
+    value, then close it with endObject().
+*/
+void QJsonStreamWriter::startObject()
+{
+    Q_D(QJsonStreamWriter);
+    if (d->checkCanWriteValue("object"))
+        d->startContainer('{', '}');
+}
+
+/*!
+    Closes the object started by the matching startObject().
+*/
+void QJsonStreamWriter::endObject()
+{
+    Q_D(QJsonStreamWriter);
+    d->endContainer('}');
+}
+
+/*!
+    Starts an array. Write its elements, then close it with endArray().
+*/
+void QJsonStreamWriter::startArray()
+{
+    Q_D(QJsonStreamWriter);
+    if (d->checkCanWriteValue("array"))
+        d->startContainer('[', ']');
+}
+
+/*!
+    Closes the array started by the matching startArray().
+*/
+void QJsonStreamWriter::endArray()
+{
+    Q_D(QJsonStreamWriter);
+    d->endContainer(']');
+}
+
+/*!
+    Writes \a name as the name of the next member of the current object.
+    The next call must write the member's value.
+*/
+void QJsonStreamWriter::writeName(QAnyStringView name)
+{
+    Q_D(QJsonStreamWriter);
+    if (d->containers.isEmpty() || d->containers.last().close != '}' || d->nameWritten) {
+        qWarning("QJsonStreamWriter: writeName() called outside of an object or twice in a row");
+        return;
+    }
+
+    QByteArray &out = d->output();
+    d->writeSeparatorAndIndent(out);
+    d->writeEscaped(name);
+    d->output() += d->format == QJsonDocument::Compact ? ":" : ": ";
+    d->nameWritten = true;
+}
+
+/*!
+    Writes \a text as a string value, escaping it as required by JSON.
+*/
+void QJsonStreamWriter::writeString(QAnyStringView text)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->checkCanWriteValue("string"))
+        return;
+    d->beginValue();
+    d->writeEscaped(text);
+    d->endValue();
+}
+
+/*!
+    Writes \a value as a number.
+*/
+void QJsonStreamWriter::writeInteger(qint64 value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->checkCanWriteValue("number"))
+        return;
+    d->beginValue();
+    char buf[24];
+    const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    d->output().append(buf, result.ptr - buf);
+    d->endValue();
+}
+
+/*!
+    Writes \a value as a number, using the shortest representation that
+    reads back as the same value. JSON has no representation for infinities
+    and NaN; they are written as \c null, like QJsonDocument::toJson() does.
+*/
+void QJsonStreamWriter::writeDouble(double value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->checkCanWriteValue("number"))
+        return;
+    d->beginValue();
+    if (qt_is_finite(value))
+        d->output() += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    else
+        d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value as \c true or \c false.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->checkCanWriteValue("boolean"))
+        return;
+    d->beginValue();
+    d->output() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->checkCanWriteValue("null"))
+        return;
+    d->beginValue();
+    d->output() += "null";
+    d->endValue();
+}
+
+// Returns the string at \a idx in \a c without converting it.
+static QAnyStringView stringViewAt(const QCborContainerPrivate *c, qsizetype idx)
+{
+    const QtCbor::Element &e = c->elements.at(idx);
+    const QtCbor::ByteData *b = c->byteData(e);
+    if (!b)
+        return QAnyStringView();
+    if (e.flags & QtCbor::Element::StringIsUtf16)
+        return b->asStringView();
+    if (e.flags & QtCbor::Element::StringIsAscii)
+        return b->asLatin1();
+    return b->asUtf8StringView();
+}
+
+static void writeContents(QJsonStreamWriter &writer, const QCborContainerPrivate *c, bool isObject);
+
+static void writeElement(QJsonStreamWriter &writer, const QCborContainerPrivate *c, qsizetype idx)
+{
+    const QtCbor::Element &e = c->elements.at(idx);
+    const QCborContainerPrivate *child =
+            (e.flags & QtCbor::Element::IsContainer) ? e.container : nullptr;
+    switch (e.type) {
+    case QCborValue::Integer:
+        writer.writeInteger(e.value);
+        break;
+    case QCborValue::Double:
+        writer.writeDouble(e.fpvalue());
+        break;
+    case QCborValue::True:
+    case QCborValue::False:
+        writer.writeBool(e.type == QCborValue::True);
+        break;
+    case QCborValue::String:
+        writer.writeString(stringViewAt(c, idx));
+        break;
+    case QCborValue::Array:
+        writer.startArray();
+        writeContents(writer, child, false);
+        writer.endArray();
+        break;
+    case QCborValue::Map:
+        writer.startObject();
+        writeContents(writer, child, true);
+        writer.endObject();
+        break;
+    default:
+        writer.writeNull();
+        break;
+    }
+}
+
+static void writeContents(QJsonStreamWriter &writer, const QCborContainerPrivate *c, bool isObject)
+{
+    if (!c)
+        return;
+    for (qsizetype i = 0; i < c->elements.size(); ++i) {
+        if (isObject)
+            writer.writeName(stringViewAt(c, i++));
+        writeElement(writer, c, i);
+    }
+}
+
+/*!
+    Writes \a value, including all elements or members if it is an array or
+    an object. The output is the same as QJsonDocument::toJson() produces for
+    the value. An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    // shares the array or object instead of copying it
+    const QCborValue cbor = QCborValue::fromJsonValue(value);
+    switch (cbor.type()) {
+    case QCborValue::Integer:
+        writeInteger(cbor.toInteger());
+        break;
+    case QCborValue::Double:
+        writeDouble(cbor.toDouble());
+        break;
+    case QCborValue::True:
+    case QCborValue::False:
+        writeBool(cbor.toBool());
+        break;
+    case QCborValue::String:
+        writeString(value.toString());
+        break;
+    case QCborValue::Array:
+        startArray();
+        writeContents(*this, QJsonPrivate::Value::container(cbor), false);
+        endArray();
+        break;
+    case QCborValue::Map:
+        startObject();
+        writeContents(*this, QJsonPrivate::Value::container(cbor), true);
+        endObject();
+        break;
+    default:
+        writeNull();
+        break;
+    }
+}
+
+/*!
+    Returns the number of containers that are currently open.
+*/
+int QJsonStreamWriter::depth() const
+{
+    Q_D(const QJsonStreamWriter);
+    return int(d->containers.size());
+}
+
+/*!
+    Passes the buffered output on to the device. This doesn't flush the
+    device itself.
+*/
+void QJsonStreamWriter::flush()
+{
+    Q_D(QJsonStreamWriter);
+    d->flush();
+}
+
+/*!
+    Returns true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->hasError;
+}
+
+QT_END_NAMESPACE
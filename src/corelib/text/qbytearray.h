@@ -19,6 +19,7 @@
 
 #include <string>
 #include <iterator>
+#include <functional>
 
 #ifndef QT5_NULL_STRINGS
 // Would ideally be off, but in practice breaks too much (Qt 6.0).
@@ -826,4 +827,27 @@ inline QByteArray operator""_qba(const char *str, size_t size) noexcept
 
 QT_END_NAMESPACE
 
+namespace std {
+// Transparent, so that a std::map or std::set of QByteArray (and thus a QMap
+// or QMultiMap) can be searched with a QByteArrayView without creating a
+// temporary QByteArray. Other types are still converted to QByteArray.
+template <>
+struct less<QT_PREPEND_NAMESPACE(QByteArray)>
+{
+    using is_transparent = void;
+
+    bool operator()(const QT_PREPEND_NAMESPACE(QByteArray) &lhs,
+                    const QT_PREPEND_NAMESPACE(QByteArray) &rhs) const noexcept
+    { return lhs < rhs; }
+
+    template <typename View, std::enable_if_t<std::is_same_v<View, QT_PREPEND_NAMESPACE(QByteArrayView)>, bool> = true>
+    bool operator()(const QT_PREPEND_NAMESPACE(QByteArray) &lhs, const View &rhs) const noexcept
+    { return lhs < rhs; }
+
+    template <typename View, std::enable_if_t<std::is_same_v<View, QT_PREPEND_NAMESPACE(QByteArrayView)>, bool> = true>
+    bool operator()(const View &lhs, const QT_PREPEND_NAMESPACE(QByteArray) &rhs) const noexcept
+    { return lhs < rhs; }
+};
+} // namespace std
+
 #endif // QBYTEARRAY_H
@@ -3720,6 +3720,12 @@ QString QCalendarBackend::dateTimeToString(QStringView format, const QDateTime &
 QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
                                     int width, unsigned flags) const
 {
+    // The C locale's digits, signs and separators are the ones QString::number()
+    // uses, so unless asked to group, pad or otherwise decorate, it can skip
+    // the generic localized formatting.
+    if (this == c() && width <= 0 && (flags & ~CapitalEorX) == ZeroPadExponent)
+        return qdtoBasicLatin(d, form, precision, flags & CapitalEorX);
+
     // Although the special handling of F.P.Shortest below is limited to
     // DFSignificantDigits, the double-conversion library does treat it
     // specially for the other forms, shedding trailing zeros for DFDecimal and
@@ -42,6 +42,46 @@ using namespace QtMiscUtils;
 
 QT_CLOCALE_HOLDER
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#  define QT_HAS_FLOAT_CHARCONV
+#endif
+
+#ifdef QT_HAS_FLOAT_CHARCONV
+// Produces the same digits as double-conversion's SHORTEST mode (the shortest
+// representation that round-trips, closest to the actual value), but the
+// standard library's implementations of std::to_chars() are a lot faster.
+static bool shortestDoubleToAscii(double d, char *buf, qsizetype bufSize,
+                                  bool &sign, int &length, int &decpt)
+{
+    // "-d.dddddddddddddddde-308"
+    char scientific[1 + std::numeric_limits<double>::max_digits10 + 1 + 5];
+    const auto [end, ec] = std::to_chars(std::begin(scientific), std::end(scientific), d,
+                                         std::chars_format::scientific);
+    if (ec != std::errc{})
+        return false;
+
+    const char *p = scientific;
+    sign = *p == '-';
+    if (sign)
+        ++p;
+    int digitCount = 0;
+    for ( ; *p != 'e'; ++p) {
+        if (*p == '.')
+            continue;
+        if (digitCount == bufSize)
+            return false;
+        buf[digitCount++] = *p;
+    }
+    ++p;    // the exponent always has a sign, which std::from_chars() rejects if it's '+'
+    const bool negativeExponent = *p++ == '-';
+    int exponent = 0;
+    std::from_chars(p, end, exponent);
+    length = digitCount;
+    decpt = (negativeExponent ? -exponent : exponent) + 1;
+    return true;
+}
+#endif
+
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
                       char *buf, qsizetype bufSize,
                       bool &sign, int &length, int &decpt)
@@ -84,6 +124,15 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#ifdef QT_HAS_FLOAT_CHARCONV
+    // The digits are the same for all forms in this mode; only the caller's
+    // layout of them differs.
+    if (precision == QLocale::FloatingPointShortest
+            && shortestDoubleToAscii(d, buf, bufSize, sign, length, decpt)) {
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -294,6 +343,19 @@ QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
 
     double d = 0.0;
     int processed;
+#ifdef QT_HAS_FLOAT_CHARCONV
+    // Fast path for the common case of a plain number, with nothing around it
+    // and within range. Everything else goes through the full parser below,
+    // which knows how to report it. Unlike std::from_chars(), we accept '+'.
+    const char *const stop = num + numLen;
+    const char *start = (*num == '+' && numLen > 1 && num[1] != '-') ? num + 1 : num;
+    if (*start != '+') {
+        const auto [ptr, ec] = std::from_chars(start, stop, d, std::chars_format::general);
+        if (ec == std::errc{} && ptr == stop)
+            return { d, numLen };
+        d = 0.0;
+    }
+#endif
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
@@ -0,0 +1,639 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qspan.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+inline QByteArrayView unitsOf(const QByteArray &needle)
+{
+    return needle;
+}
+
+inline QSpan<const char16_t> unitsOf(const QString &needle)
+{
+    const QStringView view(needle);
+    return QSpan(view.utf16(), view.size());
+}
+
+/*
+    An Aho-Corasick automaton over the code units of Char.
+
+    The code units that occur in the needles are mapped to equivalence
+    classes 1..classCount-1; every other code unit maps to class 0. The
+    automaton is stored as a dense table of stateCount * classCount
+    transitions with the failure links already folded in, so that scanning
+    costs a single table lookup per code unit of the haystack.
+*/
+template <typename Char>
+class MultiMatcherAutomaton
+{
+public:
+    using Unit = std::make_unsigned_t<Char>;
+
+    template <typename String, typename Fold>
+    void build(const QList<String> &needles, Fold fold);
+
+    // calls report(position, length, needleIndex) for every match, ordered by
+    // end position and, for matches ending at the same position, by
+    // decreasing length; report returns false to stop the scan
+    template <typename Fold, typename Report>
+    void scan(const Char *data, qsizetype size, Fold fold, Report report) const;
+
+    qsizetype maxNeedleLength() const { return maxLength; }
+
+private:
+    qint32 classOf(Unit c) const
+    {
+        if (c < 256)
+            return latin1Classes[c];
+        return otherClasses.value(c, 0);
+    }
+
+    qint32 latin1Classes[256] = {};
+    QHash<Unit, qint32> otherClasses;
+    qint32 classCount = 1;
+    QList<qint32> transitions;      // stateCount * classCount
+    QList<qsizetype> terminal;      // per state: index of the needle ending there, or -1
+    QList<qint32> outputLinks;      // per state: next terminal state on the failure chain, or 0
+    QList<qsizetype> needleLengths;
+    qsizetype maxLength = 0;
+};
+
+template <typename Char>
+template <typename String, typename Fold>
+void MultiMatcherAutomaton<Char>::build(const QList<String> &needles, Fold fold)
+{
+    for (const String &needle : needles) {
+        for (Char ch : unitsOf(needle)) {
+            const Unit c = fold(Unit(ch));
+            if (classOf(c) != 0)
+                continue;
+            if (c < 256)
+                latin1Classes[c] = classCount++;
+            else
+                otherClasses.insert(c, classCount++);
+        }
+    }
+
+    // the trie; -1 marks a missing transition
+    const qint32 k = classCount;
+    transitions.resize(k, -1);
+    terminal.append(-1);
+    needleLengths.reserve(needles.size());
+    for (qsizetype n = 0; n < needles.size(); ++n) {
+        const String &needle = needles.at(n);
+        needleLengths.append(needle.size());
+        maxLength = qMax(maxLength, needle.size());
+        if (needle.isEmpty())
+            continue;
+        qint32 state = 0;
+        for (Char ch : unitsOf(needle)) {
+            const qsizetype i = state * k + classOf(fold(Unit(ch)));
+            if (transitions.at(i) < 0) {
+                transitions[i] = qint32(terminal.size());
+                transitions.resize(transitions.size() + k, -1);
+                terminal.append(-1);
+            }
+            state = transitions.at(i);
+        }
+        // for duplicate needles, report the first one
+        if (terminal.at(state) < 0)
+            terminal[state] = n;
+    }
+
+    // breadth-first over the trie, replacing the missing transitions with
+    // those of the failure state; states at a lower depth are complete by
+    // the time a state refers to them
+    const qsizetype stateCount = terminal.size();
+    QList<qint32> failure(stateCount, 0);
+    outputLinks.resize(stateCount, 0);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    for (qint32 c = 0; c < k; ++c) {
+        const qint32 next = transitions.at(c);
+        if (next < 0)
+            transitions[c] = 0;
+        else
+            queue.append(next);
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qint32 state = queue.at(head);
+        const qint32 fail = failure.at(state);
+        outputLinks[state] = terminal.at(fail) >= 0 ? fail : outputLinks.at(fail);
+        for (qint32 c = 0; c < k; ++c) {
+            const qint32 next = transitions.at(state * k + c);
+            const qint32 fallback = transitions.at(fail * k + c);
+            if (next < 0) {
+                transitions[state * k + c] = fallback;
+            } else {
+                failure[next] = fallback;
+                queue.append(next);
+            }
+        }
+    }
+}
+
+template <typename Char>
+template <typename Fold, typename Report>
+void MultiMatcherAutomaton<Char>::scan(const Char *data, qsizetype size, Fold fold,
+                                       Report report) const
+{
+    if (terminal.size() <= 1)
+        return;
+    const qint32 k = classCount;
+    const qint32 *table = transitions.constData();
+    const qsizetype *terminals = terminal.constData();
+    const qint32 *links = outputLinks.constData();
+    qint32 state = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        state = table[state * k + classOf(fold(Unit(data[i])))];
+        qint32 out = terminals[state] >= 0 ? state : links[state];
+        for (; out != 0; out = links[out]) {
+            const qsizetype needle = terminals[out];
+            const qsizetype length = needleLengths.at(needle);
+            if (!report(i + 1 - length, length, needle))
+                return;
+        }
+    }
+}
+
+struct NoFold
+{
+    template <typename Unit>
+    Unit operator()(Unit c) const noexcept { return c; }
+};
+
+struct FoldCase
+{
+    char16_t operator()(char16_t c) const noexcept
+    {
+        if (c < 0x80)
+            return c >= u'A' && c <= u'Z' ? c | 0x20 : c;
+        return QChar(c).toCaseFolded().unicode();
+    }
+};
+
+template <typename Match, typename Char, typename Automaton, typename Fold>
+Match firstMatch(const Automaton &automaton, const Char *data, qsizetype size, qsizetype from,
+                 Fold fold)
+{
+    Match result;
+    if (from < 0)
+        from = qMax(from + size, qsizetype(0));
+    if (from >= size)
+        return result;
+    automaton.scan(data + from, size - from, fold,
+                   [&](qsizetype position, qsizetype length, qsizetype needle) {
+        result = Match{position + from, length, needle};
+        return false;
+    });
+    if (!result.isValid())
+        return result;
+
+    // The match that ends first need not start first: a longer needle may
+    // start earlier and end later, like "abcd" around "bc". Any such match
+    // starts after end - maxNeedleLength() and ends before the first match's
+    // position + maxNeedleLength(), so rescanning that window finds it.
+    const qsizetype end = result.position + result.length;
+    const qsizetype windowBegin = qMax(from, end - automaton.maxNeedleLength());
+    const qsizetype windowEnd = qMin(size, result.position + automaton.maxNeedleLength());
+    automaton.scan(data + windowBegin, windowEnd - windowBegin, fold,
+                   [&](qsizetype position, qsizetype length, qsizetype needle) {
+        position += windowBegin;
+        if (position < result.position
+            || (position == result.position && length > result.length)) {
+            result = Match{position, length, needle};
+        }
+        return true;
+    });
+    return result;
+}
+
+template <typename Match, typename Char, typename Automaton, typename Fold>
+QList<Match> allMatches(const Automaton &automaton, const Char *data, qsizetype size,
+                        qsizetype from, Fold fold)
+{
+    QList<Match> result;
+    if (from < 0)
+        from = qMax(from + size, qsizetype(0));
+    if (from >= size)
+        return result;
+    automaton.scan(data + from, size - from, fold,
+                   [&](qsizetype position, qsizetype length, qsizetype needle) {
+        result.append(Match{position + from, length, needle});
+        return true;
+    });
+    return result;
+}
+
+} // unnamed namespace
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    QList<QByteArray> needles;
+    MultiMatcherAutomaton<char> automaton;
+};
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QStringList needles;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    MultiMatcherAutomaton<char16_t> automaton;
+
+    void build()
+    {
+        if (cs == Qt::CaseSensitive)
+            automaton.build(needles, NoFold());
+        else
+            automaton.build(needles, FoldCase());
+    }
+};
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiByteArrayMatcherPrivate)
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.8
+    \brief The QMultiByteArrayMatcher class finds any of a set of byte
+    arrays in a byte array.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Searching a large buffer for each of several needles with
+    QByteArrayMatcher takes one pass over the buffer per needle.
+    QMultiByteArrayMatcher compiles the needles into an automaton once and
+    then finds the occurrences of all of them in a single pass, whose cost
+    doesn't depend on the number of needles. This makes it suitable for
+    scanning logs or protocol data for a list of keywords, or for
+    tokenizers that need to recognize a fixed set of terminals.
+
+    \code
+    const QMultiByteArrayMatcher matcher({"ERROR", "WARN", "FATAL"});
+    for (const QMultiByteArrayMatcher::Match &m : matcher.matches(log))
+        qDebug() << m.position << matcher.needles().at(m.needleIndex);
+    \endcode
+
+    Matches may overlap, and a needle that is contained in another needle is
+    reported at every position where it occurs. Empty needles never match.
+
+    The memory used by the automaton grows with the total length of the
+    needles multiplied by the number of distinct bytes in them. The class is
+    designed for tens to a few hundred needles.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \since 6.8
+    \brief The Match struct describes an occurrence of a needle.
+
+    \sa QMultiByteArrayMatcher::indexIn(), QMultiByteArrayMatcher::matches()
+*/
+
+/*!
+    \variable QMultiByteArrayMatcher::Match::position
+
+    The index of the first byte of the occurrence, or -1 if this Match is
+    not valid.
+*/
+
+/*!
+    \variable QMultiByteArrayMatcher::Match::length
+
+    The length of the occurrence.
+*/
+
+/*!
+    \variable QMultiByteArrayMatcher::Match::needleIndex
+
+    The index in QMultiByteArrayMatcher::needles() of the needle that was
+    found, or -1 if this Match is not valid.
+*/
+
+/*!
+    \fn bool QMultiByteArrayMatcher::Match::isValid() const
+
+    Returns \c true if this Match describes an occurrence; otherwise returns
+    \c false.
+*/
+
+/*!
+    Constructs a matcher without needles. It doesn't match anything.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : QMultiByteArrayMatcher(QList<QByteArray>())
+{
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a needles.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &needles)
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->needles = needles;
+    d->automaton.build(d->needles, NoFold());
+}
+
+/*!
+    Constructs a copy of \a other. The automaton is shared, not copied.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    Assigns \a other to this matcher, and returns a reference to this
+    matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other)
+    = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+    \memberswap{matcher}
+*/
+
+/*!
+    Sets the byte arrays this matcher searches for to \a needles, and
+    rebuilds the automaton.
+
+    \sa needles()
+*/
+void QMultiByteArrayMatcher::setNeedles(const QList<QByteArray> &needles)
+{
+    *this = QMultiByteArrayMatcher(needles);
+}
+
+/*!
+    Returns the byte arrays this matcher searches for.
+
+    \sa setNeedles()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::needles() const
+{
+    return d->needles;
+}
+
+/*!
+    Searches \a data, starting at index position \a from, and returns the
+    first occurrence of any of the needles. If no needle occurs, returns an
+    invalid Match.
+
+    The first occurrence is the one that starts first. If several needles
+    start at that position, the longest one is returned.
+
+    A negative \a from counts from the end of \a data.
+
+    \sa matches()
+*/
+QMultiByteArrayMatcher::Match QMultiByteArrayMatcher::indexIn(QByteArrayView data,
+                                                              qsizetype from) const
+{
+    return firstMatch<Match>(d->automaton, data.data(), data.size(), from, NoFold());
+}
+
+/*!
+    Searches \a data, starting at index position \a from, and returns all
+    occurrences of the needles, including overlapping ones. The matches are
+    ordered by their end position; matches that end at the same position are
+    ordered by decreasing length.
+
+    A negative \a from counts from the end of \a data.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matches(QByteArrayView data,
+                                                                     qsizetype from) const
+{
+    return allMatches<Match>(d->automaton, data.data(), data.size(), from, NoFold());
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.8
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    string.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    QMultiStringMatcher is the UTF-16 counterpart of QMultiByteArrayMatcher:
+    it compiles a list of needles into an automaton once, and then finds the
+    occurrences of all of them in a single pass over the searched string.
+
+    \code
+    const QMultiStringMatcher matcher({u"class"_s, u"struct"_s, u"union"_s});
+    if (matcher.indexIn(line).isValid())
+        ...
+    \endcode
+
+    With Qt::CaseInsensitive, both the needles and the searched string are
+    compared after folding the case of each UTF-16 code unit with
+    QChar::toCaseFolded(). Case foldings that change the length of the
+    string, such as the German sharp s folding to "ss", are not applied.
+
+    \sa QMultiByteArrayMatcher, QStringMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.8
+    \brief The Match struct describes an occurrence of a needle.
+
+    \sa QMultiStringMatcher::indexIn(), QMultiStringMatcher::matches()
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::position
+
+    The index of the first character of the occurrence, or -1 if this Match
+    is not valid.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::length
+
+    The length of the occurrence, in UTF-16 code units.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::needleIndex
+
+    The index in QMultiStringMatcher::needles() of the needle that was
+    found, or -1 if this Match is not valid.
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::isValid() const
+
+    Returns \c true if this Match describes an occurrence; otherwise returns
+    \c false.
+*/
+
+/*!
+    Constructs a matcher without needles. It doesn't match anything.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : QMultiStringMatcher(QStringList())
+{
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a needles, with
+    case sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &needles, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->needles = needles;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Constructs a copy of \a other. The automaton is shared, not copied.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    Assigns \a other to this matcher, and returns a reference to this
+    matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+    \memberswap{matcher}
+*/
+
+/*!
+    Sets the strings this matcher searches for to \a needles, and rebuilds
+    the automaton.
+
+    \sa needles(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setNeedles(const QStringList &needles)
+{
+    *this = QMultiStringMatcher(needles, d->cs);
+}
+
+/*!
+    Returns the strings this matcher searches for.
+
+    \sa setNeedles()
+*/
+QStringList QMultiStringMatcher::needles() const
+{
+    return d->needles;
+}
+
+/*!
+    Sets the case sensitivity of the search to \a cs, and rebuilds the
+    automaton if it changes.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        *this = QMultiStringMatcher(d->needles, cs);
+}
+
+/*!
+    Returns the case sensitivity of the search.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches \a str, starting at index position \a from, and returns the
+    first occurrence of any of the needles. If no needle occurs, returns an
+    invalid Match.
+
+    The first occurrence is the one that starts first. If several needles
+    start at that position, the longest one is returned.
+
+    A negative \a from counts from the end of \a str.
+
+    \sa matches()
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QStringView str, qsizetype from) const
+{
+    if (d->cs == Qt::CaseSensitive)
+        return firstMatch<Match>(d->automaton, str.utf16(), str.size(), from, NoFold());
+    return firstMatch<Match>(d->automaton, str.utf16(), str.size(), from, FoldCase());
+}
+
+/*!
+    Searches \a str, starting at index position \a from, and returns all
+    occurrences of the needles, including overlapping ones. The matches are
+    ordered by their end position; matches that end at the same position are
+    ordered by decreasing length.
+
+    A negative \a from counts from the end of \a str.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView str,
+                                                               qsizetype from) const
+{
+    if (d->cs == Qt::CaseSensitive)
+        return allMatches<Match>(d->automaton, str.utf16(), str.size(), from, NoFold());
+    return allMatches<Match>(d->automaton, str.utf16(), str.size(), from, FoldCase());
+}
+
+QT_END_NAMESPACE
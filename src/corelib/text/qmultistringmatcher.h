@@ -0,0 +1,97 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTISTRINGMATCHER_H
+#define QMULTISTRINGMATCHER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiByteArrayMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiByteArrayMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype needleIndex = -1;
+
+        constexpr bool isValid() const noexcept { return needleIndex >= 0; }
+    };
+
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &needles);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other) noexcept = default;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiByteArrayMatcher)
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+    ~QMultiByteArrayMatcher();
+
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    void setNeedles(const QList<QByteArray> &needles);
+    QList<QByteArray> needles() const;
+
+    Match indexIn(QByteArrayView data, qsizetype from = 0) const;
+    QList<Match> matches(QByteArrayView data, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
+class QMultiStringMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiStringMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype needleIndex = -1;
+
+        constexpr bool isValid() const noexcept { return needleIndex >= 0; }
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QStringList &needles,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other);
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiStringMatcher)
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other);
+    ~QMultiStringMatcher();
+
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    void setNeedles(const QStringList &needles);
+    QStringList needles() const;
+
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const;
+
+    Match indexIn(QStringView str, qsizetype from = 0) const;
+    QList<Match> matches(QStringView str, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+
+QT_END_NAMESPACE
+
+#endif // QMULTISTRINGMATCHER_H
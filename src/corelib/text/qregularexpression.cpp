@@ -5,11 +5,14 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qatomic.h>
@@ -23,6 +26,8 @@
 
 #include <pcre2.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -704,6 +709,22 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A compiled (and possibly JIT-compiled) pattern. PCRE2 allows several
+    threads to match using the same compiled pattern concurrently, as long as
+    nobody modifies it; we never do after having JIT-compiled it. Therefore,
+    one compiled pattern can be shared by all QRegularExpressionPrivate
+    objects having the same pattern and options.
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    explicit QRegularExpressionCompiledPattern(pcre2_code_16 *code) : code(code) {}
+    ~QRegularExpressionCompiledPattern() { pcre2_code_free_16(code); }
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledPattern)
+
+    pcre2_code_16 * const code;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -736,9 +757,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The compiled pattern is shared with the other QRegularExpressionPrivate
+    // objects having the same pattern and options, through the cache of
+    // compiled patterns; compiledPattern is sharedPattern->code. When the
+    // private is copied (i.e. a detach happened) both are reset.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> sharedPattern;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -872,7 +895,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    sharedPattern.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -880,6 +903,60 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     usingCrLfNewlines = false;
 }
 
+namespace {
+/*
+    Process-wide cache of the most recently compiled patterns, so that
+    applications creating QRegularExpression objects for the same patterns
+    over and over (for instance, from configuration or user input) don't pay
+    for compiling them each time. The cost of an entry is the memory used by
+    the compiled pattern, including the JIT-compiled code. Only valid patterns
+    are cached.
+*/
+struct CompiledPatternCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions options;
+
+    friend bool operator==(const CompiledPatternCacheKey &lhs,
+                           const CompiledPatternCacheKey &rhs) noexcept
+    {
+        return lhs.options == rhs.options && lhs.pattern == rhs.pattern;
+    }
+    friend size_t qHash(const CompiledPatternCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.pattern, key.options);
+    }
+};
+
+struct CompiledPatternCache
+{
+    using Entry = QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern>;
+    static constexpr qsizetype MaxCost = 4 * 1024 * 1024;
+
+    Entry find(const CompiledPatternCacheKey &key)
+    {
+        const QMutexLocker locker(&mutex);
+        const Entry *entry = cache.object(key);
+        return entry ? *entry : Entry();
+    }
+
+    void insert(const CompiledPatternCacheKey &key, const Entry &entry)
+    {
+        size_t size = 0;
+        pcre2_pattern_info_16(entry->code, PCRE2_INFO_SIZE, &size);
+        size_t jitSize = 0;
+        pcre2_pattern_info_16(entry->code, PCRE2_INFO_JITSIZE, &jitSize);
+
+        const QMutexLocker locker(&mutex);
+        cache.insert(key, new Entry(entry), qsizetype(size + jitSize));
+    }
+
+    QMutex mutex;
+    QCache<CompiledPatternCacheKey, Entry> cache{MaxCost};
+};
+Q_GLOBAL_STATIC(CompiledPatternCache, compiledPatternCache)
+} // unnamed namespace
+
 /*!
     \internal
 */
@@ -893,6 +970,17 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
+    CompiledPatternCache *cache = compiledPatternCache();
+    const CompiledPatternCacheKey cacheKey = { pattern, patternOptions };
+    if (cache) {
+        sharedPattern = cache->find(cacheKey);
+        if (sharedPattern) {
+            compiledPattern = sharedPattern->code;
+            getPatternInfo();
+            return;
+        }
+    }
+
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
@@ -913,6 +1001,9 @@ void QRegularExpressionPrivate::compilePattern()
     }
 
     optimizePattern();
+    sharedPattern = new QRegularExpressionCompiledPattern(compiledPattern);
+    if (cache)
+        cache->insert(cacheKey, sharedPattern);
     getPatternInfo();
 }
 
@@ -2743,6 +2834,479 @@ QtPrivate::QRegularExpressionMatchIteratorRangeBasedForIterator begin(const QReg
   \internal
 */
 
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSet class matches a string against many
+    regular expressions at once.
+
+    \since 6.8
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    A QRegularExpressionSet holds a list of QRegularExpression objects, and
+    answers the question "which of them match this string?", as needed by log
+    filters, routing tables and similar applications:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
+    Rather than running every regular expression in turn, the set combines as
+    many of them as possible into a single alternation, which is matched in
+    one pass over the subject. matchesAny() stops at the first match;
+    matchingIndexes() collects every combined regular expression that matches
+    in the same pass, skipping the ones it has found already. Regular
+    expressions that cannot be
+    combined without changing their meaning, for instance because they use
+    backreferences, recursion, backtracking control verbs or the
+    QRegularExpression::UseUnicodePropertiesOption, are matched separately.
+    The result is the same either way.
+
+    Invalid regular expressions are kept in the set, but never match.
+
+    \sa QRegularExpression
+*/
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    QRegularExpressionSetPrivate() = default;
+    QRegularExpressionSetPrivate(const QRegularExpressionSetPrivate &other)
+        : QSharedData(other), expressions(other.expressions)
+    {
+    }
+    ~QRegularExpressionSetPrivate() { pcre2_code_free_16(scanCode); }
+
+    void invalidate() { prepared.storeRelaxed(false); }
+    void prepare() const;
+    bool matchesSeparately(qsizetype i, QStringView subject,
+                           QRegularExpression::MatchOptions matchOptions) const
+    {
+        return expressions.at(i).matchView(subject, 0, QRegularExpression::NormalMatch,
+                                           matchOptions).hasMatch();
+    }
+
+    QList<QRegularExpression> expressions;
+
+    // Built by prepare() on first use, under mutex. combinedGroups holds, for
+    // each expression, the capturing group enclosing it in the combined
+    // regular expression, or -1 if it isn't part of it; separate holds the
+    // indexes of the valid expressions that have to be matched on their own.
+    // scanCode is the alternation of the expressions in scanned, with callouts
+    // reporting every one that matches (see scanCallout()).
+    mutable QMutex mutex;
+    mutable QAtomicInteger<bool> prepared = false;
+    mutable bool hasCombined = false;
+    mutable QRegularExpression combined;
+    mutable QList<int> combinedGroups;
+    mutable QList<qsizetype> separate;
+    mutable pcre2_code_16 *scanCode = nullptr;
+    mutable QList<qsizetype> scanned;
+};
+
+namespace {
+struct SetScanState
+{
+    QVarLengthArray<bool, 64> found;
+    qsizetype remaining;
+};
+}
+
+/*
+    Callout of the scan pattern built by QRegularExpressionSetPrivate::prepare().
+    Every alternative k of the scan pattern reads (?C{bk})(?>...)(?C{ak}): the
+    first callout skips alternatives that have matched already, the second
+    one records a match and then makes it fail, so that PCRE2 goes on with the
+    other alternatives and start positions. Once all have matched, the scan
+    is aborted.
+*/
+static int scanCallout(pcre2_callout_block_16 *block, void *data)
+{
+    auto *state = static_cast<SetScanState *>(data);
+    const char16_t *string = reinterpret_cast<const char16_t *>(block->callout_string);
+    qsizetype k = 0;
+    for (PCRE2_SIZE i = 1; i < block->callout_string_length; ++i)
+        k = k * 10 + (string[i] - u'0');
+
+    if (string[0] == u'b')
+        return state->found[k] ? 1 : 0;
+    if (!state->found[k]) {
+        state->found[k] = true;
+        if (--state->remaining == 0)
+            return PCRE2_ERROR_CALLOUT;
+    }
+    return 1;
+}
+
+/*
+    Returns true if \a pattern can be made an alternative of a larger regular
+    expression without changing its meaning. That's not the case if it refers
+    to capturing groups by number, recurses, uses backtracking control verbs
+    (which affect the other alternatives too), or quotes up to its end. This
+    errs on the side of caution: false negatives merely cost performance.
+*/
+static bool canBeCombined(const QRegularExpression &re)
+{
+    if (re.patternOptions() & QRegularExpression::UseUnicodePropertiesOption)
+        return false;
+
+    const QString pattern = re.pattern();
+    for (qsizetype i = 0; i + 1 < pattern.size(); ++i) {
+        const char16_t c = pattern.at(i).unicode();
+        const char16_t next = pattern.at(i + 1).unicode();
+        if (c == u'\\') {
+            // backreferences (\1, \g{1}, \k<name>) and quoting (\Q...\E)
+            if ((next >= u'1' && next <= u'9') || next == u'g' || next == u'k' || next == u'Q')
+                return false;
+            ++i;
+        } else if (c == u'(') {
+            if (next == u'*')       // (*VERB)
+                return false;
+            if (next != u'?' || i + 2 == pattern.size())
+                continue;
+            // recursion and subroutine calls: (?R), (?1), (?-1), (?+1), (?&name),
+            // (?P>name), (?P=name); conditionals on groups: (?(1)...); callouts
+            const char16_t kind = pattern.at(i + 2).unicode();
+            if (kind == u'R' || kind == u'&' || kind == u'(' || kind == u'-' || kind == u'+'
+                    || kind == u'C' || (kind >= u'0' && kind <= u'9')) {
+                return false;
+            }
+            if (kind == u'P' && i + 3 < pattern.size()
+                    && (pattern.at(i + 3) == u'>' || pattern.at(i + 3) == u'=')) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void QRegularExpressionSetPrivate::prepare() const
+{
+    if (prepared.loadAcquire())
+        return;
+
+    const QMutexLocker lock(&mutex);
+    if (prepared.loadRelaxed())
+        return;
+
+    combinedGroups.fill(-1, expressions.size());
+    separate.clear();
+    pcre2_code_free_16(std::exchange(scanCode, nullptr));
+    scanned.clear();
+
+    QString pattern;
+    QString scanPattern;
+    QSet<QString> groupNames;
+    int groupCount = 0;
+    for (qsizetype i = 0; i < expressions.size(); ++i) {
+        const QRegularExpression &re = expressions.at(i);
+        if (!re.isValid())
+            continue;
+
+        // names must remain unique in the combined regular expression
+        const QStringList names = re.namedCaptureGroups();
+        bool combinable = canBeCombined(re);
+        for (const QString &name : names) {
+            if (combinable && !name.isEmpty() && groupNames.contains(name))
+                combinable = false;
+        }
+        if (!combinable) {
+            separate.append(i);
+            continue;
+        }
+        for (const QString &name : names) {
+            if (!name.isEmpty())
+                groupNames.insert(name);
+        }
+
+        // turn the pattern options into inline options, scoped to the group
+        const QRegularExpression::PatternOptions options = re.patternOptions();
+        QString flags;
+        if (options & QRegularExpression::CaseInsensitiveOption)
+            flags += u'i';
+        if (options & QRegularExpression::DotMatchesEverythingOption)
+            flags += u's';
+        if (options & QRegularExpression::MultilineOption)
+            flags += u'm';
+        if (options & QRegularExpression::ExtendedPatternSyntaxOption)
+            flags += u'x';
+        if (options & QRegularExpression::InvertedGreedinessOption)
+            flags += u'U';
+        if (options & QRegularExpression::DontCaptureOption)
+            flags += u'n';
+
+        QString alternative;
+        if (!flags.isEmpty())
+            alternative += "(?"_L1 + flags + u')';
+        alternative += re.pattern();
+        // a comment in extended syntax ends at the end of the line
+        if (options & QRegularExpression::ExtendedPatternSyntaxOption)
+            alternative += u'\n';
+
+        if (!pattern.isEmpty()) {
+            pattern += u'|';
+            scanPattern += u'|';
+        }
+        pattern += u'(' + alternative + u')';
+        // one match per start position is enough to know that it matches
+        const QString k = QString::number(scanned.size());
+        scanPattern += "(?C{b"_L1 + k + "})(?>"_L1 + alternative + ")(?C{a"_L1 + k + "})"_L1;
+        scanned.append(i);
+
+        combinedGroups[i] = ++groupCount;
+        groupCount += re.captureCount();
+    }
+
+    combined = QRegularExpression(pattern);
+    if (groupCount > 0 && !combined.isValid()) {
+        // we missed something; be correct rather than fast
+        for (qsizetype i = 0; i < expressions.size(); ++i) {
+            if (combinedGroups.at(i) > 0)
+                separate.append(i);
+        }
+        std::sort(separate.begin(), separate.end());
+        combinedGroups.fill(-1);
+        groupCount = 0;
+    }
+    hasCombined = groupCount > 0;
+    if (hasCombined) {
+        combined.optimize();
+
+        int errorCode;
+        PCRE2_SIZE errorOffset;
+        scanCode = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(scanPattern.constData()),
+                                    scanPattern.size(), PCRE2_UTF, &errorCode, &errorOffset,
+                                    nullptr);
+        static const bool enableJit = isJitEnabled();
+        if (scanCode && enableJit)
+            pcre2_jit_compile_16(scanCode, PCRE2_JIT_COMPLETE);
+    } else {
+        combined = QRegularExpression();
+        scanned.clear();
+    }
+
+    prepared.storeRelease(true);
+}
+
+/*!
+    Constructs an empty set of regular expressions.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a set containing the regular expressions in \a expressions.
+    Their indexes in the set are their indexes in the list.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QList<QRegularExpression> &expressions)
+    : QRegularExpressionSet()
+{
+    d->expressions = expressions;
+}
+
+/*!
+    Destroys the set.
+*/
+QRegularExpressionSet::~QRegularExpressionSet()
+{
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetPrivate)
+
+/*!
+    Constructs a set as a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other)
+    : d(other.d)
+{
+}
+
+/*!
+    \fn QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other)
+
+    Constructs a set by moving from \a other.
+
+    Note that a moved-from QRegularExpressionSet can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor or
+    one of the assignment operators is undefined.
+*/
+
+/*!
+    Assigns \a other to this set, and returns a reference to this set.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this set, and returns a reference to this set.
+
+    Note that a moved-from QRegularExpressionSet can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor or
+    one of the assignment operators is undefined.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps this set with \a other. This operation is very fast and never fails.
+*/
+
+/*!
+    Returns the regular expressions in this set.
+
+    \sa setExpressions(), append()
+*/
+QList<QRegularExpression> QRegularExpressionSet::expressions() const
+{
+    return d->expressions;
+}
+
+/*!
+    Replaces the regular expressions in this set with \a expressions.
+
+    \sa expressions(), append()
+*/
+void QRegularExpressionSet::setExpressions(const QList<QRegularExpression> &expressions)
+{
+    d.detach();
+    d->invalidate();
+    d->expressions = expressions;
+}
+
+/*!
+    Appends \a expression to this set and returns its index.
+
+    \sa setExpressions()
+*/
+qsizetype QRegularExpressionSet::append(const QRegularExpression &expression)
+{
+    d.detach();
+    d->invalidate();
+    d->expressions.append(expression);
+    return d->expressions.size() - 1;
+}
+
+/*!
+    Removes all the regular expressions from this set.
+*/
+void QRegularExpressionSet::clear()
+{
+    d.detach();
+    d->invalidate();
+    d->expressions.clear();
+}
+
+/*!
+    Returns the number of regular expressions in this set.
+*/
+qsizetype QRegularExpressionSet::size() const
+{
+    return d->expressions.size();
+}
+
+/*!
+    \fn bool QRegularExpressionSet::isEmpty() const
+
+    Returns \c true if this set contains no regular expressions.
+*/
+
+/*!
+    Returns \c true if all the regular expressions in this set are valid.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return std::all_of(d->expressions.cbegin(), d->expressions.cend(),
+                       [](const QRegularExpression &re) { return re.isValid(); });
+}
+
+/*!
+    Returns \c true if any of the regular expressions in this set matches
+    somewhere in \a subject, using the match options \a matchOptions.
+
+    \sa matchingIndexes()
+*/
+bool QRegularExpressionSet::matchesAny(QStringView subject,
+                                       QRegularExpression::MatchOptions matchOptions) const
+{
+    d->prepare();
+    if (d->hasCombined
+            && d->combined.matchView(subject, 0, QRegularExpression::NormalMatch,
+                                     matchOptions).hasMatch()) {
+        return true;
+    }
+    return std::any_of(d->separate.cbegin(), d->separate.cend(), [&](qsizetype i) {
+        return d->matchesSeparately(i, subject, matchOptions);
+    });
+}
+
+/*!
+    Returns the indexes, in increasing order, of the regular expressions in
+    this set that match somewhere in \a subject, using the match options \a
+    matchOptions.
+
+    \sa matchesAny()
+*/
+QList<qsizetype> QRegularExpressionSet::matchingIndexes(QStringView subject,
+                                                        QRegularExpression::MatchOptions matchOptions) const
+{
+    d->prepare();
+
+    // the combined expressions that match, found in one scan of the subject
+    QVarLengthArray<bool, 64> combinedMatches(d->expressions.size(), false);
+    int scanResult = PCRE2_ERROR_NOMEMORY;
+    if (d->scanCode) {
+        SetScanState state;
+        state.found.resize(d->scanned.size(), false);
+        state.remaining = d->scanned.size();
+
+        pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
+        pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
+        pcre2_set_callout_16(matchContext, &scanCallout, &state);
+        pcre2_match_data_16 *matchData = pcre2_match_data_create_16(1, nullptr);
+        // see QRegularExpressionPrivate::doMatch()
+        const char16_t dummySubject = 0;
+        scanResult = safe_pcre2_match_16(
+                d->scanCode,
+                reinterpret_cast<PCRE2_SPTR16>(subject.utf16() ? subject.utf16() : &dummySubject),
+                subject.size(), 0, convertToPcreOptions(matchOptions), matchData, matchContext);
+        pcre2_match_data_free_16(matchData);
+        pcre2_match_context_free_16(matchContext);
+
+        for (qsizetype k = 0; k < d->scanned.size(); ++k)
+            combinedMatches[d->scanned.at(k)] = state.found.at(k);
+    }
+    if (scanResult != PCRE2_ERROR_NOMATCH && scanResult != PCRE2_ERROR_CALLOUT) {
+        // the scan failed, e.g. hitting a resource limit; be correct rather than fast
+        for (qsizetype i : std::as_const(d->scanned))
+            combinedMatches[i] = d->matchesSeparately(i, subject, matchOptions);
+    }
+
+    QList<qsizetype> result;
+    auto separate = d->separate.cbegin();
+    for (qsizetype i = 0; i < d->expressions.size(); ++i) {
+        bool matches = combinedMatches[i];
+        if (separate != d->separate.cend() && *separate == i) {
+            ++separate;
+            matches = d->matchesSeparately(i, subject, matchOptions);
+        }
+        if (matches)
+            result.append(i);
+    }
+    return result;
+}
+
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
@@ -7,6 +7,7 @@
 #define QREGULAREXPRESSION_H
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
 #include <QtCore/qshareddata.h>
@@ -397,6 +398,41 @@ private:
 
 Q_DECLARE_SHARED(QRegularExpressionMatchIterator)
 
+struct QRegularExpressionSetPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QList<QRegularExpression> &expressions);
+    ~QRegularExpressionSet();
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    QRegularExpressionSet(QRegularExpressionSet &&other) = default;
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QRegularExpressionSet)
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    QList<QRegularExpression> expressions() const;
+    void setExpressions(const QList<QRegularExpression> &expressions);
+    qsizetype append(const QRegularExpression &expression);
+    void clear();
+
+    qsizetype size() const;
+    bool isEmpty() const { return size() == 0; }
+    bool isValid() const;
+
+    [[nodiscard]] bool matchesAny(QStringView subject,
+                                  QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+    [[nodiscard]] QList<qsizetype> matchingIndexes(QStringView subject,
+                                                   QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+private:
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
 QT_END_NAMESPACE
 
 #endif // QREGULAREXPRESSION_H
@@ -0,0 +1,374 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qcompare.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qlatin1stringview.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if 0
+#pragma qt_class(QSmallString)
+#pragma qt_class(QSmallByteArray)
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+// Holds either a String, or up to InlineCapacity characters (plus a
+// terminating null) in the space the String and a tag byte would take.
+// Both members of the union start with the tag byte, so it can be read
+// through either of them (common initial sequence).
+template <typename String, typename Char>
+class QSmallStringStorage
+{
+    static constexpr quint8 HeapTag = 0xff;
+    struct Heap {
+        quint8 tag;
+        String string;
+    };
+    struct Inline {
+        quint8 size;
+        Char chars[(sizeof(Heap) - alignof(Char)) / sizeof(Char)];
+    };
+    static_assert(sizeof(Inline) == sizeof(Heap));
+    static_assert(std::is_standard_layout_v<Heap> && std::is_standard_layout_v<Inline>);
+
+    union {
+        Heap m_heap;
+        Inline m_inline;
+    };
+
+public:
+    static constexpr qsizetype InlineCapacity = sizeof(Inline::chars) / sizeof(Char) - 1;
+    static_assert(InlineCapacity < HeapTag);
+
+    QSmallStringStorage() noexcept : m_inline{} {}
+
+    // fill() writes the size characters; must fit inline
+    template <typename Fill>
+    QSmallStringStorage(qsizetype size, Fill fill) noexcept
+        : m_inline{}
+    {
+        Q_ASSERT(size >= 0 && size <= InlineCapacity);
+        m_inline.size = quint8(size);
+        fill(m_inline.chars);
+    }
+
+    explicit QSmallStringStorage(String &&string) noexcept
+        : m_heap{HeapTag, std::move(string)}
+    {}
+
+    QSmallStringStorage(const QSmallStringStorage &other) noexcept
+    {
+        if (other.isInline())
+            new (&m_inline) Inline(other.m_inline);
+        else
+            new (&m_heap) Heap(other.m_heap);
+    }
+
+    QSmallStringStorage(QSmallStringStorage &&other) noexcept
+    {
+        if (other.isInline()) {
+            new (&m_inline) Inline(other.m_inline);
+        } else {
+            new (&m_heap) Heap{HeapTag, std::move(other.m_heap.string)};
+            other.m_heap.~Heap();
+            new (&other.m_inline) Inline{};
+        }
+    }
+
+    QSmallStringStorage &operator=(const QSmallStringStorage &other) noexcept
+    {
+        if (this != &other) {
+            this->~QSmallStringStorage();
+            new (this) QSmallStringStorage(other);
+        }
+        return *this;
+    }
+
+    QSmallStringStorage &operator=(QSmallStringStorage &&other) noexcept
+    {
+        if (this != &other) {
+            this->~QSmallStringStorage();
+            new (this) QSmallStringStorage(std::move(other));
+        }
+        return *this;
+    }
+
+    ~QSmallStringStorage()
+    {
+        if (!isInline())
+            m_heap.~Heap();
+    }
+
+    void swap(QSmallStringStorage &other) noexcept
+    {
+        QSmallStringStorage tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    bool isInline() const noexcept { return m_inline.size != HeapTag; }
+    qsizetype size() const noexcept
+    { return isInline() ? qsizetype(m_inline.size) : m_heap.string.size(); }
+    const Char *data() const noexcept
+    {
+        if (isInline())
+            return m_inline.chars;
+        return reinterpret_cast<const Char *>(m_heap.string.constData());
+    }
+    const String *heapString() const noexcept { return isInline() ? nullptr : &m_heap.string; }
+};
+} // namespace QtPrivate
+
+class QSmallString
+{
+    using Storage = QtPrivate::QSmallStringStorage<QString, char16_t>;
+
+    template <typename String>
+    static Storage fromString(String &&s)
+    {
+        if (s.size() > InlineCapacity)
+            return Storage(QString(std::forward<String>(s)));
+        const auto src = reinterpret_cast<const char16_t *>(s.constData());
+        return Storage(s.size(), [&](char16_t *dst) {
+            std::memcpy(dst, src, s.size() * sizeof(char16_t));
+        });
+    }
+
+public:
+    using value_type = QChar;
+    using size_type = qsizetype;
+    using const_pointer = const QChar *;
+    using const_reference = const QChar &;
+    using const_iterator = const QChar *;
+
+    static constexpr qsizetype InlineCapacity = Storage::InlineCapacity;
+
+    QSmallString() noexcept = default;
+    QSmallString(const QString &s) : d(fromString(s)) {}
+    QSmallString(QString &&s) : d(fromString(std::move(s))) {}
+    explicit QSmallString(QStringView s)
+        : d(s.size() > InlineCapacity ? Storage(s.toString())
+                                      : Storage(s.size(), [&](char16_t *dst) {
+                                            if (!s.isEmpty())
+                                                std::memcpy(dst, s.utf16(), s.size() * sizeof(char16_t));
+                                        }))
+    {}
+    explicit QSmallString(QLatin1StringView s)
+        : d(s.size() > InlineCapacity ? Storage(QString(s))
+                                      : Storage(s.size(), [&](char16_t *dst) {
+                                            for (qsizetype i = 0; i < s.size(); ++i)
+                                                dst[i] = uchar(s.data()[i]);
+                                        }))
+    {}
+
+    void swap(QSmallString &other) noexcept { d.swap(other.d); }
+
+    [[nodiscard]] qsizetype size() const noexcept { return d.size(); }
+    [[nodiscard]] qsizetype length() const noexcept { return size(); }
+    [[nodiscard]] bool isEmpty() const noexcept { return size() == 0; }
+    [[nodiscard]] bool empty() const noexcept { return isEmpty(); }
+    [[nodiscard]] bool isInline() const noexcept { return d.isInline(); }
+
+    [[nodiscard]] const QChar *data() const noexcept
+    { return reinterpret_cast<const QChar *>(d.data()); }
+    [[nodiscard]] const QChar *constData() const noexcept { return data(); }
+    [[nodiscard]] const char16_t *utf16() const noexcept { return d.data(); }
+
+    [[nodiscard]] QChar at(qsizetype i) const { verify(i, 1); return data()[i]; }
+    [[nodiscard]] QChar operator[](qsizetype i) const { verify(i, 1); return data()[i]; }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+    [[nodiscard]] const_iterator constBegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator constEnd() const noexcept { return end(); }
+
+    [[nodiscard]] QStringView view() const noexcept { return QStringView(d.data(), d.size()); }
+    operator QStringView() const noexcept { return view(); }
+
+    [[nodiscard]] QString toString() const
+    {
+        if (const QString *s = d.heapString())
+            return *s;
+        return isEmpty() ? QString() : QString(data(), size());
+    }
+
+    void clear() noexcept { d = Storage(); }
+
+private:
+    Q_ALWAYS_INLINE void verify([[maybe_unused]] qsizetype pos = 0,
+                                [[maybe_unused]] qsizetype n = 1) const
+    {
+        Q_ASSERT(pos >= 0);
+        Q_ASSERT(pos <= size());
+        Q_ASSERT(n >= 0);
+        Q_ASSERT(n <= size() - pos);
+    }
+
+    friend bool comparesEqual(const QSmallString &lhs, const QSmallString &rhs) noexcept
+    { return comparesEqual(lhs.view(), rhs.view()); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, const QSmallString &rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs.view()); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString)
+
+    friend bool comparesEqual(const QSmallString &lhs, const QStringView &rhs) noexcept
+    { return comparesEqual(lhs.view(), rhs); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, const QStringView &rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QStringView)
+
+    friend bool comparesEqual(const QSmallString &lhs, const QString &rhs) noexcept
+    { return comparesEqual(lhs.view(), QStringView(rhs)); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, const QString &rhs) noexcept
+    { return compareThreeWay(lhs.view(), QStringView(rhs)); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QString)
+
+    friend bool comparesEqual(const QSmallString &lhs, QLatin1StringView rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::equalStrings(lhs.view(), rhs); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, QLatin1StringView rhs) noexcept
+    {
+        const int res = QtPrivate::compareStrings(lhs.view(), rhs);
+        return Qt::compareThreeWay(res, 0);
+    }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QLatin1StringView)
+
+    friend size_t qHash(const QSmallString &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+
+    Storage d;
+};
+
+Q_DECLARE_SHARED(QSmallString)
+
+class QSmallByteArray
+{
+    using Storage = QtPrivate::QSmallStringStorage<QByteArray, char>;
+
+    template <typename ByteArray>
+    static Storage fromByteArray(ByteArray &&ba)
+    {
+        if (ba.size() > InlineCapacity)
+            return Storage(QByteArray(std::forward<ByteArray>(ba)));
+        const char *src = ba.constData();
+        return Storage(ba.size(), [&](char *dst) { std::memcpy(dst, src, ba.size()); });
+    }
+
+public:
+    using value_type = char;
+    using size_type = qsizetype;
+    using const_pointer = const char *;
+    using const_reference = const char &;
+    using const_iterator = const char *;
+
+    static constexpr qsizetype InlineCapacity = Storage::InlineCapacity;
+
+    QSmallByteArray() noexcept = default;
+    QSmallByteArray(const QByteArray &ba) : d(fromByteArray(ba)) {}
+    QSmallByteArray(QByteArray &&ba) : d(fromByteArray(std::move(ba))) {}
+    explicit QSmallByteArray(QByteArrayView ba)
+        : d(ba.size() > InlineCapacity ? Storage(ba.toByteArray())
+                                       : Storage(ba.size(), [&](char *dst) {
+                                             if (!ba.isEmpty())
+                                                 std::memcpy(dst, ba.data(), ba.size());
+                                         }))
+    {}
+
+    void swap(QSmallByteArray &other) noexcept { d.swap(other.d); }
+
+    [[nodiscard]] qsizetype size() const noexcept { return d.size(); }
+    [[nodiscard]] qsizetype length() const noexcept { return size(); }
+    [[nodiscard]] bool isEmpty() const noexcept { return size() == 0; }
+    [[nodiscard]] bool empty() const noexcept { return isEmpty(); }
+    [[nodiscard]] bool isInline() const noexcept { return d.isInline(); }
+
+    [[nodiscard]] const char *data() const noexcept { return d.data(); }
+    [[nodiscard]] const char *constData() const noexcept { return data(); }
+
+    [[nodiscard]] char at(qsizetype i) const { verify(i, 1); return data()[i]; }
+    [[nodiscard]] char operator[](qsizetype i) const { verify(i, 1); return data()[i]; }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+    [[nodiscard]] const_iterator constBegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator constEnd() const noexcept { return end(); }
+
+    [[nodiscard]] QByteArrayView view() const noexcept { return QByteArrayView(d.data(), d.size()); }
+    operator QByteArrayView() const noexcept { return view(); }
+
+    [[nodiscard]] QByteArray toByteArray() const
+    {
+        if (const QByteArray *ba = d.heapString())
+            return *ba;
+        return isEmpty() ? QByteArray() : QByteArray(data(), size());
+    }
+
+    void clear() noexcept { d = Storage(); }
+
+private:
+    Q_ALWAYS_INLINE void verify([[maybe_unused]] qsizetype pos = 0,
+                                [[maybe_unused]] qsizetype n = 1) const
+    {
+        Q_ASSERT(pos >= 0);
+        Q_ASSERT(pos <= size());
+        Q_ASSERT(n >= 0);
+        Q_ASSERT(n <= size() - pos);
+    }
+
+    friend bool comparesEqual(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept
+    { return comparesEqual(lhs.view(), rhs.view()); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs.view()); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallByteArray)
+
+    friend bool comparesEqual(const QSmallByteArray &lhs, const QByteArrayView &rhs) noexcept
+    { return comparesEqual(lhs.view(), rhs); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallByteArray &lhs, const QByteArrayView &rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallByteArray, QByteArrayView)
+
+    friend bool comparesEqual(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept
+    { return comparesEqual(lhs.view(), QByteArrayView(rhs)); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept
+    { return compareThreeWay(lhs.view(), QByteArrayView(rhs)); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallByteArray, QByteArray)
+
+    friend bool comparesEqual(const QSmallByteArray &lhs, const char *rhs) noexcept
+    { return comparesEqual(lhs.view(), QByteArrayView(rhs)); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallByteArray &lhs, const char *rhs) noexcept
+    { return compareThreeWay(lhs.view(), QByteArrayView(rhs)); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallByteArray, const char *)
+
+    friend size_t qHash(const QSmallByteArray &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+
+    Storage d;
+};
+
+Q_DECLARE_SHARED(QSmallByteArray)
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
@@ -387,6 +387,45 @@ static Q_ALWAYS_INLINE __m128i mm_load8_zero_extend(const void *ptr)
     return _mm_unpacklo_epi8(data, _mm_setzero_si128());
 }
 
+// Returns all-ones in the 16-bit lanes of \a data that are in the range
+// [\a first, \a first + \a count). SSE2 has no unsigned comparison, so the
+// lanes are rebased and biased into signed range first.
+static Q_ALWAYS_INLINE __m128i mm_inrange_epu16(__m128i data, char16_t first, char16_t count)
+{
+    const __m128i bias = _mm_set1_epi16(short(0x8000));
+    const __m128i offset = _mm_xor_si128(_mm_sub_epi16(data, _mm_set1_epi16(short(first))), bias);
+    return _mm_cmplt_epi16(offset, _mm_set1_epi16(short(count ^ 0x8000)));
+}
+
+// Case-folds the Latin-1 code units of \a data: A-Z and U+00C0 to U+00DE
+// (except U+00D7 MULTIPLICATION SIGN) become lowercase, everything else is
+// unchanged. This is what foldCase() does for Latin-1, except for U+00B5
+// MICRO SIGN, which foldCase() maps to U+03BC. No other Latin-1 character
+// folds to U+03BC, so two Latin-1 code units compare equal after this
+// folding if and only if they do after foldCase().
+static Q_ALWAYS_INLINE __m128i mm_foldlatin1_epi16(__m128i data)
+{
+    const __m128i asciiUpper = mm_inrange_epu16(data, u'A', 26);
+    const __m128i latin1Upper = _mm_andnot_si128(_mm_cmpeq_epi16(data, _mm_set1_epi16(0xd7)),
+                                                 mm_inrange_epu16(data, 0xc0, 0x1f));
+    const __m128i isUpper = _mm_or_si128(asciiUpper, latin1Upper);
+    return _mm_add_epi16(data, _mm_and_si128(isUpper, _mm_set1_epi16(0x20)));
+}
+
+// Returns true if the eight code units in \a a and \a b are equal
+// case-insensitively, proven cheaply: each pair must either be identical or
+// consist of two Latin-1 code units that fold to the same character. A false
+// result means the block needs to be compared with foldCase().
+static Q_ALWAYS_INLINE bool mm_latin1_caseless_equal(__m128i a, __m128i b)
+{
+    const __m128i identical = _mm_cmpeq_epi16(a, b);
+    const __m128i latin1 = _mm_cmpeq_epi16(_mm_srli_epi16(_mm_or_si128(a, b), 8),
+                                           _mm_setzero_si128());
+    const __m128i folded = _mm_cmpeq_epi16(mm_foldlatin1_epi16(a), mm_foldlatin1_epi16(b));
+    const __m128i equal = _mm_or_si128(identical, _mm_and_si128(latin1, folded));
+    return _mm_movemask_epi8(equal) == 0xffff;
+}
+
 [[maybe_unused]] ATTRIBUTE_NO_SANITIZE
 static qsizetype qustrlen_sse2(const char16_t *str) noexcept
 {
@@ -764,6 +803,39 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
     return std::find(n, e, c);
 }
 
+#ifdef __SSE2__
+// Returns the uppercase counterpart of the lowercase Latin-1 character \a c,
+// if that is in Latin-1 too; otherwise returns \a c.
+static constexpr char16_t latin1UpperCase(char16_t c) noexcept
+{
+    if ((c >= u'a' && c <= u'z') || (c >= 0xe0 && c <= 0xfe && c != 0xf7))
+        return c - 0x20;
+    return c;
+}
+
+// Advances \a n to the next code unit in [\a n, \a e) that may fold to the
+// Latin-1 character \a folded: the character itself, its uppercase form, or
+// anything outside of Latin-1 (such as U+212A KELVIN SIGN for 'k'). Scans
+// whole blocks of eight code units only. Returns false, with \a n pointing
+// to the unscanned rest, if there is no candidate in those blocks.
+static bool qustrcasechr_candidate_sse2(const char16_t *&n, const char16_t *e, char16_t folded) noexcept
+{
+    const __m128i lower = _mm_set1_epi16(short(folded));
+    const __m128i upper = _mm_set1_epi16(short(latin1UpperCase(folded)));
+    for ( ; e - n >= 8; n += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n));
+        const __m128i latin1 = _mm_cmpeq_epi16(_mm_srli_epi16(data, 8), _mm_setzero_si128());
+        const __m128i match = _mm_or_si128(_mm_cmpeq_epi16(data, lower), _mm_cmpeq_epi16(data, upper));
+        const uint mask = uint(_mm_movemask_epi8(_mm_or_si128(match, _mm_xor_si128(latin1, _mm_set1_epi32(-1)))));
+        if (mask) {
+            n += qCountTrailingZeroBits(mask) / 2;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 /*!
  * \internal
  *
@@ -774,11 +846,19 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
 Q_NEVER_INLINE
 const char16_t *QtPrivate::qustrcasechr(QStringView str, char16_t c) noexcept
 {
-    const QChar *n = str.begin();
-    const QChar *e = str.end();
+    const char16_t *n = str.utf16();
+    const char16_t *e = n + str.size();
     c = foldCase(c);
-    auto it = std::find_if(n, e, [c](auto ch) { return foldAndCompare(ch, QChar(c)); });
-    return reinterpret_cast<const char16_t *>(it);
+#ifdef __SSE2__
+    if (c <= 0xff) {
+        while (qustrcasechr_candidate_sse2(n, e, c)) {
+            if (foldCase(*n) == c)
+                return n;
+            ++n;
+        }
+    }
+#endif
+    return std::find_if(n, e, [c](char16_t ch) { return foldCase(ch) == c; });
 }
 
 // Note: ptr on output may be off by one and point to a preceding US-ASCII
@@ -1198,41 +1278,72 @@ Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype
 
     char32_t alast = 0;
     char32_t blast = 0;
-    qsizetype l = qMin(alen, blen);
-    qsizetype i;
-    for (i = 0; i < l; ++i) {
-//         qDebug() << Qt::hex << alast << blast;
-//         qDebug() << Qt::hex << "*a=" << *a << "alast=" << alast << "folded=" << foldCase (*a, alast);
-//         qDebug() << Qt::hex << "*b=" << *b << "blast=" << blast << "folded=" << foldCase (*b, blast);
-        int diff = foldCase(a[i], alast) - foldCase(b[i], blast);
-        if ((diff))
+    const qsizetype l = qMin(alen, blen);
+    qsizetype i = 0;
+    const auto compareFolded = [&](qsizetype end) {
+        for ( ; i < end; ++i) {
+            if (int diff = foldCase(a[i], alast) - foldCase(b[i], blast))
+                return diff;
+        }
+        return 0;
+    };
+
+#ifdef __SSE2__
+    // skip the blocks that are equal as far as Latin-1 case folding can tell
+    while (l - i >= 8) {
+        const __m128i da = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i db = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        if (mm_latin1_caseless_equal(da, db)) {
+            i += 8;
+            continue;
+        }
+        // fold this block properly; the previous code units may start a surrogate pair
+        alast = i ? a[i - 1] : 0;
+        blast = i ? b[i - 1] : 0;
+        if (int diff = compareFolded(i + 8))
             return diff;
     }
-    if (i == alen) {
-        if (i == blen)
-            return 0;
-        return -1;
+    if (i) {
+        alast = a[i - 1];
+        blast = b[i - 1];
     }
-    return 1;
+#endif
+
+    if (int diff = compareFolded(l))
+        return diff;
+    return qt_lencmp(alen, blen);
 }
 
 // Case-insensitive comparison between a QStringView and a QLatin1StringView
 // (argument order matches those types)
 Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype blen, const char *b)
 {
-    qsizetype l = qMin(alen, blen);
-    qsizetype i;
-    for (i = 0; i < l; ++i) {
-        int diff = foldCase(a[i]) - foldCase(char16_t{uchar(b[i])});
-        if ((diff))
+    const qsizetype l = qMin(alen, blen);
+    qsizetype i = 0;
+    const auto compareFolded = [&](qsizetype end) {
+        for ( ; i < end; ++i) {
+            if (int diff = foldCase(a[i]) - foldCase(char16_t{uchar(b[i])}))
+                return diff;
+        }
+        return 0;
+    };
+
+#ifdef __SSE2__
+    while (l - i >= 8) {
+        const __m128i da = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i db = mm_load8_zero_extend(b + i);
+        if (mm_latin1_caseless_equal(da, db)) {
+            i += 8;
+            continue;
+        }
+        if (int diff = compareFolded(i + 8))
             return diff;
     }
-    if (i == alen) {
-        if (i == blen)
-            return 0;
-        return -1;
-    }
-    return 1;
+#endif
+
+    if (int diff = compareFolded(l))
+        return diff;
+    return qt_lencmp(alen, blen);
 }
 
 // Case-insensitive comparison between a Unicode string and a UTF-8 string
@@ -1383,7 +1494,17 @@ static int latin1nicmp(const char *lhsChar, qsizetype lSize, const char *rhsChar
     const qsizetype size = std::min(lSize, rSize);
 
     Q_ASSERT(lhsChar && rhsChar); // since both lSize and rSize are positive
-    for (qsizetype i = 0; i < size; i++) {
+    qsizetype i = 0;
+#ifdef __SSE2__
+    // both sides are Latin-1, so a block either folds equal or has a difference in it
+    for ( ; size - i >= 8; i += 8) {
+        const __m128i lhs = mm_load8_zero_extend(lhsChar + i);
+        const __m128i rhs = mm_load8_zero_extend(rhsChar + i);
+        if (!mm_latin1_caseless_equal(lhs, rhs))
+            break;
+    }
+#endif
+    for ( ; i < size; i++) {
         if (int res = CaseInsensitiveL1::difference(lhsChar[i], rhsChar[i]))
             return res;
     }
@@ -9945,6 +10066,20 @@ qsizetype QtPrivate::findString(QStringView haystack0, qsizetype from, QStringVi
             ++haystack;
         }
     } else {
+#ifdef __SSE2__
+        // For short needles starting with a Latin-1 character, look for the
+        // positions where the first character may match with SIMD and compare
+        // only there. The hashing below handles the rest of the haystack.
+        if (const char16_t first = foldCase(needle[0]); first <= 0xff && sl <= 16) {
+            while (qustrcasechr_candidate_sse2(haystack, end + 1, first)) {
+                if (QtPrivate::compareStrings(needle0, sv(haystack), Qt::CaseInsensitive) == 0)
+                    return haystack - haystack0.utf16();
+                ++haystack;
+            }
+            if (haystack > end)
+                return -1;
+        }
+#endif
         const char16_t *haystack_start = haystack0.utf16();
         for (idx = 0; idx < sl; ++idx) {
             hashNeedle = (hashNeedle<<1) + foldCase(needle + idx, needle);
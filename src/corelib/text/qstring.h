@@ -1637,6 +1637,36 @@ inline QString operator""_qs(const char16_t *str, size_t size) noexcept
 
 QT_END_NAMESPACE
 
+namespace std {
+// Transparent, so that a std::map or std::set of QString (and thus a QMap or
+// QMultiMap) can be searched with a QStringView or a QLatin1StringView
+// without creating a temporary QString. Other types are still converted to
+// QString.
+template <>
+struct less<QT_PREPEND_NAMESPACE(QString)>
+{
+    using is_transparent = void;
+
+    template <typename View>
+    using if_string_view = std::enable_if_t<
+            std::disjunction_v<std::is_same<View, QT_PREPEND_NAMESPACE(QStringView)>,
+                               std::is_same<View, QT_PREPEND_NAMESPACE(QLatin1StringView)>>,
+            bool>;
+
+    bool operator()(const QT_PREPEND_NAMESPACE(QString) &lhs,
+                    const QT_PREPEND_NAMESPACE(QString) &rhs) const noexcept
+    { return lhs < rhs; }
+
+    template <typename View, if_string_view<View> = true>
+    bool operator()(const QT_PREPEND_NAMESPACE(QString) &lhs, const View &rhs) const noexcept
+    { return lhs < rhs; }
+
+    template <typename View, if_string_view<View> = true>
+    bool operator()(const View &lhs, const QT_PREPEND_NAMESPACE(QString) &rhs) const noexcept
+    { return lhs < rhs; }
+};
+} // namespace std
+
 #include <QtCore/qstringbuilder.h>
 #include <QtCore/qstringconverter.h>
 
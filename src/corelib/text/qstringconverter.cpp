@@ -469,6 +469,215 @@ static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+// Vectorized UTF-8 conversion of BMP text, four characters at a time. Each
+// character occupies one 32-bit lane while it is converted; the UTF-8 bytes
+// are gathered from, or scattered into, the lanes with PSHUFB. The tables are
+// indexed by the UTF-8 lengths of the four characters, 2 bits each, so that
+// index = (len0 - 1) | (len1 - 1) << 2 | (len2 - 1) << 4 | (len3 - 1) << 6.
+namespace {
+struct Utf8ShuffleTables
+{
+    // lanes holding the UTF-8 bytes of a character in their low bytes -> UTF-8 string
+    alignas(16) uchar encode[256][16];
+    uchar encodedLength[256];
+    // UTF-8 string -> lanes holding the UTF-8 bytes of a character in their low bytes
+    alignas(16) uchar decode[256][16];
+};
+
+constexpr Utf8ShuffleTables makeUtf8ShuffleTables()
+{
+    Utf8ShuffleTables tables = {};
+    for (int index = 0; index < 256; ++index) {
+        int encodePos = 0;
+        int decodePos = 0;
+        for (int i = 0; i < 16; ++i)
+            tables.encode[index][i] = tables.decode[index][i] = 0x80;   // zero the byte
+        for (int lane = 0; lane < 4; ++lane) {
+            const int len = ((index >> (2 * lane)) & 3) + 1;
+            if (len > 3)
+                continue;   // not a valid index
+            for (int j = 0; j < len; ++j) {
+                tables.encode[index][encodePos++] = uchar(4 * lane + j);
+                tables.decode[index][4 * lane + j] = uchar(decodePos++);
+            }
+        }
+        tables.encodedLength[index] = uchar(encodePos);
+    }
+    return tables;
+}
+
+constexpr Utf8ShuffleTables utf8ShuffleTables = makeUtf8ShuffleTables();
+} // unnamed namespace
+
+// one bit per lane -> two bits per lane
+static inline uint spreadLaneBits(uint laneBits)
+{
+    return (laneBits & 1) | (laneBits & 2) << 1 | (laneBits & 4) << 2 | (laneBits & 8) << 3;
+}
+
+static bool QT_FUNCTION_TARGET(SSE4_1)
+simdEncodeNonAsciiSse4(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    const char16_t *const start = src;
+
+    // the stores write up to 16 bytes for four characters, the caller's buffer
+    // has room for at least 3 bytes per remaining character
+    while (end - src >= 8) {
+        const __m128i data = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src));
+        // surrogates need the scalar code to be paired or reported as errors
+        const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))),
+                                                   _mm_set1_epi16(short(0xd800)));
+        if (_mm_movemask_epi8(surrogates) & 0xff)
+            break;
+
+        const __m128i c = _mm_cvtepu16_epi32(data);
+        const __m128i isTwo = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7f));
+        const __m128i isThree = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7ff));
+
+        const __m128i low6 = _mm_or_si128(_mm_and_si128(c, _mm_set1_epi32(0x3f)),
+                                          _mm_set1_epi32(0x80));
+        const __m128i mid6 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0x3f)),
+                                          _mm_set1_epi32(0x80));
+        const __m128i leadTwo = _mm_or_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0xc0));
+        const __m128i leadThree = _mm_or_si128(_mm_srli_epi32(c, 12), _mm_set1_epi32(0xe0));
+
+        __m128i byte0 = _mm_blendv_epi8(c, leadTwo, isTwo);
+        byte0 = _mm_blendv_epi8(byte0, leadThree, isThree);
+        const __m128i byte1 = _mm_blendv_epi8(low6, mid6, isThree);
+        const __m128i lanes = _mm_or_si128(_mm_or_si128(byte0, _mm_slli_epi32(byte1, 8)),
+                                           _mm_slli_epi32(low6, 16));
+
+        const uint index = spreadLaneBits(_mm_movemask_ps(_mm_castsi128_ps(isTwo)))
+                + spreadLaneBits(_mm_movemask_ps(_mm_castsi128_ps(isThree)));
+        const __m128i shuffle = _mm_load_si128(
+                reinterpret_cast<const __m128i *>(utf8ShuffleTables.encode[index]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+        dst += utf8ShuffleTables.encodedLength[index];
+        src += 4;
+    }
+    return src != start;
+}
+
+static bool QT_FUNCTION_TARGET(SSE4_1)
+simdDecodeNonAsciiSse4(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+
+    while (end - src >= 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // find where the characters start: everything but continuation bytes
+        // (0x80 to 0xbf, which are less than 0xc0 as signed bytes)
+        const __m128i continuation = _mm_cmplt_epi8(data, _mm_set1_epi8(char(0xc0)));
+        const uint starts = ~uint(_mm_movemask_epi8(continuation)) & 0xffff;
+        if (!(starts & 1))
+            break;
+        const uint p1 = qCountTrailingZeroBits(starts & ~1U);
+        const uint p2 = qCountTrailingZeroBits(starts & (~1U << p1));
+        const uint p3 = qCountTrailingZeroBits(starts & (~1U << p2));
+        const uint p4 = qCountTrailingZeroBits(starts & (~1U << p3));
+        // four characters of up to three bytes each, followed by the start of
+        // another one in this block; otherwise there's a four-byte sequence, a
+        // truncated or overlong one, or we don't know where the fourth ends
+        if (p1 > 3 || p2 - p1 > 3 || p3 - p2 > 3 || p4 - p3 > 3)
+            break;
+
+        const uint index = (p1 - 1) | (p2 - p1 - 1) << 2 | (p3 - p2 - 1) << 4 | (p4 - p3 - 1) << 6;
+        const __m128i shuffle = _mm_load_si128(
+                reinterpret_cast<const __m128i *>(utf8ShuffleTables.decode[index]));
+        const __m128i lanes = _mm_shuffle_epi8(data, shuffle);
+
+        const __m128i lead = _mm_and_si128(lanes, _mm_set1_epi32(0xff));
+        const __m128i cont1 = _mm_and_si128(_mm_srli_epi32(lanes, 8), _mm_set1_epi32(0x3f));
+        const __m128i cont2 = _mm_and_si128(_mm_srli_epi32(lanes, 16), _mm_set1_epi32(0x3f));
+        const __m128i isTwo = _mm_cmpgt_epi32(lead, _mm_set1_epi32(0xbf));
+        const __m128i isThree = _mm_cmpgt_epi32(lead, _mm_set1_epi32(0xdf));
+        const __m128i isFour = _mm_cmpgt_epi32(lead, _mm_set1_epi32(0xef));
+
+        const __m128i two = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(lead, _mm_set1_epi32(0x1f)), 6),
+                                         cont1);
+        const __m128i three = _mm_or_si128(_mm_or_si128(
+                _mm_slli_epi32(_mm_and_si128(lead, _mm_set1_epi32(0x0f)), 12),
+                _mm_slli_epi32(cont1, 6)), cont2);
+        __m128i ucs = _mm_blendv_epi8(lead, two, isTwo);
+        ucs = _mm_blendv_epi8(ucs, three, isThree);
+
+        // validate: the lead bytes must announce the lengths we found, and
+        // there must be no overlong sequences or surrogates
+        const __m128i lengths = _mm_set_epi32(int(p4 - p3), int(p3 - p2), int(p2 - p1), int(p1));
+        const __m128i announced = _mm_sub_epi32(_mm_sub_epi32(_mm_set1_epi32(1), isTwo), isThree);
+        __m128i invalid = _mm_or_si128(_mm_xor_si128(_mm_cmpeq_epi32(lengths, announced),
+                                                     _mm_set1_epi32(-1)),
+                                       isFour);
+        const __m128i minimum = _mm_blendv_epi8(
+                _mm_blendv_epi8(_mm_setzero_si128(), _mm_set1_epi32(0x80), isTwo),
+                _mm_set1_epi32(0x800), isThree);
+        invalid = _mm_or_si128(invalid, _mm_cmplt_epi32(ucs, minimum));
+        invalid = _mm_or_si128(invalid, _mm_cmpeq_epi32(_mm_and_si128(ucs, _mm_set1_epi32(0xf800)),
+                                                        _mm_set1_epi32(0xd800)));
+        if (!_mm_testz_si128(invalid, invalid))
+            break;      // let the scalar code report the error
+
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi32(ucs, ucs));
+        dst += 4;
+        src += p4;
+    }
+    return src != start;
+}
+#endif
+
+// Returns where the conversion loops may first try the SIMD code for non-ASCII
+// text: \a src if the CPU supports it, or \a end so that they never do. This
+// checks the CPU once per conversion instead of once per character.
+template <typename Char>
+static inline const Char *simdNonAsciiStart(const Char *src, const Char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+    if (qCpuHasFeature(SSE4_1))
+        return src;
+#else
+    Q_UNUSED(src);
+#endif
+    return end;
+}
+
+// Converts a run of non-ASCII BMP characters (ASCII may be interspersed),
+// returning true if any characters were converted. Once the SIMD code stops at
+// a block it can't convert, the scalar code has to get past that block before
+// it is tried again, which \a resume keeps track of.
+static inline bool simdEncodeNonAscii(uchar *&dst, const char16_t *&src, const char16_t *end,
+                                      const char16_t *&resume)
+{
+    if (src < resume)
+        return false;
+#if QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+    const bool converted = simdEncodeNonAsciiSse4(dst, src, end);
+    resume = src + qMin<qsizetype>(end - src, 4);
+    return converted;
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(end);
+    return false;
+#endif
+}
+
+static inline bool simdDecodeNonAscii(char16_t *&dst, const uchar *&src, const uchar *end,
+                                      const uchar *&resume)
+{
+    if (src < resume)
+        return false;
+#if QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+    const bool converted = simdDecodeNonAsciiSse4(dst, src, end);
+    resume = src + qMin<qsizetype>(end - src, 16);
+    return converted;
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(end);
+    return false;
+#endif
+}
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -480,6 +689,7 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
     uchar *dst = reinterpret_cast<uchar *>(const_cast<char *>(result.constData()));
     const char16_t *src = reinterpret_cast<const char16_t *>(in.data());
     const char16_t *const end = src + len;
+    const char16_t *simdResume = simdNonAsciiStart(src, end);
 
     while (src != end) {
         const char16_t *nextAscii = end;
@@ -487,6 +697,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
             break;
 
         do {
+            if (simdEncodeNonAscii(dst, src, end, simdResume))
+                continue;
             char16_t u = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end);
             if (res < 0) {
@@ -547,12 +759,15 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         }
     }
 
+    const char16_t *simdResume = simdNonAsciiStart(src, end);
     while (src != end) {
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
 
         do {
+            if (simdEncodeNonAscii(cursor, src, end, simdResume))
+                continue;
             char16_t uc = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
             if (Q_LIKELY(res >= 0))
@@ -650,12 +865,15 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in) noexcept
             src += 3;
         }
 
+        const uchar *simdResume = simdNonAsciiStart(src, end);
         while (src < end) {
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
 
             do {
+                if (simdDecodeNonAscii(dst, src, end, simdResume))
+                    continue;
                 uchar b = *src++;
                 const qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
                 if (res < 0) {
@@ -754,9 +972,12 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, QStringConve
     // main body, stateless decoding
     res = 0;
     const uchar *nextAscii = src;
+    const uchar *simdResume = simdNonAsciiStart(src, end);
     while (res >= 0 && src < end) {
         if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdDecodeNonAscii(dst, src, end, simdResume))
+            continue;
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -8,6 +8,29 @@ QT_BEGIN_NAMESPACE
 
 static constexpr qsizetype FoldBufferCapacity = 256;
 
+class QStringMatcherPrivate
+{
+public:
+    // the case-folded start of the pattern, for case-insensitive matching
+    char16_t foldedPattern[FoldBufferCapacity];
+};
+
+// foldCase(), with a shortcut for US-ASCII characters
+static inline char32_t bm_foldCase(const char16_t *ch, const char16_t *start)
+{
+    if (*ch < 0x80)
+        return (*ch >= u'A' && *ch <= u'Z') ? *ch + 0x20 : *ch;
+    return foldCase(ch, start);
+}
+
+static void bm_fold_pattern(QStringView needle, char16_t *foldBuffer)
+{
+    const char16_t *puc = needle.utf16();
+    const qsizetype foldBufferLength = qMin(FoldBufferCapacity, needle.size());
+    for (qsizetype i = 0; i < foldBufferLength; ++i)
+        foldBuffer[i] = foldCase(&puc[i], puc);
+}
+
 static void bm_init_skiptable(QStringView needle, uchar *skiptable, Qt::CaseSensitivity cs)
 {
     const char16_t *uc = needle.utf16();
@@ -31,7 +54,8 @@ static void bm_init_skiptable(QStringView needle, uchar *skiptable, Qt::CaseSens
 }
 
 static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringView needle,
-                          const uchar *skiptable, Qt::CaseSensitivity cs)
+                          const uchar *skiptable, Qt::CaseSensitivity cs,
+                          const char16_t *foldedNeedle = nullptr)
 {
     const char16_t *uc = haystack.utf16();
     const qsizetype l = haystack.size();
@@ -70,22 +94,24 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
             current += skip;
         }
     } else {
-        char16_t foldBuffer[FoldBufferCapacity];
+        char16_t localFoldBuffer[FoldBufferCapacity];
+        const char16_t *foldBuffer = foldedNeedle;
         const qsizetype foldBufferLength = qMin(FoldBufferCapacity, pl);
-        const char16_t *start = puc;
-        for (qsizetype i = 0; i < foldBufferLength; ++i)
-            foldBuffer[i] = foldCase(&puc[i], start);
+        if (!foldBuffer) {
+            bm_fold_pattern(needle, localFoldBuffer);
+            foldBuffer = localFoldBuffer;
+        }
         QStringView restNeedle = needle.sliced(foldBufferLength);
         const qsizetype foldBufferEnd = foldBufferLength - 1;
         const char16_t *current = uc + index + foldBufferEnd;
         const char16_t *end = uc + l;
 
         while (current < end) {
-            qsizetype skip = skiptable[foldCase(current, uc) & 0xff];
+            qsizetype skip = skiptable[bm_foldCase(current, uc) & 0xff];
             if (!skip) {
                 // possible match
                 while (skip < foldBufferLength) {
-                    if (foldCase(current - skip, uc) != foldBuffer[foldBufferEnd - skip])
+                    if (bm_foldCase(current - skip, uc) != foldBuffer[foldBufferEnd - skip])
                         break;
                     ++skip;
                 }
@@ -100,7 +126,7 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
                 }
                 // in case we don't have a match we are a bit inefficient as we only skip by one
                 // when we have the non matching char in the string.
-                if (skiptable[foldCase(current - skip, uc) & 0xff] == foldBufferLength)
+                if (skiptable[bm_foldCase(current - skip, uc) & 0xff] == foldBufferLength)
                     skip = foldBufferLength - skip;
                 else
                     skip = 1;
@@ -116,6 +142,13 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
 void QStringMatcher::updateSkipTable()
 {
     bm_init_skiptable(q_sv, q_skiptable, q_cs);
+    if (q_cs == Qt::CaseInsensitive) {
+        if (!d_ptr)
+            d_ptr = new QStringMatcherPrivate;
+        bm_fold_pattern(q_sv, d_ptr->foldedPattern);
+    } else {
+        delete std::exchange(d_ptr, nullptr);
+    }
 }
 
 /*!
@@ -196,7 +229,7 @@ QStringMatcher::QStringMatcher(const QStringMatcher &other)
 */
 QStringMatcher::~QStringMatcher()
 {
-    Q_UNUSED(d_ptr);
+    delete d_ptr;
 }
 
 /*!
@@ -209,6 +242,13 @@ QStringMatcher &QStringMatcher::operator=(const QStringMatcher &other)
         q_cs = other.q_cs;
         q_sv = other.q_sv;
         memcpy(q_skiptable, other.q_skiptable, sizeof(q_skiptable));
+        if (other.d_ptr) {
+            if (!d_ptr)
+                d_ptr = new QStringMatcherPrivate;
+            *d_ptr = *other.d_ptr;
+        } else {
+            delete std::exchange(d_ptr, nullptr);
+        }
     }
     return *this;
 }
@@ -304,7 +344,7 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find(str, from, q_sv, q_skiptable, q_cs);
+    return bm_find(str, from, q_sv, q_skiptable, q_cs, d_ptr ? d_ptr->foldedPattern : nullptr);
 }
 
 /*!
@@ -0,0 +1,243 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qstringpool.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <private/qstringconverter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QStringPool
+    \inmodule QtCore
+    \since 6.8
+    \brief The QStringPool class shares the data of equal strings.
+
+    \ingroup string-processing
+    \threadsafe
+
+    Documents and models often contain the same strings many times: the
+    element and attribute names of an XML file, the keys of the objects in a
+    JSON array, or the values of an enumeration-like column. Every QString
+    read from such a source holds its own copy of the characters. QStringPool
+    keeps one copy of each distinct string and hands out implicitly shared
+    references to it, so that equal strings occupy memory only once.
+
+    \code
+    QStringPool pool;
+    QXmlStreamReader reader(&file);
+    while (reader.readNextStartElement()) {
+        const QString name = pool.intern(reader.name());
+        ...
+    }
+    \endcode
+
+    The strings returned by intern() are ordinary QString objects. Their
+    character data stays valid for as long as the pool holds the string, so
+    a QStringView of an interned string can be kept until the string is
+    removed from the pool with squeeze() or clear().
+
+    All functions of QStringPool are thread-safe. The pool is split into
+    independently locked shards, so that threads interning different strings
+    rarely contend.
+
+    Empty strings are never stored in the pool.
+
+    \sa QString::isSharedWith()
+*/
+
+static constexpr qsizetype ShardCount = 16;
+
+class QStringPoolPrivate
+{
+public:
+    struct Shard
+    {
+        mutable QReadWriteLock lock;
+        // the keys are views on the data of the values
+        QHash<QStringView, QString> strings;
+    };
+
+    Shard &shardFor(QStringView str)
+    { return shards[qHash(str, 0) % ShardCount]; }
+    const Shard &shardFor(QStringView str) const
+    { return shards[qHash(str, 0) % ShardCount]; }
+
+    template <typename Maker>
+    QString intern(QStringView str, Maker makeString);
+
+    Shard shards[ShardCount];
+};
+
+template <typename Maker>
+QString QStringPoolPrivate::intern(QStringView str, Maker makeString)
+{
+    Shard &shard = shardFor(str);
+    {
+        QReadLocker locker(&shard.lock);
+        const auto it = shard.strings.constFind(str);
+        if (it != shard.strings.cend())
+            return it.value();
+    }
+
+    QWriteLocker locker(&shard.lock);
+    // another thread may have inserted it in the meantime
+    auto it = shard.strings.constFind(str);
+    if (it == shard.strings.cend()) {
+        QString stored = makeString();
+        it = shard.strings.emplace(QStringView(stored), stored);
+    }
+    return it.value();
+}
+
+static QVarLengthArray<char16_t, 256> toUtf16(QLatin1StringView str)
+{
+    QVarLengthArray<char16_t, 256> buffer(str.size());
+    QLatin1::convertToUnicode(buffer.data(), str);
+    return buffer;
+}
+
+/*!
+    Constructs an empty string pool.
+*/
+QStringPool::QStringPool()
+    : d(new QStringPoolPrivate)
+{
+}
+
+/*!
+    Destroys the pool. Strings returned by intern() remain valid, but
+    QStringView objects referring to them may dangle.
+*/
+QStringPool::~QStringPool()
+{
+    delete d;
+}
+
+/*!
+    \overload
+
+    If the pool contains a string equal to \a str, returns it. Otherwise
+    adds \a str to the pool and returns it.
+
+    The pool shares the data of \a str instead of copying it, unless \a str
+    has unused capacity, or refers to static or raw data (see
+    QString::fromRawData()) whose lifetime the pool doesn't control. In those
+    cases, only the characters are copied, so the pool neither keeps excess
+    memory alive nor holds on to data that may go away.
+*/
+QString QStringPool::intern(const QString &str)
+{
+    if (str.isEmpty())
+        return str;
+    return d->intern(str, [&] {
+        // only data we own can be dropped again by squeeze()
+        if (!str.data_ptr().isMutable() || str.capacity() > str.size())
+            return QString(str.constData(), str.size());
+        return str;
+    });
+}
+
+/*!
+    Returns the string in the pool that is equal to \a str. If there is no
+    such string, a copy of \a str is added to the pool first.
+
+    Calling this function for a string that is already in the pool doesn't
+    allocate memory.
+*/
+QString QStringPool::intern(QStringView str)
+{
+    if (str.isEmpty())
+        return QString();
+    return d->intern(str, [&] { return str.toString(); });
+}
+
+/*!
+    \overload
+*/
+QString QStringPool::intern(QLatin1StringView str)
+{
+    if (str.isEmpty())
+        return QString();
+    const auto buffer = toUtf16(str);
+    return intern(QStringView(buffer.data(), buffer.size()));
+}
+
+/*!
+    Returns \c true if the pool contains a string equal to \a str; otherwise
+    returns \c false.
+*/
+bool QStringPool::contains(QStringView str) const
+{
+    const QStringPoolPrivate::Shard &shard = d->shardFor(str);
+    QReadLocker locker(&shard.lock);
+    return shard.strings.contains(str);
+}
+
+/*!
+    \overload
+*/
+bool QStringPool::contains(QLatin1StringView str) const
+{
+    const auto buffer = toUtf16(str);
+    return contains(QStringView(buffer.data(), buffer.size()));
+}
+
+/*!
+    Returns the number of strings in the pool.
+*/
+qsizetype QStringPool::size() const
+{
+    qsizetype result = 0;
+    for (const QStringPoolPrivate::Shard &shard : d->shards) {
+        QReadLocker locker(&shard.lock);
+        result += shard.strings.size();
+    }
+    return result;
+}
+
+/*!
+    \fn bool QStringPool::isEmpty() const
+
+    Returns \c true if the pool contains no strings; otherwise returns
+    \c false.
+*/
+
+/*!
+    Removes the strings that are not referenced outside of the pool, and
+    returns the number of strings removed.
+
+    Call this function after releasing a large document to return the memory
+    of the strings that only the document used. QStringView objects referring
+    to the removed strings become dangling.
+*/
+qsizetype QStringPool::squeeze()
+{
+    qsizetype removed = 0;
+    for (QStringPoolPrivate::Shard &shard : d->shards) {
+        QWriteLocker locker(&shard.lock);
+        removed += shard.strings.removeIf([](const auto &it) {
+            return it.value().isDetached();
+        });
+        shard.strings.squeeze();
+    }
+    return removed;
+}
+
+/*!
+    Removes all strings from the pool. Strings returned by intern() remain
+    valid, but QStringView objects referring to them may dangle.
+*/
+void QStringPool::clear()
+{
+    for (QStringPoolPrivate::Shard &shard : d->shards) {
+        QWriteLocker locker(&shard.lock);
+        shard.strings.clear();
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,41 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSTRINGPOOL_H
+#define QSTRINGPOOL_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QStringPoolPrivate;
+
+class Q_CORE_EXPORT QStringPool
+{
+public:
+    QStringPool();
+    ~QStringPool();
+
+    QString intern(const QString &str);
+    QString intern(QStringView str);
+    QString intern(QLatin1StringView str);
+
+    bool contains(QStringView str) const;
+    bool contains(QLatin1StringView str) const;
+
+    qsizetype size() const;
+    bool isEmpty() const { return size() == 0; }
+
+    qsizetype squeeze();
+    void clear();
+
+private:
+    Q_DISABLE_COPY_MOVE(QStringPool)
+
+    QStringPoolPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGPOOL_H
@@ -139,6 +139,9 @@ QT_WARNING_POP
     template<class Function>
     QFuture<ResultType<Function>> then(QObject *context, Function &&function);
 
+    template<class Executor, class Function, typename = QtPrivate::EnableIfExecutor<Executor>>
+    QFuture<ResultType<Function>> then(Executor &&executor, Function &&function);
+
 #ifndef QT_NO_EXCEPTIONS
     template<class Function,
              typename = std::enable_if_t<!QtPrivate::ArgResolver<Function>::HasExtraArgs>>
@@ -147,6 +150,10 @@ QT_WARNING_POP
     template<class Function,
              typename = std::enable_if_t<!QtPrivate::ArgResolver<Function>::HasExtraArgs>>
     QFuture<T> onFailed(QObject *context, Function &&handler);
+
+    template<class Executor, class Function, typename = QtPrivate::EnableIfExecutor<Executor>,
+             typename = std::enable_if_t<!QtPrivate::ArgResolver<Function>::HasExtraArgs>>
+    QFuture<T> onFailed(Executor &&executor, Function &&handler);
 #endif
 
     template<class Function, typename = std::enable_if_t<std::is_invocable_r_v<T, Function>>>
@@ -155,6 +162,10 @@ QT_WARNING_POP
     template<class Function, typename = std::enable_if_t<std::is_invocable_r_v<T, Function>>>
     QFuture<T> onCanceled(QObject *context, Function &&handler);
 
+    template<class Executor, class Function, typename = QtPrivate::EnableIfExecutor<Executor>,
+             typename = std::enable_if_t<std::is_invocable_r_v<T, Function>>>
+    QFuture<T> onCanceled(Executor &&executor, Function &&handler);
+
 #if !defined(Q_QDOC)
     template<class U = T, typename = std::enable_if_t<QtPrivate::isQFutureV<U>>>
     auto unwrap();
@@ -366,6 +377,17 @@ QFuture<typename QFuture<T>::template ResultType<Function>> QFuture<T>::then(QOb
     return promise.future();
 }
 
+template<class T>
+template<class Executor, class Function, typename>
+QFuture<typename QFuture<T>::template ResultType<Function>>
+QFuture<T>::then(Executor &&executor, Function &&function)
+{
+    QFutureInterface<ResultType<Function>> promise(QFutureInterfaceBase::State::Pending);
+    QtPrivate::Continuation<std::decay_t<Function>, ResultType<Function>, T>::createWithExecutor(
+            std::forward<Function>(function), this, promise, std::forward<Executor>(executor));
+    return promise.future();
+}
+
 #ifndef QT_NO_EXCEPTIONS
 template<class T>
 template<class Function, typename>
@@ -387,6 +409,16 @@ QFuture<T> QFuture<T>::onFailed(QObject *context, Function &&handler)
     return promise.future();
 }
 
+template<class T>
+template<class Executor, class Function, typename, typename>
+QFuture<T> QFuture<T>::onFailed(Executor &&executor, Function &&handler)
+{
+    QFutureInterface<T> promise(QFutureInterfaceBase::State::Pending);
+    QtPrivate::FailureHandler<std::decay_t<Function>, T>::createWithExecutor(
+            std::forward<Function>(handler), this, promise, std::forward<Executor>(executor));
+    return promise.future();
+}
+
 #endif
 
 template<class T>
@@ -409,6 +441,16 @@ QFuture<T> QFuture<T>::onCanceled(QObject *context, Function &&handler)
     return promise.future();
 }
 
+template<class T>
+template<class Executor, class Function, typename, typename>
+QFuture<T> QFuture<T>::onCanceled(Executor &&executor, Function &&handler)
+{
+    QFutureInterface<T> promise(QFutureInterfaceBase::State::Pending);
+    QtPrivate::CanceledHandler<std::decay_t<Function>, T>::createWithExecutor(
+            std::forward<Function>(handler), this, promise, std::forward<Executor>(executor));
+    return promise.future();
+}
+
 template<class T>
 template<class U, typename>
 auto QFuture<T>::unwrap()
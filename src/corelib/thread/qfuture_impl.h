@@ -284,6 +284,24 @@ using IsForwardIterable =
         std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category,
                             std::forward_iterator_tag>;
 
+template<class Executor, class = void>
+struct IsExecutor : std::false_type
+{
+};
+
+template<class Executor>
+struct IsExecutor<Executor,
+                  std::void_t<decltype(std::declval<Executor &>().execute(
+                          std::declval<QRunnable *>()))>> : std::true_type
+{
+};
+
+template<class Executor>
+inline constexpr bool isExecutorV = IsExecutor<std::decay_t<Executor>>::value;
+
+template<class Executor>
+using EnableIfExecutor = std::enable_if_t<isExecutorV<Executor>>;
+
 template<typename Function, typename ResultType, typename ParentResultType>
 class Continuation
 {
@@ -310,6 +328,10 @@ public:
     static void create(F &&func, QFuture<ParentResultType> *f, QFutureInterface<ResultType> &fi,
                        QObject *context);
 
+    template<typename Executor, typename F = Function>
+    static void createWithExecutor(F &&func, QFuture<ParentResultType> *f,
+                                   QFutureInterface<ResultType> &fi, Executor &&executor);
+
 private:
     void fulfillPromiseWithResult();
     void fulfillVoidPromise();
@@ -378,6 +400,38 @@ private:
     QThreadPool *threadPool;
 };
 
+template<typename Function, typename ResultType, typename ParentResultType, typename Executor>
+class ExecutorContinuation final : public QRunnable,
+                                   public Continuation<Function, ResultType, ParentResultType>
+{
+public:
+    template<typename F = Function, typename E = Executor>
+    ExecutorContinuation(F &&func, const QFuture<ParentResultType> &f, QPromise<ResultType> &&p,
+                         E &&e)
+        : Continuation<Function, ResultType, ParentResultType>(std::forward<F>(func), f,
+                                                               std::move(p)),
+          executor(std::forward<E>(e))
+    {
+    }
+
+    ~ExecutorContinuation() override = default;
+
+private:
+    void runImpl() override // from Continuation
+    {
+        // the executor takes ownership of this, like QThreadPool::start() does
+        executor.execute(this);
+    }
+
+    void run() override // from QRunnable
+    {
+        this->runFunction();
+    }
+
+private:
+    Executor executor;
+};
+
 #ifndef QT_NO_EXCEPTIONS
 
 template<class Function, class ResultType>
@@ -392,6 +446,10 @@ public:
     static void create(F &&function, QFuture<ResultType> *future, QFutureInterface<ResultType> &fi,
                        QObject *context);
 
+    template<typename Executor, typename F = Function>
+    static void createWithExecutor(F &&function, QFuture<ResultType> *future,
+                                   const QFutureInterface<ResultType> &fi, Executor &&executor);
+
     template<typename F = Function>
     FailureHandler(F &&func, const QFuture<ResultType> &f, QPromise<ResultType> &&p)
         : promise(std::move(p)), parentFuture(f), handler(std::forward<F>(func))
@@ -621,6 +679,34 @@ void Continuation<Function, ResultType, ParentResultType>::create(F &&func,
     QtPrivate::watchContinuation(context, std::move(continuation), f->d);
 }
 
+template<typename Function, typename ResultType, typename ParentResultType>
+template<typename Executor, typename F>
+void Continuation<Function, ResultType, ParentResultType>::createWithExecutor(
+        F &&func, QFuture<ParentResultType> *f, QFutureInterface<ResultType> &fi,
+        Executor &&executor)
+{
+    Q_ASSERT(f);
+
+    using ExecutorType = std::decay_t<Executor>;
+    auto continuation = [func = std::forward<F>(func), promise_ = QPromise(fi),
+                         executor = std::forward<Executor>(executor)](
+                                const QFutureInterfaceBase &parentData) mutable {
+        const auto parent = QFutureInterface<ParentResultType>(parentData).future();
+        auto continuationJob =
+                new ExecutorContinuation<Function, ResultType, ParentResultType, ExecutorType>(
+                        std::forward<Function>(func), parent, std::move(promise_),
+                        std::move(executor));
+        bool isLaunched = continuationJob->execute();
+        // If the continuation was handed to the executor, the executor deletes it after
+        // running it.
+        if (!isLaunched) {
+            delete continuationJob;
+            continuationJob = nullptr;
+        }
+    };
+    f->d.setContinuation(ContinuationWrapper(std::move(continuation)), fi.d);
+}
+
 template<typename Function, typename ResultType, typename ParentResultType>
 void Continuation<Function, ResultType, ParentResultType>::fulfillPromiseWithResult()
 {
@@ -713,6 +799,38 @@ void FailureHandler<Function, ResultType>::create(F &&function, QFuture<ResultTy
     QtPrivate::watchContinuation(context, std::move(failureContinuation), future->d);
 }
 
+template<class Function, class ResultType>
+template<class Executor, class F>
+void FailureHandler<Function, ResultType>::createWithExecutor(F &&function,
+                                                              QFuture<ResultType> *future,
+                                                              const QFutureInterface<ResultType> &fi,
+                                                              Executor &&executor)
+{
+    Q_ASSERT(future);
+
+    auto failureContinuation = [function = std::forward<F>(function), promise_ = QPromise(fi),
+                                executor = std::forward<Executor>(executor)](
+                                       const QFutureInterfaceBase &parentData) mutable {
+        const auto parent = QFutureInterface<ResultType>(parentData).future();
+        if (!parent.d.hasException()) {
+            // the handler won't be called, pass the result on right here
+            FailureHandler<Function, ResultType> failureHandler(
+                    std::forward<Function>(function), parent, std::move(promise_));
+            failureHandler.run();
+            return;
+        }
+        executor.execute(QRunnable::create(
+                [function = std::forward<Function>(function), parent,
+                 promise_ = std::move(promise_)]() mutable {
+                    FailureHandler<Function, ResultType> failureHandler(
+                            std::forward<Function>(function), parent, std::move(promise_));
+                    failureHandler.run();
+                }));
+    };
+
+    future->d.setContinuation(ContinuationWrapper(std::move(failureContinuation)));
+}
+
 template<class Function, class ResultType>
 void FailureHandler<Function, ResultType>::run()
 {
@@ -807,6 +925,30 @@ public:
         QtPrivate::watchContinuation(context, std::move(canceledContinuation), future->d);
     }
 
+    template<class Executor, class F = Function>
+    static void createWithExecutor(F &&handler, QFuture<ResultType> *future,
+                                   QFutureInterface<ResultType> &fi, Executor &&executor)
+    {
+        Q_ASSERT(future);
+
+        auto canceledContinuation = [promise = QPromise(fi), handler = std::forward<F>(handler),
+                                     executor = std::forward<Executor>(executor)](
+                                            const QFutureInterfaceBase &parentData) mutable {
+            auto parentFuture = QFutureInterface<ResultType>(parentData).future();
+            if (!parentFuture.isCanceled() || parentFuture.d.hasException()) {
+                // the handler won't be called, pass the result on right here
+                run(std::forward<F>(handler), parentFuture, std::move(promise));
+                return;
+            }
+            executor.execute(QRunnable::create(
+                    [handler = std::forward<F>(handler), parentFuture,
+                     promise = std::move(promise)]() mutable {
+                        run(std::forward<F>(handler), parentFuture, std::move(promise));
+                    }));
+        };
+        future->d.setContinuation(ContinuationWrapper(std::move(canceledContinuation)));
+    }
+
     template<class F = Function>
     static void run(F &&handler, QFuture<ResultType> &parentFuture, QPromise<ResultType> &&promise)
     {
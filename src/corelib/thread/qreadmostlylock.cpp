@@ -0,0 +1,270 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qreadmostlylock_p.h"
+
+#include "qthread.h"
+#include "qfutex_p.h"
+#include "private/qlocking_p.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * Implementation details of QReadMostlyLock:
+ *
+ * QReadWriteLock counts its readers in a single atomic, so all threads taking
+ * the lock for reading write to the same cache line, which then bounces
+ * between the cores. QReadMostlyLock spreads the readers over StripeCount
+ * counters instead, each in its own cache line; a thread always uses the same
+ * stripe. Taking the lock for reading is therefore cheap and scales with the
+ * number of threads, as long as there are no writers. Taking it for writing
+ * is comparatively expensive, as the writer has to visit every stripe.
+ *
+ * The state word holds:
+ *  - WriterLocked: a writer holds the lock, or is waiting for the readers to
+ *    leave. New readers back off and wait until it is cleared, so writers are
+ *    not starved.
+ *  - Waiters: some thread is sleeping on the state word and must be woken up
+ *    when the writer unlocks.
+ *
+ * Readers increment their stripe and then check the state word; the writer
+ * sets WriterLocked and then checks the stripes. Sequentially consistent
+ * fences between the two steps on both sides guarantee that at least one of
+ * them notices the other. A writer that finds a stripe with readers sets
+ * WriterWaiting on that stripe and sleeps on it, and the last reader leaving
+ * the stripe wakes it up.
+ *
+ * The futexes are used where available. Elsewhere, waiting threads sleep on a
+ * condition variable shared by all QReadMostlyLocks.
+ */
+
+namespace {
+enum : int {
+    WriterLocked = 0x1,
+    Waiters = 0x2,
+};
+enum : int {
+    WriterWaiting = int(0x80000000U),
+    ReaderCountMask = ~WriterWaiting,
+};
+
+struct FallbackWaiter
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+};
+Q_GLOBAL_STATIC(FallbackWaiter, fallbackWaiter)
+
+using namespace QtFutex;
+
+// Returns false if the timeout expired.
+bool waitWhileEqual(QBasicAtomicInteger<int> &word, int expected, QDeadlineTimer timeout)
+{
+    if (futexAvailable()) {
+        if (timeout.isForever()) {
+            futexWait(word, expected);
+            return true;
+        }
+        return futexWait(word, expected, timeout);
+    }
+
+    FallbackWaiter *waiter = fallbackWaiter();
+    auto lock = qt_unique_lock(waiter->mutex);
+    while (word.loadAcquire() == expected) {
+        if (timeout.isForever())
+            waiter->cond.wait(lock);
+        else if (waiter->cond.wait_until(lock, timeout.deadline<std::chrono::steady_clock>())
+                 == std::cv_status::timeout)
+            return word.loadAcquire() != expected;
+    }
+    return true;
+}
+
+void wakeAll(QBasicAtomicInteger<int> &word)
+{
+    if (futexAvailable()) {
+        futexWakeAll(word);
+    } else {
+        FallbackWaiter *waiter = fallbackWaiter();
+        // lock to avoid a lost wakeup between the waiter's check and its wait
+        const auto lock = qt_scoped_lock(waiter->mutex);
+        waiter->cond.notify_all();
+    }
+}
+
+int stripeForCurrentThread()
+{
+    Q_CONSTINIT static QBasicAtomicInteger<uint> nextStripe = Q_BASIC_ATOMIC_INITIALIZER(0);
+    static thread_local int stripe = -1;
+    if (Q_UNLIKELY(stripe < 0))
+        stripe = nextStripe.fetchAndAddRelaxed(1) % QReadMostlyLock::StripeCount;
+    return stripe;
+}
+} // unnamed namespace
+
+/*!
+    \class QReadMostlyLock
+    \inmodule QtCore
+    \internal
+
+    \brief The QReadMostlyLock class is a read-write lock optimized for data
+    that is read by many threads concurrently and rarely modified.
+
+    Its interface follows QReadWriteLock, but locking for reading does not
+    write to any memory location shared with readers in other threads, so it
+    scales with the number of reading threads. In exchange, locking for
+    writing is more expensive, and the lock is larger and not recursive.
+
+    Like in QReadWriteLock, readers cannot acquire the lock while a writer is
+    waiting for it.
+
+    \sa QReadWriteLock
+*/
+
+/*!
+    \fn QReadMostlyLock::QReadMostlyLock()
+
+    Constructs an unlocked QReadMostlyLock.
+*/
+
+/*!
+    Destroys the QReadMostlyLock. It must not be locked.
+*/
+QReadMostlyLock::~QReadMostlyLock()
+{
+    if (state.loadRelaxed() & WriterLocked)
+        qWarning("QReadMostlyLock: destroying locked QReadMostlyLock");
+}
+
+/*!
+    \fn void QReadMostlyLock::lockForRead()
+
+    Locks the lock for reading, blocking while another thread holds it for
+    writing or is waiting to do so.
+*/
+
+/*!
+    Attempts to lock for reading, waiting at most until \a timeout expires.
+    Returns \c true if the lock was obtained.
+*/
+bool QReadMostlyLock::tryLockForRead(QDeadlineTimer timeout)
+{
+    Stripe &stripe = stripes[stripeForCurrentThread()];
+    while (true) {
+        stripe.readers.fetchAndAddRelaxed(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int s = state.loadAcquire();
+        if (Q_LIKELY(!(s & WriterLocked)))
+            return true;
+
+        // a writer holds the lock or waits for it: let it proceed
+        unlockForRead(stripe);
+        while (s & WriterLocked) {
+            if (timeout.hasExpired())
+                return false;
+            if (!(s & Waiters) && !state.testAndSetRelaxed(s, s | Waiters, s))
+                continue;
+            waitWhileEqual(state, s | Waiters, timeout);
+            s = state.loadRelaxed();
+        }
+    }
+}
+
+/*!
+    \fn void QReadMostlyLock::lockForWrite()
+
+    Locks the lock for writing, blocking while other threads hold it.
+*/
+
+/*!
+    Attempts to lock for writing, waiting at most until \a timeout expires.
+    Returns \c true if the lock was obtained.
+*/
+bool QReadMostlyLock::tryLockForWrite(QDeadlineTimer timeout)
+{
+    // first, exclude other writers and new readers
+    int s = state.loadRelaxed();
+    while (true) {
+        if (!(s & WriterLocked)) {
+            if (state.testAndSetAcquire(s, s | WriterLocked, s))
+                break;
+            continue;
+        }
+        if (timeout.hasExpired())
+            return false;
+        if (!(s & Waiters) && !state.testAndSetRelaxed(s, s | Waiters, s))
+            continue;
+        waitWhileEqual(state, s | Waiters, timeout);
+        s = state.loadRelaxed();
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // then wait for the current readers to leave
+    if (!waitForReaders(timeout)) {
+        unlockForWrite();
+        return false;
+    }
+    writer.storeRelaxed(QThread::currentThreadId());
+    return true;
+}
+
+bool QReadMostlyLock::waitForReaders(QDeadlineTimer timeout)
+{
+    for (Stripe &stripe : stripes) {
+        int r = stripe.readers.loadAcquire();
+        while (r & ReaderCountMask) {
+            if (timeout.hasExpired()) {
+                stripe.readers.fetchAndAndRelaxed(ReaderCountMask);
+                return false;
+            }
+            if (!(r & WriterWaiting)) {
+                if (!stripe.readers.testAndSetRelaxed(r, r | WriterWaiting, r))
+                    continue;
+                r |= WriterWaiting;
+            }
+            waitWhileEqual(stripe.readers, r, timeout);
+            r = stripe.readers.loadAcquire();
+        }
+        if (r & WriterWaiting)
+            stripe.readers.fetchAndAndRelaxed(ReaderCountMask);
+    }
+    return true;
+}
+
+/*!
+    Unlocks the lock, which the calling thread must have locked for reading or
+    writing.
+*/
+void QReadMostlyLock::unlock()
+{
+    // a thread that locked for reading cannot be the writer, and the writer
+    // cannot be waiting for the readers while it is unlocking
+    if (writer.loadRelaxed() == QThread::currentThreadId()) {
+        writer.storeRelaxed(nullptr);
+        unlockForWrite();
+    } else {
+        unlockForRead(stripes[stripeForCurrentThread()]);
+    }
+}
+
+void QReadMostlyLock::unlockForRead(Stripe &stripe)
+{
+    const int r = stripe.readers.fetchAndSubRelease(1);
+    Q_ASSERT_X(r & ReaderCountMask, "QReadMostlyLock::unlock()", "Cannot unlock an unlocked lock");
+    if (Q_UNLIKELY(r == (WriterWaiting | 1)))
+        wakeAll(stripe.readers);    // we were the last reader the writer waited for
+}
+
+void QReadMostlyLock::unlockForWrite()
+{
+    const int s = state.fetchAndStoreRelease(0);
+    Q_ASSERT(s & WriterLocked);
+    if (s & Waiters)
+        wakeAll(state);
+}
+
+QT_END_NAMESPACE
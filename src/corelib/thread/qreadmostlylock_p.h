@@ -0,0 +1,63 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREADMOSTLYLOCK_P_H
+#define QREADMOSTLYLOCK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qnamespace.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QReadMostlyLock
+{
+public:
+    // power of two; each stripe occupies its own cache line
+    static constexpr int StripeCount = 16;
+
+    constexpr QReadMostlyLock() noexcept = default;
+    ~QReadMostlyLock();
+
+    void lockForRead() { tryLockForRead(QDeadlineTimer(QDeadlineTimer::Forever)); }
+    bool tryLockForRead(QDeadlineTimer timeout = {});
+    void lockForWrite() { tryLockForWrite(QDeadlineTimer(QDeadlineTimer::Forever)); }
+    bool tryLockForWrite(QDeadlineTimer timeout = {});
+    void unlock();
+
+private:
+    Q_DISABLE_COPY_MOVE(QReadMostlyLock)
+
+    struct alignas(64) Stripe
+    {
+        // number of readers in the low bits, plus WriterWaiting
+        QBasicAtomicInteger<int> readers = Q_BASIC_ATOMIC_INITIALIZER(0);
+    };
+
+    bool waitForReaders(QDeadlineTimer timeout);
+    void unlockForRead(Stripe &stripe);
+    void unlockForWrite();
+
+    Stripe stripes[StripeCount] = {};
+    // WriterLocked and Waiters bits
+    alignas(64) QBasicAtomicInteger<int> state = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QBasicAtomicPointer<void> writer = Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+};
+
+QT_END_NAMESPACE
+
+#endif // QREADMOSTLYLOCK_P_H
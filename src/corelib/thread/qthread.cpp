@@ -8,6 +8,7 @@
 #include "qreadwritelock.h"
 #include "qabstracteventdispatcher.h"
 #include "qbindingstorage.h"
+#include "qproperty.h"
 
 #include <qeventloop.h>
 
@@ -40,6 +41,27 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+// Returns true if the inbox was empty, i.e. the owning thread needs a wake-up.
+bool QPostEventList::pushToInbox(QObject *receiver, QAbstractMetaCallEvent *event)
+{
+    event->inboxReceiver_ = receiver;
+    QAbstractMetaCallEvent *head = inbox.load(std::memory_order_relaxed);
+    do {
+        event->inboxNext_ = head;
+    } while (!inbox.compare_exchange_weak(head, event, std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return head == nullptr;
+}
+
+// Waits until all producers that may still push onto this inbox have done so.
+// Used after changing an object's thread data, so none of them can push an
+// event for it here afterwards.
+void QPostEventList::waitForInboxProducers() const
+{
+    while (inboxProducers.load(std::memory_order_acquire) != 0)
+        QThread::yieldCurrentThread();
+}
+
 
 /*
   QThreadData
@@ -82,6 +104,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    drainPostEventInbox();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -90,10 +113,52 @@ QThreadData::~QThreadData()
             delete pe.event;
         }
     }
+    QMetaCallEventPool::release(std::exchange(metaCallEventPool, nullptr));
 
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
+/*!
+    \internal
+
+    Moves the events pushed onto the post event list's inbox into the list,
+    in the order they were posted. Must be called with postEventList.mutex
+    held, before looking at the list.
+*/
+void QThreadData::drainPostEventInbox()
+{
+    QAbstractMetaCallEvent *event = postEventList.inbox.exchange(nullptr, std::memory_order_acquire);
+    if (!event)
+        return;
+
+    // the inbox is a stack, so the newest event comes first
+    QAbstractMetaCallEvent *oldest = nullptr;
+    while (event) {
+        QAbstractMetaCallEvent *next = std::exchange(event->inboxNext_, oldest);
+        oldest = event;
+        event = next;
+    }
+
+    for (event = oldest; event; ) {
+        QAbstractMetaCallEvent *next = std::exchange(event->inboxNext_, nullptr);
+        QObject *receiver = std::exchange(event->inboxReceiver_, nullptr);
+        QThreadData *receiverData = QObjectPrivate::get(receiver)->threadData.loadAcquire();
+
+        if (receiverData && receiverData != this) {
+            // the receiver moved to another thread after the event was pushed
+            if (receiverData->postEventList.pushToInbox(receiver, event)) {
+                if (QAbstractEventDispatcher *dispatcher = receiverData->eventDispatcher.loadAcquire())
+                    dispatcher->wakeUp();
+            }
+        } else if (!QCoreApplicationPrivate::compressPostedMetaCallEvent(receiver, event,
+                                                                         &postEventList)) {
+            postEventList.addEvent(QPostEvent(receiver, event, Qt::NormalEventPriority));
+            canWait = false;
+        }
+        event = next;
+    }
+}
+
 void QThreadData::ref()
 {
 #if QT_CONFIG(thread)
@@ -162,6 +227,11 @@ QScopedScopeLevelCounter::~QScopedScopeLevelCounter()
     --threadData->scopeLevel;
     qCDebug(lcDeleteLater) << "Decreased" << threadData->thread
                       << "scope level to" << threadData->scopeLevel;
+    // end the automatic property update group opened during this event
+    if (Q_UNLIKELY(threadData->scopeLevel < threadData->propertyUpdateGroupScopeLevel)) {
+        threadData->propertyUpdateGroupScopeLevel = 0;
+        Qt::endPropertyUpdateGroup();
+    }
 }
 
 #if QT_CONFIG(thread)
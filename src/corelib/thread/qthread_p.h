@@ -72,9 +72,19 @@ public:
 
     QMutex mutex;
 
+    // Queued meta calls are pushed onto this lock-free stack without taking
+    // the mutex (see QCoreApplicationPrivate::postMetaCallEvent()); whoever
+    // holds the mutex next moves them into the list with
+    // QThreadData::drainPostEventInbox().
+    std::atomic<QAbstractMetaCallEvent *> inbox = nullptr;
+    // number of threads between choosing this list and pushing to the inbox
+    std::atomic<int> inboxProducers = 0;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
+    bool pushToInbox(QObject *receiver, QAbstractMetaCallEvent *event);
+    void waitForInboxProducers() const;
 
 private:
     //hides because they do not keep that list sorted. addEvent must be used
@@ -311,15 +321,20 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
+        drainPostEventInbox();
         return canWait;
     }
 
+    void drainPostEventInbox();
+
 private:
     QAtomicInt _ref;
 
 public:
     int loopLevel;
     int scopeLevel;
+    // scope level at which an automatic property update group was opened
+    int propertyUpdateGroupScopeLevel = 0;
 
     QStack<QEventLoop *> eventLoops;
     QPostEventList postEventList;
@@ -327,6 +342,7 @@ public:
     QAtomicPointer<void> threadId;
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
     QList<void *> tls;
+    QMetaCallEventPool *metaCallEventPool = nullptr;
 
     bool quitNow;
     bool canWait;
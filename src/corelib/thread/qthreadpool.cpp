@@ -29,8 +29,12 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolLocalQueue *localQueue = nullptr;
 };
 
+// the pool thread running on the current thread, if any
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -50,47 +54,65 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
         runnable = nullptr;
 
+        if (!localQueue && manager->workStealing.load(std::memory_order_relaxed))
+            localQueue = manager->acquireLocalQueue();
+
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, keep going without the lock
+                    r = localQueue ? manager->takeLocalTask(localQueue, locker) : nullptr;
+                } while (r);
                 locker.relock();
             }
 
+            const bool hasLocalTasks = localQueue && !localQueue->isEmpty();
+
             // if too many threads are active, stop working in this one
-            if (manager->tooManyThreadsActive())
+            if (manager->tooManyThreadsActive() && !hasLocalTasks)
                 break;
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            if (manager->queue.isEmpty()) {
+                // local tasks may have been held back by higher priority ones,
+                // and other threads may have work for us to steal
+                if (localQueue && (r = manager->takeLocalTask(localQueue, locker)))
+                    continue;
+
+                // all work is done, time to wait for more
                 break;
+            }
 
             QueuePage *page = manager->queue.constFirst();
             r = page->pop();
+            manager->taskDequeued(page);
 
             if (page->isFinished()) {
                 manager->queue.removeFirst();
@@ -111,6 +133,17 @@ void QThreadPoolThread::run()
             return;
         }
         manager->waitingThreads.enqueue(this);
+        manager->updateIdleThreads();
+        if (localQueue) {
+            // pairs with the fence in pushLocalTask(): either the pusher sees
+            // us idle and wakes us up, or we see its task here
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (manager->hasStealableTasks()) {
+                manager->waitingThreads.removeOne(this);
+                manager->updateIdleThreads();
+                continue;
+            }
+        }
         registerThreadInactive();
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
@@ -120,6 +153,7 @@ void QThreadPoolThread::run()
             return;
         }
         if (manager->waitingThreads.removeOne(this)) {
+            manager->updateIdleThreads();
             manager->expiredThreads.enqueue(this);
             return;
         }
@@ -140,6 +174,13 @@ void QThreadPoolThread::registerThreadInactive()
 QThreadPoolPrivate:: QThreadPoolPrivate()
 { }
 
+QThreadPoolPrivate::~QThreadPoolPrivate()
+{
+    const int count = localQueueCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
+        delete localQueues[i].load(std::memory_order_relaxed);
+}
+
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     Q_ASSERT(task != nullptr);
@@ -157,23 +198,12 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         // recycle an available thread
         enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
+        updateIdleThreads();
         return true;
     }
 
     if (!expiredThreads.isEmpty()) {
-        // restart an expired thread
-        QThreadPoolThread *thread = expiredThreads.dequeue();
-        Q_ASSERT(thread->runnable == nullptr);
-
-        ++activeThreads;
-
-        thread->runnable = task;
-
-        // Ensure that the thread has actually finished, otherwise the following
-        // start() has no effect.
-        thread->wait();
-        Q_ASSERT(thread->isFinished());
-        thread->start(threadPriority);
+        restartExpiredThread(task);
         return true;
     }
 
@@ -182,6 +212,145 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     return true;
 }
 
+void QThreadPoolPrivate::restartExpiredThread(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = expiredThreads.dequeue();
+    Q_ASSERT(thread->runnable == nullptr);
+
+    ++activeThreads;
+
+    thread->runnable = runnable;
+
+    // Ensure that the thread has actually finished, otherwise the following
+    // start() has no effect.
+    thread->wait();
+    Q_ASSERT(thread->isFinished());
+    thread->start(threadPriority);
+}
+
+/*!
+    \internal
+
+    Pushes \a runnable onto the local queue of the calling thread, if it is
+    one of our threads and work stealing is enabled. Returns \c false if the
+    task has to go through the shared queue instead.
+
+    Called without the mutex held.
+*/
+bool QThreadPoolPrivate::pushLocalTask(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this || !thread->localQueue
+        || !workStealing.load(std::memory_order_relaxed)
+        || !thread->localQueue->push(runnable)) {
+        return false;
+    }
+
+    // pairs with the fence in QThreadPoolThread::run(): either we see the
+    // thread going idle, or it sees our task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // wake idle threads to steal the task, and bring in more threads as
+    // tasks pile up, doubling the number of helpers each time
+    const qsizetype pending = thread->localQueue->size();
+    const bool pilingUp = pending > 1 && (pending & (pending - 1)) == 0;
+    if (pilingUp || idleThreads.load(std::memory_order_relaxed) > 0) {
+        QMutexLocker locker(&mutex);
+        startHelperThreads(pending);
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns the next task from \a localQueue, or one stolen from another
+    thread's local queue, or \nullptr if there are none or tasks with a
+    higher priority are waiting in the shared queue. \a locker is the calling
+    thread's lock on the mutex, which may or may not be held.
+*/
+QRunnable *QThreadPoolPrivate::takeLocalTask(QThreadPoolLocalQueue *localQueue,
+                                             QMutexLocker<QMutex> &locker)
+{
+    // local tasks all have the default priority, so queued tasks with a
+    // higher one go first; those are taken from the shared queue under the lock
+    if (queuedPriorityTasks.load(std::memory_order_relaxed) > 0)
+        return nullptr;
+
+    if (QRunnable *runnable = localQueue->pop())
+        return runnable;
+
+    const int count = localQueueCount.load(std::memory_order_acquire);
+    for (int i = 1; i < count; ++i) {
+        QThreadPoolLocalQueue *victim =
+                localQueues[(localQueue->index() + i) % count].load(std::memory_order_acquire);
+        if (victim == localQueue)
+            continue;
+        if (QRunnable *runnable = victim->steal()) {
+            // there's more: get another idle thread to help
+            if (!victim->isEmpty() && idleThreads.load(std::memory_order_relaxed) > 0) {
+                if (locker.isLocked()) {
+                    startHelperThreads(1);
+                } else {
+                    locker.relock();
+                    startHelperThreads(1);
+                    locker.unlock();
+                }
+            }
+            return runnable;
+        }
+    }
+    return nullptr;
+}
+
+bool QThreadPoolPrivate::hasStealableTasks() const
+{
+    const int count = localQueueCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        if (!localQueues[i].load(std::memory_order_acquire)->isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Wakes up or starts up to \a count threads without a task of their own,
+    so that they steal tasks from the local queues.
+*/
+void QThreadPoolPrivate::startHelperThreads(qsizetype count)
+{
+    for (; count > 0; --count) {
+        if (!waitingThreads.isEmpty()) {
+            waitingThreads.takeFirst()->runnableReady.wakeOne();
+            updateIdleThreads();
+        } else if (areAllThreadsActive()) {
+            break;
+        } else if (!expiredThreads.isEmpty()) {
+            restartExpiredThread(nullptr);
+        } else {
+            startThread();
+        }
+    }
+}
+
+QThreadPoolLocalQueue *QThreadPoolPrivate::acquireLocalQueue()
+{
+    if (!freeLocalQueues.isEmpty())
+        return freeLocalQueues.takeLast();
+
+    // threads beyond the limit only use the shared queue
+    const int count = localQueueCount.load(std::memory_order_relaxed);
+    if (count == MaxLocalQueues)
+        return nullptr;
+
+    auto *localQueue = new QThreadPoolLocalQueue(count);
+    localQueues[count].store(localQueue, std::memory_order_release);
+    localQueueCount.store(count + 1, std::memory_order_release);
+    return localQueue;
+}
+
 inline bool comparePriority(int priority, const QueuePage *p)
 {
     return p->priority() < priority;
@@ -190,6 +359,8 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    if (priority > 0)
+        queuedPriorityTasks.fetch_add(1, std::memory_order_relaxed);
     for (QueuePage *page : std::as_const(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -217,6 +388,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             break;
 
         page->pop();
+        taskDequeued(page);
 
         if (page->isFinished()) {
             queue.removeFirst();
@@ -239,10 +411,11 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 
 /*!
     \internal
+
+    Starts a new thread, running \a runnable first if it is not \nullptr.
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
     auto thread = std::make_unique<QThreadPoolThread>(this);
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
@@ -268,6 +441,13 @@ void QThreadPoolPrivate::reset()
     auto allThreadsCopy = std::exchange(allThreads, {});
     expiredThreads.clear();
     waitingThreads.clear();
+    updateIdleThreads();
+
+    // the threads have no pending local tasks, or they would still be active
+    for (QThreadPoolThread *thread : std::as_const(allThreadsCopy)) {
+        if (thread->localQueue)
+            freeLocalQueues.append(std::exchange(thread->localQueue, nullptr));
+    }
 
     mutex.unlock();
 
@@ -310,6 +490,7 @@ void QThreadPoolPrivate::clear()
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
             QRunnable *r = page->pop();
+            taskDequeued(page);
             if (r && r->autoDelete()) {
                 locker.unlock();
                 delete r;
@@ -318,6 +499,18 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    const int count = localQueueCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolLocalQueue *localQueue = localQueues[i].load(std::memory_order_relaxed);
+        while (QRunnable *r = localQueue->steal()) {
+            if (r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
 }
 
 /*!
@@ -347,6 +540,7 @@ bool QThreadPool::tryTake(QRunnable *runnable)
     QMutexLocker locker(&d->mutex);
     for (QueuePage *page : std::as_const(d->queue)) {
         if (page->tryTake(runnable)) {
+            d->taskDequeued(page);
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
@@ -355,6 +549,12 @@ bool QThreadPool::tryTake(QRunnable *runnable)
         }
     }
 
+    const int count = d->localQueueCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (d->localQueues[i].load(std::memory_order_relaxed)->tryTake(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -457,6 +657,44 @@ QThreadPool::~QThreadPool()
     Q_ASSERT(d->allThreads.isEmpty());
 }
 
+/*! \property QThreadPool::workStealing
+    \brief whether tasks started from the pool's own threads are scheduled
+    on per-thread queues.
+    \since 6.8
+
+    By default, all tasks go through one queue shared by all threads of the
+    pool. With many cores and many small tasks that start further tasks, as
+    is common with Qt Concurrent, the lock protecting that queue becomes
+    contended.
+
+    When this property is \c true, a task started with the default priority
+    from one of the pool's threads is pushed onto a queue owned by that
+    thread, which takes it without locking once its current task is done.
+    Threads that run out of work take tasks from the other threads' queues.
+    Tasks started from other threads, or with a non-default priority, still
+    go through the shared queue, and tasks with a higher priority are still
+    run before the others.
+
+    Tasks on a thread's own queue are run in last-in, first-out order, so
+    tasks with the same priority are no longer guaranteed to start in the
+    order they were started in.
+
+    The default value is \c false.
+
+    \sa start()
+*/
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load(std::memory_order_relaxed);
+}
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled, std::memory_order_relaxed);
+}
+
 /*!
     Returns the global QThreadPool instance.
 */
@@ -507,6 +745,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->pushLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -107,6 +109,116 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+/*
+    Fixed-capacity Chase-Lev work-stealing deque, used in work-stealing mode.
+
+    Only the owning thread calls push() and pop(), which work on the bottom
+    end; other threads steal() from the top. Every claim (pop, steal or
+    tryTake) removes the entry by exchanging its slot with nullptr, so a
+    runnable is handed out exactly once even if tryTake() races with the
+    others, and push() never overwrites a slot that hasn't been claimed yet.
+*/
+class QThreadPoolLocalQueue
+{
+public:
+    enum {
+        Capacity = 1024
+    };
+
+    explicit QThreadPoolLocalQueue(int index) : m_index(index)
+    {
+        for (auto &entry : m_entries)
+            entry.store(nullptr, std::memory_order_relaxed);
+    }
+
+    int index() const { return m_index; }
+
+    qsizetype size() const
+    {
+        const qint64 b = m_bottom.load(std::memory_order_relaxed);
+        const qint64 t = m_top.load(std::memory_order_relaxed);
+        return b > t ? qsizetype(b - t) : 0;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    bool push(QRunnable *runnable)
+    {
+        Q_ASSERT(runnable != nullptr);
+        const qint64 b = m_bottom.load(std::memory_order_relaxed);
+        const qint64 t = m_top.load(std::memory_order_acquire);
+        std::atomic<QRunnable *> &entry = m_entries[b % Capacity];
+        if (b - t >= Capacity || entry.load(std::memory_order_relaxed))
+            return false;
+        entry.store(runnable, std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    QRunnable *pop()
+    {
+        for (;;) {
+            const qint64 b = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            qint64 t = m_top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            if (t == b) {
+                // last entry: race against stealers for it
+                const bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                               std::memory_order_relaxed);
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won)
+                    return nullptr;
+            }
+            if (QRunnable *runnable = m_entries[b % Capacity].exchange(nullptr, std::memory_order_acq_rel))
+                return runnable;
+            // taken by tryTake(), try the next one
+        }
+    }
+
+    QRunnable *steal()
+    {
+        for (;;) {
+            qint64 t = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const qint64 b = m_bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return nullptr;
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                return nullptr; // lost the race to another thief or the owner
+            }
+            if (QRunnable *runnable = m_entries[t % Capacity].exchange(nullptr, std::memory_order_acq_rel))
+                return runnable;
+        }
+    }
+
+    bool tryTake(QRunnable *runnable)
+    {
+        const qint64 t = m_top.load(std::memory_order_acquire);
+        const qint64 b = m_bottom.load(std::memory_order_acquire);
+        for (qint64 i = t; i < b; ++i) {
+            QRunnable *expected = runnable;
+            if (m_entries[i % Capacity].compare_exchange_strong(expected, nullptr,
+                                                                std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    int m_index;
+    alignas(64) std::atomic<qint64> m_top = 0;
+    alignas(64) std::atomic<qint64> m_bottom = 0;
+    std::atomic<QRunnable *> m_entries[Capacity];
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -115,6 +227,7 @@ class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 
 public:
     QThreadPoolPrivate();
+    ~QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
@@ -133,6 +246,19 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool pushLocalTask(QRunnable *runnable);
+    QRunnable *takeLocalTask(QThreadPoolLocalQueue *localQueue, QMutexLocker<QMutex> &locker);
+    bool hasStealableTasks() const;
+    void startHelperThreads(qsizetype count);
+    void restartExpiredThread(QRunnable *runnable);
+    QThreadPoolLocalQueue *acquireLocalQueue();
+    void updateIdleThreads() { idleThreads.store(int(waitingThreads.size()), std::memory_order_relaxed); }
+    void taskDequeued(const QueuePage *page)
+    {
+        if (page->priority() > 0)
+            queuedPriorityTasks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -149,6 +275,16 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // work-stealing mode: the local queues are only ever appended to, so that
+    // pool threads can scan them for work without holding the mutex
+    enum { MaxLocalQueues = 256 };
+    std::atomic<QThreadPoolLocalQueue *> localQueues[MaxLocalQueues] = {};
+    std::atomic<int> localQueueCount = 0;
+    QList<QThreadPoolLocalQueue *> freeLocalQueues;
+    std::atomic<int> idleThreads = 0;           // mirrors waitingThreads.size()
+    std::atomic<int> queuedPriorityTasks = 0;   // tasks in queue with priority > 0
+    std::atomic<bool> workStealing = false;
 };
 
 QT_END_NAMESPACE
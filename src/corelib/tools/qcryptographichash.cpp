@@ -10,6 +10,7 @@
 #include <qmutex.h>
 #include <qvarlengtharray.h>
 #include <private/qlocking_p.h>
+#include <private/qsimd_p.h>
 
 #include <array>
 #include <climits>
@@ -292,6 +293,267 @@ static constexpr bool useNonOpenSSLFallback(QCryptographicHash::Algorithm method
 }
 #endif // USING_OPENSSL30
 
+/*
+    Block-level drivers for SHA-1 and SHA-224/256.
+
+    The 3rdparty implementations process one 64-byte block per call (and
+    rfc6234 copies every input byte into its block buffer individually). The
+    functions below hand all complete blocks of the input to a single block
+    function instead, which uses the SHA extensions where the CPU has them.
+*/
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86) \
+    && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define QT_CRYPTOGRAPHICHASH_SHA_NI
+#  define QT_FUNCTION_TARGET_STRING_SHA_NI      QT_FUNCTION_TARGET_STRING_SHA "," QT_FUNCTION_TARGET_STRING_SSE4_1
+
+static bool hasShaExtensions() noexcept
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+
+QT_FUNCTION_TARGET(SHA_NI)
+static void sha1ProcessBlocksShaNi(Sha1State *state, const uchar *data, qsizetype blocks) noexcept
+{
+    // reverses the bytes of the whole register: W0 ends up in the top lane
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_set_epi32(state->h0, state->h1, state->h2, state->h3);
+    __m128i e0 = _mm_set_epi32(state->h4, 0, 0, 0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abcdSaved = abcd;
+        const __m128i e0Saved = e0;
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i));
+            msg[i] = _mm_shuffle_epi8(m, byteSwap);
+        }
+
+        // 20 groups of 4 rounds; msg[g % 4] holds W[4g .. 4g + 3] when group g runs.
+        // W[4g + 4 ..] = sha1msg2(sha1msg1(W[4g - 12 ..], W[4g - 8 ..]) ^ W[4g - 4 ..], W[4g ..])
+        // is computed over groups g - 2 to g.
+        __m128i e;
+#define SHA1_ROUNDS4(g) \
+        do { \
+            e = (g) ? _mm_sha1nexte_epu32(e0, msg[(g) & 3]) : _mm_add_epi32(e0, msg[0]); \
+            e0 = abcd; \
+            if ((g) >= 3 && (g) <= 18) \
+                msg[((g) + 1) & 3] = _mm_sha1msg2_epu32(msg[((g) + 1) & 3], msg[(g) & 3]); \
+            abcd = _mm_sha1rnds4_epu32(abcd, e, (g) / 5); \
+            if ((g) >= 1 && (g) <= 16) \
+                msg[((g) + 3) & 3] = _mm_sha1msg1_epu32(msg[((g) + 3) & 3], msg[(g) & 3]); \
+            if ((g) >= 2 && (g) <= 17) \
+                msg[((g) + 2) & 3] = _mm_xor_si128(msg[((g) + 2) & 3], msg[(g) & 3]); \
+        } while (false)
+
+        SHA1_ROUNDS4(0);  SHA1_ROUNDS4(1);  SHA1_ROUNDS4(2);  SHA1_ROUNDS4(3);  SHA1_ROUNDS4(4);
+        SHA1_ROUNDS4(5);  SHA1_ROUNDS4(6);  SHA1_ROUNDS4(7);  SHA1_ROUNDS4(8);  SHA1_ROUNDS4(9);
+        SHA1_ROUNDS4(10); SHA1_ROUNDS4(11); SHA1_ROUNDS4(12); SHA1_ROUNDS4(13); SHA1_ROUNDS4(14);
+        SHA1_ROUNDS4(15); SHA1_ROUNDS4(16); SHA1_ROUNDS4(17); SHA1_ROUNDS4(18); SHA1_ROUNDS4(19);
+#undef SHA1_ROUNDS4
+
+        e0 = _mm_sha1nexte_epu32(e0, e0Saved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    state->h0 = _mm_extract_epi32(abcd, 3);
+    state->h1 = _mm_extract_epi32(abcd, 2);
+    state->h2 = _mm_extract_epi32(abcd, 1);
+    state->h3 = _mm_extract_epi32(abcd, 0);
+    state->h4 = _mm_extract_epi32(e0, 3);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+QT_FUNCTION_TARGET(SHA_NI)
+static void sha256ProcessBlocksShaNi(uint32_t *hash, const uchar *data, qsizetype blocks) noexcept
+{
+    alignas(16) static constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    // swaps the bytes of each 32-bit word
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // sha256rnds2 operates on the state split as ABEF and CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash)), 0xb1);
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i));
+            msg[i] = _mm_shuffle_epi8(m, byteSwap);
+        }
+
+        // 16 groups of 4 rounds; msg[g % 4] holds W[4g .. 4g + 3] when group g runs
+        // and is then replaced with
+        // W[4g + 16 ..] = sha256msg2(sha256msg1(W[4g ..], W[4g + 4 ..]) + W[4g + 9 ..], W[4g + 12 ..])
+        __m128i wk;
+#define SHA256_ROUNDS4(g) \
+        do { \
+            wk = _mm_add_epi32(msg[(g) & 3], _mm_load_si128(reinterpret_cast<const __m128i *>(K + 4 * (g)))); \
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+            if ((g) < 12) { \
+                __m128i w = _mm_sha256msg1_epu32(msg[(g) & 3], msg[((g) + 1) & 3]); \
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[((g) + 3) & 3], msg[((g) + 2) & 3], 4)); \
+                msg[(g) & 3] = _mm_sha256msg2_epu32(w, msg[((g) + 3) & 3]); \
+            } \
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e)); \
+        } while (false)
+
+        SHA256_ROUNDS4(0);  SHA256_ROUNDS4(1);  SHA256_ROUNDS4(2);  SHA256_ROUNDS4(3);
+        SHA256_ROUNDS4(4);  SHA256_ROUNDS4(5);  SHA256_ROUNDS4(6);  SHA256_ROUNDS4(7);
+        SHA256_ROUNDS4(8);  SHA256_ROUNDS4(9);  SHA256_ROUNDS4(10); SHA256_ROUNDS4(11);
+        SHA256_ROUNDS4(12); SHA256_ROUNDS4(13); SHA256_ROUNDS4(14); SHA256_ROUNDS4(15);
+#undef SHA256_ROUNDS4
+
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1b);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash), _mm_blend_epi16(tmp, cdgh, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash + 4), _mm_alignr_epi8(cdgh, tmp, 8));
+}
+#endif // !QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#endif // QT_CRYPTOGRAPHICHASH_SHA_NI
+
+static void sha1ProcessBlocks(Sha1State *state, const uchar *data, qsizetype blocks) noexcept
+{
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+    if (hasShaExtensions())
+        return sha1ProcessBlocksShaNi(state, data, blocks);
+#endif
+    for ( ; blocks; --blocks, data += 64)
+        sha1ProcessChunk(state, data);
+}
+
+// like sha1Update(), but processes all complete blocks with one call
+static void sha1AddData(Sha1State *state, const uchar *data, qsizetype length) noexcept
+{
+    if (!length)
+        return;
+
+    const qsizetype buffered = qsizetype(state->messageSize & 63);
+    state->messageSize += length;
+    if (buffered + length < 64) {
+        memcpy(state->buffer + buffered, data, length);
+        return;
+    }
+    if (buffered) {
+        const qsizetype fill = 64 - buffered;
+        memcpy(state->buffer + buffered, data, fill);
+        sha1ProcessBlocks(state, state->buffer, 1);
+        data += fill;
+        length -= fill;
+    }
+    sha1ProcessBlocks(state, data, length / 64);
+    memcpy(state->buffer, data + (length & ~qsizetype(63)), length & 63);
+}
+
+// like sha1FinalizeState() followed by sha1ToHash()
+static void sha1Finalize(Sha1State *state, uchar *digest) noexcept
+{
+    static constexpr uchar padding[64] = { 0x80 };
+    uchar sizeInBits[8];
+    qToBigEndian(state->messageSize << 3, sizeInBits);
+
+    const qsizetype buffered = qsizetype(state->messageSize & 63);
+    sha1AddData(state, padding, (buffered < 56 ? 56 : 120) - buffered);
+    sha1AddData(state, sizeInBits, 8);
+    Q_ASSERT((state->messageSize & 63) == 0);
+    sha1ToHash(state, digest);
+}
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) && !QT_CONFIG(openssl_hash)
+static void sha224_256ProcessBlocks(SHA256Context *context, const uchar *data, qsizetype blocks) noexcept
+{
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+    if (hasShaExtensions())
+        return sha256ProcessBlocksShaNi(context->Intermediate_Hash, data, blocks);
+#endif
+    for ( ; blocks; --blocks, data += SHA256_Message_Block_Size) {
+        memcpy(context->Message_Block, data, SHA256_Message_Block_Size);
+        SHA224_256ProcessMessageBlock(context);
+    }
+}
+
+// like SHA224Input() and SHA256Input(), but processes all complete blocks with one call
+static void sha224_256AddData(SHA256Context *context, const uchar *data, qsizetype length) noexcept
+{
+    if (!length || context->Computed || context->Corrupted)
+        return;
+
+    const quint64 bits = quint64(context->Length_High) << 32 | context->Length_Low;
+    const quint64 newBits = bits + quint64(length) * 8;
+    if (newBits < bits) {
+        context->Corrupted = shaInputTooLong;
+        return;
+    }
+    context->Length_High = uint32_t(newBits >> 32);
+    context->Length_Low = uint32_t(newBits);
+
+    constexpr qsizetype BlockSize = SHA256_Message_Block_Size;
+    if (const qsizetype buffered = context->Message_Block_Index) {
+        const qsizetype fill = qMin(length, BlockSize - buffered);
+        memcpy(context->Message_Block + buffered, data, fill);
+        if (buffered + fill < BlockSize) {
+            context->Message_Block_Index = int_least16_t(buffered + fill);
+            return;
+        }
+        sha224_256ProcessBlocks(context, context->Message_Block, 1);
+        data += fill;
+        length -= fill;
+    }
+    const qsizetype blocks = length / BlockSize;
+    sha224_256ProcessBlocks(context, data, blocks);
+    data += blocks * BlockSize;
+    length -= blocks * BlockSize;
+    memcpy(context->Message_Block, data, length);
+    context->Message_Block_Index = int_least16_t(length);
+}
+
+// like SHA224Result() and SHA256Result()
+static void sha224_256Finalize(SHA256Context *context, uchar *digest, int hashSize) noexcept
+{
+    if (context->Computed || context->Corrupted) {
+        // leave the error handling to rfc6234
+        if (hashSize == SHA224HashSize)
+            SHA224Result(context, digest);
+        else
+            SHA256Result(context, digest);
+        return;
+    }
+
+    constexpr qsizetype BlockSize = SHA256_Message_Block_Size;
+    uchar *block = context->Message_Block;
+    qsizetype index = context->Message_Block_Index;
+    block[index++] = 0x80;
+    if (index > BlockSize - 8) {
+        memset(block + index, 0, BlockSize - index);
+        sha224_256ProcessBlocks(context, block, 1);
+        index = 0;
+    }
+    memset(block + index, 0, BlockSize - 8 - index);
+    qToBigEndian(context->Length_High, block + BlockSize - 8);
+    qToBigEndian(context->Length_Low, block + BlockSize - 4);
+    sha224_256ProcessBlocks(context, block, 1);
+
+    for (int i = 0; i < hashSize / 4; ++i)
+        qToBigEndian(context->Intermediate_Hash[i], digest + 4 * i);
+}
+#endif // !QT_CRYPTOGRAPHICHASH_ONLY_SHA1 && !QT_CONFIG(openssl_hash)
+
 class QCryptographicHashPrivate
 {
 public:
@@ -877,7 +1139,7 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
-            sha1Update(&sha1Context, (const unsigned char *)data, length);
+            sha1AddData(&sha1Context, reinterpret_cast<const uchar *>(data), length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
         default:
@@ -892,10 +1154,10 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
-            SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha224_256AddData(&sha224Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha256:
-            SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha224_256AddData(&sha256Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha384:
             SHA384Input(&sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -1061,8 +1323,7 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha1: {
         Sha1State copy = sha1Context;
         result.resizeForOverwrite(20);
-        sha1FinalizeState(&copy);
-        sha1ToHash(&copy, result.data());
+        sha1Finalize(&copy, result.data());
         break;
     }
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -1086,13 +1347,13 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha224: {
         SHA224Context copy = sha224Context;
         result.resizeForOverwrite(SHA224HashSize);
-        SHA224Result(&copy, result.data());
+        sha224_256Finalize(&copy, result.data(), SHA224HashSize);
         break;
     }
     case QCryptographicHash::Sha256: {
         SHA256Context copy = sha256Context;
         result.resizeForOverwrite(SHA256HashSize);
-        SHA256Result(&copy, result.data());
+        sha224_256Finalize(&copy, result.data(), SHA256HashSize);
         break;
     }
     case QCryptographicHash::Sha384: {
@@ -1198,6 +1459,75 @@ QByteArrayView QCryptographicHash::hashInto(QSpan<std::byte> buffer,
     return buffer.first(result.size());
 }
 
+/*!
+    \since 6.8
+
+    Returns the hashes of each of the \a messages using \a method, in the
+    order given.
+
+    This is equivalent to calling hash() for each message. The messages are
+    still hashed one after the other; the savings come from setting up a
+    single hashing context for all of them and reusing it, which matters
+    mostly for many short messages.
+
+    \sa hashManyInto(), hash()
+*/
+QByteArrayList QCryptographicHash::hashMany(QSpan<const QByteArrayView> messages, Algorithm method)
+{
+    const qsizetype length = hashLengthInternal(method);
+    QByteArray digests(length * messages.size(), Qt::Uninitialized);
+    if (hashManyInto(digests, messages, method).isNull())
+        return {};
+
+    QByteArrayList result;
+    result.reserve(messages.size());
+    for (qsizetype i = 0; i < messages.size(); ++i)
+        result.append(digests.sliced(i * length, length));
+    return result;
+}
+
+/*!
+    \since 6.8
+    \fn QCryptographicHash::hashManyInto(QSpan<char> buffer, QSpan<const QByteArrayView> messages, Algorithm method);
+    \fn QCryptographicHash::hashManyInto(QSpan<uchar> buffer, QSpan<const QByteArrayView> messages, Algorithm method);
+    \fn QCryptographicHash::hashManyInto(QSpan<std::byte> buffer, QSpan<const QByteArrayView> messages, Algorithm method);
+
+    Hashes each of the \a messages using \a method and stores the results
+    one after the other in \a buffer, without allocating memory for each of
+    them. The hash of message \c{i} starts at offset \c{i * hashLength(method)}.
+
+    Like hashMany(), this hashes the messages one after the other, reusing a
+    single hashing context.
+
+    The return value will be the sub-span of \a buffer holding all the
+    hashes, unless \a buffer is of insufficient size, in which case a null
+    QByteArrayView is returned.
+
+    \sa hashMany(), hashInto()
+*/
+QByteArrayView QCryptographicHash::hashManyInto(QSpan<std::byte> buffer,
+                                                QSpan<const QByteArrayView> messages,
+                                                Algorithm method) noexcept
+{
+    const qsizetype length = hashLengthInternal(method);
+    if (buffer.size() < length * messages.size())
+        return {}; // buffer too small
+
+    QCryptographicHashPrivate hash(method);
+    std::byte *out = buffer.data();
+    for (QByteArrayView message : messages) {
+        hash.addData(message);
+        hash.finalizeUnchecked(); // no mutex needed: no-one but us has access to 'hash'
+        const QByteArrayView result = hash.resultView();
+        if (result.size() != length)
+            return {}; // the backend failed to compute the hash
+        memcpy(out, result.data(), length);
+        out += length;
+        hash.reset();
+    }
+    return buffer.first(length * messages.size());
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -7,6 +7,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qbytearraylist.h>
 #include <QtCore/qobjectdefs.h>
 #include <QtCore/qspan.h>
 
@@ -105,6 +106,13 @@ public:
     { return hashInto(as_writable_bytes(buffer), data, method); }
     static QByteArrayView hashInto(QSpan<std::byte> buffer, QSpan<const QByteArrayView> data, Algorithm method) noexcept;
 
+    static QByteArrayList hashMany(QSpan<const QByteArrayView> messages, Algorithm method);
+    static QByteArrayView hashManyInto(QSpan<char> buffer, QSpan<const QByteArrayView> messages, Algorithm method) noexcept
+    { return hashManyInto(as_writable_bytes(buffer), messages, method); }
+    static QByteArrayView hashManyInto(QSpan<uchar> buffer, QSpan<const QByteArrayView> messages, Algorithm method) noexcept
+    { return hashManyInto(as_writable_bytes(buffer), messages, method); }
+    static QByteArrayView hashManyInto(QSpan<std::byte> buffer, QSpan<const QByteArrayView> messages, Algorithm method) noexcept;
+
     static int hashLength(Algorithm method);
     static bool supportsAlgorithm(Algorithm method);
 private:
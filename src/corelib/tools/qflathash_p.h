@@ -0,0 +1,695 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFLATHASH_P_H
+#define QFLATHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QFlatHash is an unordered associative container with the same API and
+  implicit sharing as QHash, implemented as an open-addressing hash table.
+
+  Instead of QHash's spans, which map each bucket to an entry through an
+  offset byte, QFlatHash keeps the nodes themselves in one array, next to an
+  array of control bytes with one byte per slot: 0x80 for an empty slot,
+  0xfe for a slot whose node was erased, or the lowest 7 bits of the hash of
+  the key stored in the slot. Lookups compare the control bytes of a group of
+  16 slots at a time with SSE2 or NEON against the 7 bits of the hash of the
+  key looked up, and only compare the keys of the (usually very few) slots
+  that match.
+
+  Like QHash, QFlatHash does not have stable references: inserting may
+  rehash, moving all the nodes. Erasing does not move any node, so erase()
+  can be used while iterating.
+*/
+
+namespace QFlatHashPrivate {
+
+enum : quint8 {
+    Empty = 0x80,
+    Deleted = 0xfe,
+    // anything with the high bit cleared is a full slot
+};
+
+constexpr size_t GroupSize = 16;
+
+// A set of slots in a group. With NEON, the comparison results are narrowed
+// to one nibble per slot, of which we keep a single bit.
+struct BitMask
+{
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    static constexpr int Shift = 2;
+#else
+    static constexpr int Shift = 0;
+#endif
+    quint64 bits;
+
+    explicit operator bool() const noexcept { return bits != 0; }
+    size_t lowest() const noexcept { return size_t(qCountTrailingZeroBits(bits) >> Shift); }
+    void clearLowest() noexcept { bits &= bits - 1; }
+    void clearBelow(size_t n) noexcept { bits &= ~quint64(0) << (n << Shift); }
+};
+
+struct Group
+{
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    static Group load(const quint8 *p) noexcept
+    { return { _mm_load_si128(reinterpret_cast<const __m128i *>(p)) }; }
+    static BitMask toMask(__m128i v) noexcept
+    { return { quint64(uint(_mm_movemask_epi8(v))) }; }
+
+    BitMask match(quint8 tag) const noexcept
+    { return toMask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(tag)))); }
+    BitMask matchEmpty() const noexcept
+    { return match(Empty); }
+    BitMask matchEmptyOrDeleted() const noexcept
+    { return toMask(ctrl); }
+    BitMask matchFull() const noexcept
+    { return { quint64(uint(_mm_movemask_epi8(ctrl)) ^ 0xffffu) }; }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    uint8x16_t ctrl;
+
+    static Group load(const quint8 *p) noexcept
+    { return { vld1q_u8(p) }; }
+    static BitMask toMask(uint8x16_t v) noexcept
+    {
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+        return { vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & Q_UINT64_C(0x8888888888888888) };
+    }
+
+    BitMask match(quint8 tag) const noexcept
+    { return toMask(vceqq_u8(ctrl, vdupq_n_u8(tag))); }
+    BitMask matchEmpty() const noexcept
+    { return match(Empty); }
+    BitMask matchEmptyOrDeleted() const noexcept
+    { return toMask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0))); }
+    BitMask matchFull() const noexcept
+    { return toMask(vcgeq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0))); }
+#else
+    const quint8 *ctrl;
+
+    static Group load(const quint8 *p) noexcept
+    { return { p }; }
+    template <typename Predicate> BitMask matchIf(Predicate p) const noexcept
+    {
+        quint64 bits = 0;
+        for (size_t i = 0; i < GroupSize; ++i)
+            bits |= quint64(p(ctrl[i])) << i;
+        return { bits };
+    }
+
+    BitMask match(quint8 tag) const noexcept
+    { return matchIf([tag](quint8 c) { return c == tag; }); }
+    BitMask matchEmpty() const noexcept
+    { return match(Empty); }
+    BitMask matchEmptyOrDeleted() const noexcept
+    { return matchIf([](quint8 c) { return (c & 0x80) != 0; }); }
+    BitMask matchFull() const noexcept
+    { return matchIf([](quint8 c) { return (c & 0x80) == 0; }); }
+#endif
+};
+
+template <typename Node>
+struct Data
+{
+    using Key = typename Node::KeyType;
+
+    QtPrivate::RefCount ref = {{1}};
+    size_t size = 0;
+    size_t numGroups = 0;       // always a power of two
+    size_t growthLeft = 0;      // number of empty slots we may still fill
+    size_t seed = 0;
+    quint8 *ctrl = nullptr;     // numGroups * GroupSize control bytes
+    Node *nodes = nullptr;      // numGroups * GroupSize slots, after the control bytes
+
+    static constexpr size_t Alignment = qMax(alignof(Node), size_t(GroupSize));
+    static constexpr size_t npos = ~size_t(0);
+
+    struct FindResult {
+        size_t index;
+        bool inserted;
+    };
+
+    size_t numSlots() const noexcept { return numGroups * GroupSize; }
+    // we fill up to 7/8 of the slots
+    static constexpr size_t capacityForSlots(size_t slotCount) noexcept { return slotCount - slotCount / 8; }
+    static size_t groupsForCapacity(size_t requestedCapacity)
+    {
+        size_t groups = 1;
+        while (capacityForSlots(groups * GroupSize) < requestedCapacity) {
+            if (groups > (std::numeric_limits<qptrdiff>::max)() / GroupSize / sizeof(Node) / 2) {
+                Q_CHECK_PTR(false);
+                Q_UNREACHABLE();    // no exceptions and no assertions -> no error reporting
+            }
+            groups *= 2;
+        }
+        return groups;
+    }
+    static size_t nodesOffset(size_t slotCount) noexcept
+    {
+        return (slotCount + alignof(Node) - 1) & ~(alignof(Node) - 1);
+    }
+
+    void allocate(size_t groups)
+    {
+        const size_t slotCount = groups * GroupSize;
+        void *p = ::operator new(nodesOffset(slotCount) + slotCount * sizeof(Node), std::align_val_t(Alignment));
+        numGroups = groups;
+        ctrl = static_cast<quint8 *>(p);
+        nodes = reinterpret_cast<Node *>(ctrl + nodesOffset(slotCount));
+        memset(ctrl, Empty, slotCount);
+        growthLeft = capacityForSlots(slotCount);
+    }
+    static void deallocate(quint8 *ctrl) noexcept
+    {
+        ::operator delete(ctrl, std::align_val_t(Alignment));
+    }
+
+    explicit Data(size_t reserve = 0)
+    {
+        allocate(groupsForCapacity(reserve));
+        seed = QHashSeed::globalSeed();
+    }
+    Data(const Data &other)
+        : size(other.size), seed(other.seed)
+    {
+        // keep the layout, so indexes into other stay valid in the copy
+        allocate(other.numGroups);
+        growthLeft = other.growthLeft;
+        const size_t slotCount = numSlots();
+        memcpy(ctrl, other.ctrl, slotCount);
+        for (size_t i = 0; i < slotCount; ++i) {
+            if (!(ctrl[i] & 0x80))
+                new (nodes + i) Node(other.nodes[i]);
+        }
+    }
+    Data(const Data &other, size_t reserved)
+        : seed(other.seed)
+    {
+        allocate(groupsForCapacity(qMax(other.size, reserved)));
+        const size_t slotCount = other.numSlots();
+        for (size_t i = 0; i < slotCount; ++i) {
+            if (!(other.ctrl[i] & 0x80)) {
+                const Node &n = other.nodes[i];
+                new (nodes + insertSlot(QHashPrivate::calculateHash(n.key, seed))) Node(n);
+            }
+        }
+    }
+    ~Data()
+    {
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            const size_t slotCount = numSlots();
+            for (size_t i = 0; i < slotCount; ++i) {
+                if (!(ctrl[i] & 0x80))
+                    nodes[i].~Node();
+            }
+        }
+        deallocate(ctrl);
+    }
+
+    static Data *detached(Data *d)
+    {
+        if (!d)
+            return new Data;
+        Data *dd = new Data(*d);
+        if (!d->ref.deref())
+            delete d;
+        return dd;
+    }
+    static Data *detached(Data *d, size_t size)
+    {
+        if (!d)
+            return new Data(size);
+        Data *dd = new Data(*d, size);
+        if (!d->ref.deref())
+            delete d;
+        return dd;
+    }
+
+    static quint8 tagForHash(size_t hash) noexcept { return quint8(hash & 0x7f); }
+    size_t firstGroupForHash(size_t hash) const noexcept { return (hash >> 7) & (numGroups - 1); }
+    // triangular probing visits every group once when numGroups is a power of two
+    size_t nextGroup(size_t group, size_t &step) const noexcept
+    { return (group + ++step) & (numGroups - 1); }
+
+    template <typename K> size_t findIndex(const K &key) const noexcept
+    {
+        return findIndex(key, QHashPrivate::calculateHash(key, seed));
+    }
+    template <typename K> size_t findIndex(const K &key, size_t hash) const noexcept
+    {
+        const quint8 tag = tagForHash(hash);
+        size_t group = firstGroupForHash(hash);
+        for (size_t step = 0; ; group = nextGroup(group, step)) {
+            const Group g = Group::load(ctrl + group * GroupSize);
+            for (BitMask m = g.match(tag); m; m.clearLowest()) {
+                const size_t index = group * GroupSize + m.lowest();
+                if (qHashEquals(nodes[index].key, key))
+                    return index;
+            }
+            // the key would have been stored here, if it existed
+            if (g.matchEmpty())
+                return npos;
+        }
+    }
+
+    // returns the first free slot for the hash and marks it as used
+    size_t insertSlot(size_t hash) noexcept
+    {
+        size_t group = firstGroupForHash(hash);
+        for (size_t step = 0; ; group = nextGroup(group, step)) {
+            if (const BitMask m = Group::load(ctrl + group * GroupSize).matchEmptyOrDeleted()) {
+                const size_t index = group * GroupSize + m.lowest();
+                if (ctrl[index] == Empty) {
+                    Q_ASSERT(growthLeft);
+                    --growthLeft;
+                }
+                ctrl[index] = tagForHash(hash);
+                ++size;
+                return index;
+            }
+        }
+    }
+
+    void rehash(size_t requestedCapacity = 0)
+    {
+        if (!requestedCapacity)
+            requestedCapacity = size;
+        const size_t oldSlotCount = numSlots();
+        quint8 * const oldCtrl = ctrl;
+        Node * const oldNodes = nodes;
+
+        allocate(groupsForCapacity(requestedCapacity));
+        size = 0;
+        for (size_t i = 0; i < oldSlotCount; ++i) {
+            if (oldCtrl[i] & 0x80)
+                continue;
+            Node &n = oldNodes[i];
+            new (nodes + insertSlot(QHashPrivate::calculateHash(n.key, seed))) Node(std::move(n));
+            n.~Node();
+        }
+        deallocate(oldCtrl);
+    }
+
+    // Finds the key or a slot for it. If the slot is new, the caller must
+    // construct the node in it.
+    template <typename K> FindResult findOrInsert(const K &key)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        const size_t index = findIndex(key, hash);
+        if (index != npos)
+            return { index, false };
+        if (!growthLeft) {
+            // the slots are taken by nodes or by the remains of erased ones:
+            // grow, or just clean up if at least half of them are erased
+            const size_t capacity = capacityForSlots(numSlots());
+            rehash(size * 2 >= capacity ? size * 2 : capacity);
+        }
+        return { insertSlot(hash), true };
+    }
+
+    bool shouldGrow() const noexcept { return growthLeft == 0; }
+
+    void erase(size_t index) noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        Q_ASSERT(!(ctrl[index] & 0x80));
+        nodes[index].~Node();
+        --size;
+        // If the group still has empty slots, no lookup ever probed past it,
+        // so the slot can become empty again. Otherwise, lookups must keep
+        // probing past it.
+        const size_t group = index & ~(GroupSize - 1);
+        if (Group::load(ctrl + group).matchEmpty()) {
+            ctrl[index] = Empty;
+            ++growthLeft;
+        } else {
+            ctrl[index] = Deleted;
+        }
+    }
+
+    size_t nextFull(size_t index) const noexcept
+    {
+        const size_t slotCount = numSlots();
+        while (index < slotCount) {
+            const size_t group = index & ~(GroupSize - 1);
+            BitMask m = Group::load(ctrl + group).matchFull();
+            m.clearBelow(index - group);
+            if (m)
+                return group + m.lowest();
+            index = group + GroupSize;
+        }
+        return slotCount;
+    }
+};
+
+} // namespace QFlatHashPrivate
+
+template <typename Key, typename T>
+class QFlatHash
+{
+    using Node = QHashPrivate::Node<Key, T>;
+    using Data = QFlatHashPrivate::Data<Node>;
+
+    Data *d = nullptr;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = T;
+    using size_type = qsizetype;
+    using difference_type = qsizetype;
+    using reference = T &;
+    using const_reference = const T &;
+
+    QFlatHash() noexcept = default;
+    inline QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+        : d(new Data(list.size()))
+    {
+        for (const auto &p : list)
+            insert(p.first, p.second);
+    }
+    QFlatHash(const QFlatHash &other) noexcept
+        : d(other.d)
+    {
+        if (d)
+            d->ref.ref();
+    }
+    QFlatHash(QFlatHash &&other) noexcept
+        : d(std::exchange(other.d, nullptr))
+    {
+    }
+    ~QFlatHash()
+    {
+        if (d && !d->ref.deref())
+            delete d;
+    }
+
+    QFlatHash &operator=(const QFlatHash &other) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d != other.d) {
+            Data *o = other.d;
+            if (o)
+                o->ref.ref();
+            if (d && !d->ref.deref())
+                delete d;
+            d = o;
+        }
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QFlatHash)
+    void swap(QFlatHash &other) noexcept { qt_ptr_swap(d, other.d); }
+
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator==(const QFlatHash &other) const
+    {
+        if (d == other.d)
+            return true;
+        if (size() != other.size())
+            return false;
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            const_iterator i = find(it.key());
+            if (i == end() || !i.node()->valuesEqual(it.node()))
+                return false;
+        }
+        // all values must be the same as size is the same
+        return true;
+    }
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator!=(const QFlatHash &other) const
+    { return !(*this == other); }
+
+    qsizetype size() const noexcept { return d ? qsizetype(d->size) : 0; }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return !d || d->size == 0; }
+
+    qsizetype capacity() const noexcept
+    { return d ? qsizetype(Data::capacityForSlots(d->numSlots())) : 0; }
+    void reserve(qsizetype size)
+    {
+        // reserve(0) is used in squeeze()
+        if (size && capacity() >= size)
+            return;
+        if (isDetached())
+            d->rehash(size_t(size));
+        else
+            d = Data::detached(d, size_t(size));
+    }
+    void squeeze()
+    {
+        if (capacity())
+            reserve(0);
+    }
+
+    void detach() { if (!d || d->ref.isShared()) d = Data::detached(d); }
+    bool isDetached() const noexcept { return d && !d->ref.isShared(); }
+    bool isSharedWith(const QFlatHash &other) const noexcept { return d == other.d; }
+
+    void clear() noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d && !d->ref.deref())
+            delete d;
+        d = nullptr;
+    }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+        Data *d = nullptr;
+        size_t index = 0;
+
+        iterator(Data *d, size_t index) noexcept : d(d), index(index) {}
+        Node *node() const noexcept { return d->nodes + index; }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+
+        constexpr iterator() noexcept = default;
+
+        const Key &key() const noexcept { return node()->key; }
+        T &value() const noexcept { return node()->value; }
+        T &operator*() const noexcept { return node()->value; }
+        T *operator->() const noexcept { return &node()->value; }
+        bool operator==(const iterator &o) const noexcept { return index == o.index && d == o.d; }
+        bool operator!=(const iterator &o) const noexcept { return !(*this == o); }
+
+        iterator &operator++() noexcept
+        {
+            index = d->nextFull(index + 1);
+            return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+    };
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+        const Data *d = nullptr;
+        size_t index = 0;
+
+        const_iterator(const Data *d, size_t index) noexcept : d(d), index(index) {}
+        const Node *node() const noexcept { return d->nodes + index; }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = const T *;
+        using reference = const T &;
+
+        constexpr const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : d(o.d), index(o.index) {}
+
+        const Key &key() const noexcept { return node()->key; }
+        const T &value() const noexcept { return node()->value; }
+        const T &operator*() const noexcept { return node()->value; }
+        const T *operator->() const noexcept { return &node()->value; }
+        bool operator==(const const_iterator &o) const noexcept { return index == o.index && d == o.d; }
+        bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+
+        const_iterator &operator++() noexcept
+        {
+            index = d->nextFull(index + 1);
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+    };
+
+    iterator begin() { detach(); return iterator(d, d->nextFull(0)); }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator constBegin() const noexcept
+    { return d ? const_iterator(d, d->nextFull(0)) : const_iterator(); }
+    iterator end() noexcept { return d ? iterator(d, d->numSlots()) : iterator(); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constEnd() const noexcept
+    { return d ? const_iterator(d, d->numSlots()) : const_iterator(); }
+
+    bool contains(const Key &key) const noexcept
+    {
+        return d && d->size && d->findIndex(key) != Data::npos;
+    }
+
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        if (isEmpty())
+            return end();
+        const size_t index = d->findIndex(key);
+        return index == Data::npos ? end() : const_iterator(d, index);
+    }
+    const_iterator find(const Key &key) const noexcept { return constFind(key); }
+    iterator find(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return end();
+        const size_t index = d->findIndex(key);
+        if (index == Data::npos)
+            return end();
+        detach(); // keeps the layout
+        return iterator(d, index);
+    }
+
+    T value(const Key &key) const noexcept
+    {
+        if (isEmpty())
+            return T();
+        const size_t index = d->findIndex(key);
+        return index == Data::npos ? T() : d->nodes[index].value;
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        if (isEmpty())
+            return defaultValue;
+        const size_t index = d->findIndex(key);
+        return index == Data::npos ? defaultValue : d->nodes[index].value;
+    }
+
+    const T operator[](const Key &key) const noexcept { return value(key); }
+    T &operator[](const Key &key)
+    {
+        const auto copy = isDetached() ? QFlatHash() : *this; // keep 'key' alive across the detach
+        detach();
+        const auto r = d->findOrInsert(key);
+        if (r.inserted)
+            Node::createInPlace(d->nodes + r.index, key, T());
+        return d->nodes[r.index].value;
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        return emplace(key, value);
+    }
+    template <typename ...Args>
+    iterator emplace(const Key &key, Args &&... args)
+    {
+        Key copy = key; // Needs to be explicit for MSVC 2019
+        return emplace(std::move(copy), std::forward<Args>(args)...);
+    }
+    template <typename ...Args>
+    iterator emplace(Key &&key, Args &&... args)
+    {
+        if (isDetached()) {
+            if (d->shouldGrow()) // Construct the value now so that no dangling references are used
+                return emplace_helper(std::move(key), T(std::forward<Args>(args)...));
+            return emplace_helper(std::move(key), std::forward<Args>(args)...);
+        }
+        // else: we must detach
+        const auto copy = *this; // keep 'args' alive across the detach/growth
+        detach();
+        return emplace_helper(std::move(key), std::forward<Args>(args)...);
+    }
+
+    bool remove(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return false;
+        const size_t index = d->findIndex(key);
+        if (index == Data::npos)
+            return false;
+        detach();
+        d->erase(index);
+        return true;
+    }
+    T take(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return T();
+        const size_t index = d->findIndex(key);
+        if (index == Data::npos)
+            return T();
+        detach();
+        T value = d->nodes[index].takeValue();
+        d->erase(index);
+        return value;
+    }
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it != constEnd());
+        detach();
+        d->erase(it.index);
+        return iterator(d, d->nextFull(it.index + 1));
+    }
+
+private:
+    template <typename ...Args>
+    iterator emplace_helper(Key &&key, Args &&... args)
+    {
+        const auto r = d->findOrInsert(key);
+        if (r.inserted)
+            Node::createInPlace(d->nodes + r.index, std::move(key), std::forward<Args>(args)...);
+        else
+            d->nodes[r.index].emplaceValue(std::forward<Args>(args)...);
+        return iterator(d, r.index);
+    }
+};
+
+template <typename Key, typename T>
+void swap(QFlatHash<Key, T> &lhs, QFlatHash<Key, T> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_P_H
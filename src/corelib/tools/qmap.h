@@ -21,6 +21,21 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QtPrivate {
+// Whether a QMap/QMultiMap<Key, T> can be searched with a K without
+// converting it to Key first. K must order exactly like Key(k) would, and
+// std::less<Key> must be transparent (see qstring.h and qbytearray.h).
+template <typename Key, typename K> struct QMapHeterogeneousSearch : std::false_type {};
+template <> struct QMapHeterogeneousSearch<QString, QStringView> : std::true_type {};
+template <> struct QMapHeterogeneousSearch<QString, QLatin1StringView> : std::true_type {};
+template <> struct QMapHeterogeneousSearch<QByteArray, QByteArrayView> : std::true_type {};
+
+#ifdef __cpp_concepts
+template <typename K, typename Key> concept QMapHeterogeneouslySearchableWith =
+        QMapHeterogeneousSearch<std::remove_cv_t<Key>, q20::remove_cvref_t<K>>::value;
+#endif
+} // namespace QtPrivate
+
 // common code shared between QMap and QMultimap
 template <typename AMap>
 class QMapData : public QSharedData
@@ -50,7 +65,8 @@ public:
 
     // used in remove(); copies from source all the values not matching key.
     // returns how many were NOT copied (removed).
-    size_type copyIfNotEquivalentTo(const Map &source, const Key &key)
+    template <typename K>
+    size_type copyIfNotEquivalentTo(const Map &source, const K &key)
     {
         Q_ASSERT(m.empty());
 
@@ -132,7 +148,8 @@ public:
         return result;
     }
 
-    size_type count(const Key &key) const
+    template <typename K>
+    size_type count(const K &key) const
     {
         return m.count(key);
     }
@@ -300,18 +317,7 @@ public:
 
     size_type remove(const Key &key)
     {
-        if (!d)
-            return 0;
-
-        if (!d.isShared())
-            return size_type(d->m.erase(key));
-
-        MapData *newData = new MapData;
-        size_type result = newData->copyIfNotEquivalentTo(d->m, key);
-
-        d.reset(newData);
-
-        return result;
+        return removeImpl(key);
     }
 
     template <typename Predicate>
@@ -322,29 +328,12 @@ public:
 
     T take(const Key &key)
     {
-        if (!d)
-            return T();
-
-        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
-        // TODO: improve. There is no need of copying all the
-        // elements (the one to be removed can be skipped).
-        detach();
-
-        auto i = d->m.find(key);
-        if (i != d->m.end()) {
-            T result(std::move(i->second));
-            d->m.erase(i);
-            return result;
-        }
-        return T();
+        return takeImpl(key);
     }
 
     bool contains(const Key &key) const
     {
-        if (!d)
-            return false;
-        auto i = d->m.find(key);
-        return i != d->m.end();
+        return containsImpl(key);
     }
 
     Key key(const T &value, const Key &defaultKey = Key()) const
@@ -357,22 +346,12 @@ public:
 
     T value(const Key &key, const T &defaultValue = T()) const
     {
-        if (!d)
-            return defaultValue;
-        const auto i = d->m.find(key);
-        if (i != d->m.cend())
-            return i->second;
-        return defaultValue;
+        return valueImpl(key, defaultValue);
     }
 
     T &operator[](const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
-        detach();
-        auto i = d->m.find(key);
-        if (i == d->m.end())
-            i = d->m.insert({key, T()}).first;
-        return i->second;
+        return operatorIndexImpl(key);
     }
 
     // CHANGE: return T, not const T!
@@ -404,9 +383,7 @@ public:
 
     size_type count(const Key &key) const
     {
-        if (!d)
-            return 0;
-        return d->count(key);
+        return countImpl(key);
     }
 
     size_type count() const
@@ -641,16 +618,12 @@ public:
 
     iterator find(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.find(key));
+        return findImpl(key);
     }
 
     const_iterator find(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.find(key));
+        return constFindImpl(key);
     }
 
     const_iterator constFind(const Key &key) const
@@ -660,30 +633,22 @@ public:
 
     iterator lowerBound(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.lower_bound(key));
+        return lowerBoundImpl(key);
     }
 
     const_iterator lowerBound(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.lower_bound(key));
+        return constLowerBoundImpl(key);
     }
 
     iterator upperBound(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.upper_bound(key));
+        return upperBoundImpl(key);
     }
 
     const_iterator upperBound(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.upper_bound(key));
+        return constUpperBoundImpl(key);
     }
 
     iterator insert(const Key &key, const T &value)
@@ -765,6 +730,138 @@ public:
     }
 
     std::pair<iterator, iterator> equal_range(const Key &akey)
+    {
+        return equal_range_impl(akey);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key &akey) const
+    {
+        return const_equal_range_impl(akey);
+    }
+
+private:
+    template <typename K> size_type removeImpl(const K &key)
+    {
+        if (!d)
+            return 0;
+
+        if (!d.isShared()) {
+            if constexpr (std::is_same_v<K, Key>) {
+                return size_type(d->m.erase(key));
+            } else {
+                // std::map::erase(const K &) is C++23
+                auto range = d->m.equal_range(key);
+                const auto result = size_type(std::distance(range.first, range.second));
+                d->m.erase(range.first, range.second);
+                return result;
+            }
+        }
+
+        MapData *newData = new MapData;
+        size_type result = newData->copyIfNotEquivalentTo(d->m, key);
+
+        d.reset(newData);
+
+        return result;
+    }
+
+    template <typename K> T takeImpl(const K &key)
+    {
+        if (!d)
+            return T();
+
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        // TODO: improve. There is no need of copying all the
+        // elements (the one to be removed can be skipped).
+        detach();
+
+        auto i = d->m.find(key);
+        if (i != d->m.end()) {
+            T result(std::move(i->second));
+            d->m.erase(i);
+            return result;
+        }
+        return T();
+    }
+
+    template <typename K> bool containsImpl(const K &key) const
+    {
+        if (!d)
+            return false;
+        auto i = d->m.find(key);
+        return i != d->m.end();
+    }
+
+    template <typename K> T valueImpl(const K &key, const T &defaultValue) const
+    {
+        if (!d)
+            return defaultValue;
+        const auto i = d->m.find(key);
+        if (i != d->m.cend())
+            return i->second;
+        return defaultValue;
+    }
+
+    template <typename K> T &operatorIndexImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        auto i = d->m.find(key);
+        if (i == d->m.end())
+            i = d->m.insert({Key(key), T()}).first;
+        return i->second;
+    }
+
+    template <typename K> size_type countImpl(const K &key) const
+    {
+        if (!d)
+            return 0;
+        return d->count(key);
+    }
+
+    template <typename K> iterator findImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.find(key));
+    }
+
+    template <typename K> const_iterator constFindImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.find(key));
+    }
+
+    template <typename K> iterator lowerBoundImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K> const_iterator constLowerBoundImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K> iterator upperBoundImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.upper_bound(key));
+    }
+
+    template <typename K> const_iterator constUpperBoundImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.upper_bound(key));
+    }
+
+    template <typename K> std::pair<iterator, iterator> equal_range_impl(const K &akey)
     {
         const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
         detach();
@@ -772,7 +869,8 @@ public:
         return {iterator(result.first), iterator(result.second)};
     }
 
-    std::pair<const_iterator, const_iterator> equal_range(const Key &akey) const
+    template <typename K>
+    std::pair<const_iterator, const_iterator> const_equal_range_impl(const K &akey) const
     {
         if (!d)
             return {};
@@ -780,6 +878,74 @@ public:
         return {const_iterator(result.first), const_iterator(result.second)};
     }
 
+public:
+#ifdef __cpp_concepts
+    size_type remove(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return removeImpl(key);
+    }
+    T take(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return takeImpl(key);
+    }
+    bool contains(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return containsImpl(key);
+    }
+    size_type count(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return countImpl(key);
+    }
+    T value(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key, const T &defaultValue = T()) const
+    {
+        return valueImpl(key, defaultValue);
+    }
+    T &operator[](const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return operatorIndexImpl(key);
+    }
+    T operator[](const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return value(key);
+    }
+    iterator find(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return findImpl(key);
+    }
+    const_iterator find(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constFindImpl(key);
+    }
+    const_iterator constFind(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return find(key);
+    }
+    iterator lowerBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return lowerBoundImpl(key);
+    }
+    const_iterator lowerBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constLowerBoundImpl(key);
+    }
+    iterator upperBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return upperBoundImpl(key);
+    }
+    const_iterator upperBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constUpperBoundImpl(key);
+    }
+    std::pair<iterator, iterator> equal_range(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return equal_range_impl(key);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return const_equal_range_impl(key);
+    }
+#endif // __cpp_concepts
+
 private:
 #ifdef Q_QDOC
     friend size_t qHash(const QMap &key, size_t seed = 0);
@@ -971,18 +1137,7 @@ public:
 
     size_type remove(const Key &key)
     {
-        if (!d)
-            return 0;
-
-        if (!d.isShared())
-            return size_type(d->m.erase(key));
-
-        MapData *newData = new MapData;
-        size_type result = newData->copyIfNotEquivalentTo(d->m, key);
-
-        d.reset(newData);
-
-        return result;
+        return removeImpl(key);
     }
 
     size_type remove(const Key &key, const T &value)
@@ -1045,10 +1200,7 @@ public:
 
     bool contains(const Key &key) const
     {
-        if (!d)
-            return false;
-        auto i = d->m.find(key);
-        return i != d->m.end();
+        return containsImpl(key);
     }
 
     bool contains(const Key &key, const T &value) const
@@ -1066,12 +1218,7 @@ public:
 
     T value(const Key &key, const T &defaultValue = T()) const
     {
-        if (!d)
-            return defaultValue;
-        const auto i = d->m.find(key);
-        if (i != d->m.cend())
-            return i->second;
-        return defaultValue;
+        return valueImpl(key, defaultValue);
     }
 
     QList<Key> keys() const
@@ -1112,18 +1259,12 @@ public:
 
     QList<T> values(const Key &key) const
     {
-        QList<T> result;
-        const auto range = equal_range(key);
-        result.reserve(std::distance(range.first, range.second));
-        std::copy(range.first, range.second, std::back_inserter(result));
-        return result;
+        return valuesImpl(key);
     }
 
     size_type count(const Key &key) const
     {
-        if (!d)
-            return 0;
-        return d->count(key);
+        return countImpl(key);
     }
 
     size_type count(const Key &key, const T &value) const
@@ -1371,16 +1512,12 @@ public:
 
     iterator find(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.find(key));
+        return findImpl(key);
     }
 
     const_iterator find(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.find(key));
+        return constFindImpl(key);
     }
 
     const_iterator constFind(const Key &key) const
@@ -1424,30 +1561,22 @@ public:
 
     iterator lowerBound(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.lower_bound(key));
+        return lowerBoundImpl(key);
     }
 
     const_iterator lowerBound(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.lower_bound(key));
+        return constLowerBoundImpl(key);
     }
 
     iterator upperBound(const Key &key)
     {
-        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
-        detach();
-        return iterator(d->m.upper_bound(key));
+        return upperBoundImpl(key);
     }
 
     const_iterator upperBound(const Key &key) const
     {
-        if (!d)
-            return const_iterator();
-        return const_iterator(d->m.upper_bound(key));
+        return constUpperBoundImpl(key);
     }
 
     iterator insert(const Key &key, const T &value)
@@ -1522,18 +1651,12 @@ public:
 
     std::pair<iterator, iterator> equal_range(const Key &akey)
     {
-        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
-        detach();
-        auto result = d->m.equal_range(akey);
-        return {iterator(result.first), iterator(result.second)};
+        return equal_range_impl(akey);
     }
 
     std::pair<const_iterator, const_iterator> equal_range(const Key &akey) const
     {
-        if (!d)
-            return {};
-        auto result = d->m.equal_range(akey);
-        return {const_iterator(result.first), const_iterator(result.second)};
+        return const_equal_range_impl(akey);
     }
 
     QMultiMap &unite(const QMultiMap &other)
@@ -1576,6 +1699,185 @@ public:
         *this = std::move(other);
         return *this;
     }
+
+private:
+    template <typename K> size_type removeImpl(const K &key)
+    {
+        if (!d)
+            return 0;
+
+        if (!d.isShared()) {
+            if constexpr (std::is_same_v<K, Key>) {
+                return size_type(d->m.erase(key));
+            } else {
+                // std::multimap::erase(const K &) is C++23
+                auto range = d->m.equal_range(key);
+                const auto result = size_type(std::distance(range.first, range.second));
+                d->m.erase(range.first, range.second);
+                return result;
+            }
+        }
+
+        MapData *newData = new MapData;
+        size_type result = newData->copyIfNotEquivalentTo(d->m, key);
+
+        d.reset(newData);
+
+        return result;
+    }
+
+    template <typename K> bool containsImpl(const K &key) const
+    {
+        if (!d)
+            return false;
+        auto i = d->m.find(key);
+        return i != d->m.end();
+    }
+
+    template <typename K> T valueImpl(const K &key, const T &defaultValue) const
+    {
+        if (!d)
+            return defaultValue;
+        const auto i = d->m.find(key);
+        if (i != d->m.cend())
+            return i->second;
+        return defaultValue;
+    }
+
+    template <typename K> QList<T> valuesImpl(const K &key) const
+    {
+        QList<T> result;
+        const auto range = const_equal_range_impl(key);
+        result.reserve(std::distance(range.first, range.second));
+        std::copy(range.first, range.second, std::back_inserter(result));
+        return result;
+    }
+
+    template <typename K> size_type countImpl(const K &key) const
+    {
+        if (!d)
+            return 0;
+        return d->count(key);
+    }
+
+    template <typename K> iterator findImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.find(key));
+    }
+
+    template <typename K> const_iterator constFindImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.find(key));
+    }
+
+    template <typename K> iterator lowerBoundImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K> const_iterator constLowerBoundImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K> iterator upperBoundImpl(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.upper_bound(key));
+    }
+
+    template <typename K> const_iterator constUpperBoundImpl(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.upper_bound(key));
+    }
+
+    template <typename K> std::pair<iterator, iterator> equal_range_impl(const K &akey)
+    {
+        const auto copy = d.isShared() ? *this : QMultiMap(); // keep `key` alive across the detach
+        detach();
+        auto result = d->m.equal_range(akey);
+        return {iterator(result.first), iterator(result.second)};
+    }
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator> const_equal_range_impl(const K &akey) const
+    {
+        if (!d)
+            return {};
+        auto result = d->m.equal_range(akey);
+        return {const_iterator(result.first), const_iterator(result.second)};
+    }
+
+public:
+#ifdef __cpp_concepts
+    size_type remove(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return removeImpl(key);
+    }
+    bool contains(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return containsImpl(key);
+    }
+    size_type count(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return countImpl(key);
+    }
+    T value(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key, const T &defaultValue = T()) const
+    {
+        return valueImpl(key, defaultValue);
+    }
+    QList<T> values(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return valuesImpl(key);
+    }
+    iterator find(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return findImpl(key);
+    }
+    const_iterator find(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constFindImpl(key);
+    }
+    const_iterator constFind(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return find(key);
+    }
+    iterator lowerBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return lowerBoundImpl(key);
+    }
+    const_iterator lowerBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constLowerBoundImpl(key);
+    }
+    iterator upperBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return upperBoundImpl(key);
+    }
+    const_iterator upperBound(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return constUpperBoundImpl(key);
+    }
+    std::pair<iterator, iterator> equal_range(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key)
+    {
+        return equal_range_impl(key);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const QtPrivate::QMapHeterogeneouslySearchableWith<Key> auto &key) const
+    {
+        return const_equal_range_impl(key);
+    }
+#endif // __cpp_concepts
 };
 
 Q_DECLARE_ASSOCIATIVE_ITERATOR(MultiMap)
@@ -594,6 +594,41 @@ void tst_QCoreApplication::processEventsAlwaysSendsPostedEvents()
     } while (t.elapsed() < 1000);
 }
 
+class CompressingApplication : public QCoreApplication
+{
+public:
+    using QCoreApplication::QCoreApplication;
+    int offeredMetaCalls = 0;
+
+protected:
+    bool compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents) override
+    {
+        if (event->type() == QEvent::MetaCall) {
+            // keep only the first queued call
+            ++offeredMetaCalls;
+            delete event;
+            return true;
+        }
+        return QCoreApplication::compressEvent(event, receiver, postedEvents);
+    }
+};
+
+void tst_QCoreApplication::compressQueuedMetaCalls()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    CompressingApplication app(argc, argv);
+
+    QObject receiver;
+    int calls = 0;
+    for (int i = 0; i < 3; ++i)
+        QMetaObject::invokeMethod(&receiver, [&] { ++calls; }, Qt::QueuedConnection);
+    QCoreApplication::processEvents();
+    QCOMPARE(calls, 1);
+    QCOMPARE(app.offeredMetaCalls, 2);
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 0);
+}
+
 #ifdef Q_OS_WIN
 void tst_QCoreApplication::sendPostedEventsInNativeLoop()
 {
@@ -26,6 +26,7 @@ private slots:
     void globalPostedEventsCount();
 #endif
     void processEventsAlwaysSendsPostedEvents();
+    void compressQueuedMetaCalls();
 #ifdef Q_OS_WIN
     void sendPostedEventsInNativeLoop();
 #endif
@@ -18,6 +18,13 @@ static bool glibDisabled = []() {
 }();
 #endif
 
+#ifdef ENABLE_EPOLL
+static bool epollEnabled = []() {
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    return true;
+}();
+#endif
+
 #include <chrono>
 
 #ifndef QTEST_THROW_ON_FAIL
@@ -26,6 +26,7 @@
 #include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QSemaphore>
 #include <QScopedPointer>
 #if QT_CONFIG(process)
 # include <QProcess>
@@ -70,6 +71,7 @@ private slots:
     void thread();
     void thread0();
     void moveToThread();
+    void queuedSignalsFromManyThreads();
     void senderTest();
     void declareInterface();
     void qpointerResetBeforeDestroyedSignal();
@@ -151,6 +153,8 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void coalescedConnection();
+    void metaCallEventPool();
     void objectNameBinding();
     void emitToDestroyedClass();
     void declarativeData();
@@ -2295,6 +2299,76 @@ signals:
     void theSignal();
 };
 
+class SequenceSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void sequence(int producer, int value);
+};
+
+class SequenceReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QHash<int, int> last;
+    int count = 0;
+    bool outOfOrder = false;
+
+public slots:
+    void receive(int producer, int value)
+    {
+        int &previous = last[producer];
+        if (value != previous + 1)
+            outOfOrder = true;
+        previous = value;
+        ++count;
+    }
+};
+
+void tst_QObject::queuedSignalsFromManyThreads()
+{
+    // queued signals emitted from several threads must all be delivered, in
+    // the order each thread emitted them, even if the receiver moves to
+    // another thread in the middle
+    constexpr int Producers = 4;
+    constexpr int SignalsPerProducer = 2000;
+
+    SequenceReceiver receiver;
+    SequenceSender senders[Producers];
+    for (SequenceSender &sender : senders) {
+        connect(&sender, &SequenceSender::sequence,
+                &receiver, &SequenceReceiver::receive, Qt::QueuedConnection);
+    }
+
+    QThread target;
+    target.start();
+
+    std::unique_ptr<QThread> producers[Producers];
+    for (int i = 0; i < Producers; ++i) {
+        producers[i].reset(QThread::create([sender = &senders[i], i] {
+            for (int value = 1; value <= SignalsPerProducer; ++value)
+                emit sender->sequence(i, value);
+        }));
+        producers[i]->start();
+    }
+
+    QTRY_VERIFY(receiver.count > 0);
+    receiver.moveToThread(&target);
+
+    for (const auto &producer : producers)
+        QVERIFY(producer->wait());
+
+    // the events posted before this one are delivered first
+    QThread *mainThread = QThread::currentThread();
+    QMetaObject::invokeMethod(&receiver, [&] { receiver.moveToThread(mainThread); },
+                              Qt::BlockingQueuedConnection);
+    target.quit();
+    QVERIFY(target.wait());
+
+    QCOMPARE(receiver.count, Producers * SignalsPerProducer);
+    QVERIFY(!receiver.outOfOrder);
+}
+
 void tst_QObject::senderTest()
 {
     {
@@ -8545,6 +8619,235 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::coalescedConnection()
+{
+    const auto type = Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection);
+
+    {
+        // emissions before the event loop runs result in one call with the latest arguments
+        SequenceSender sender;
+        QObject context;
+        QList<int> values;
+        connect(&sender, &SequenceSender::sequence, &context,
+                [&](int, int value) { values << value; }, type);
+
+        for (int value = 1; value <= 10; ++value)
+            emit sender.sequence(0, value);
+        QVERIFY(values.isEmpty());
+        QCoreApplication::processEvents();
+        QCOMPARE(values, QList<int>{10});
+
+        // once delivered, the next emission posts a new call
+        emit sender.sequence(0, 11);
+        emit sender.sequence(0, 12);
+        QCoreApplication::processEvents();
+        QCOMPARE(values, (QList<int>{10, 12}));
+    }
+
+    {
+        // string-based connection
+        SequenceSender sender;
+        SequenceReceiver receiver;
+        QVERIFY(connect(&sender, SIGNAL(sequence(int,int)), &receiver, SLOT(receive(int,int)), type));
+        emit sender.sequence(1, 1);
+        emit sender.sequence(1, 2);
+        emit sender.sequence(1, 3);
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.count, 1);
+        QCOMPARE(receiver.last.value(1), 3);
+    }
+
+    {
+        // non-trivial argument types are replaced, not leaked
+        QObject sender;
+        QObject context;
+        QStringList names;
+        connect(&sender, &QObject::objectNameChanged, &context,
+                [&](const QString &name) { names << name; }, type);
+        sender.setObjectName(u"first"_s);
+        sender.setObjectName(u"second"_s);
+        sender.setObjectName(u"third"_s);
+        QCoreApplication::processEvents();
+        QCOMPARE(names, QStringList{u"third"_s});
+    }
+
+    {
+        // event filters see the arguments of the pending event change only
+        // when the call is made, never while they look at them
+        struct ArgumentWatcher : QObject
+        {
+            SequenceSender *sender = nullptr;
+            QList<int> seen;
+            bool eventFilter(QObject *, QEvent *e) override
+            {
+                if (e->type() != QEvent::MetaCall)
+                    return false;
+                auto *ev = static_cast<QMetaCallEvent *>(e);
+                seen << *static_cast<const int *>(ev->args()[2]);
+                emit sender->sequence(0, 3);
+                seen << *static_cast<const int *>(ev->args()[2]);
+                return false;
+            }
+        };
+        SequenceSender sender;
+        QObject context;
+        ArgumentWatcher watcher;
+        watcher.sender = &sender;
+        context.installEventFilter(&watcher);
+        QList<int> values;
+        connect(&sender, &SequenceSender::sequence, &context,
+                [&](int, int value) { values << value; }, type);
+        emit sender.sequence(0, 1);
+        emit sender.sequence(0, 2);
+        QCoreApplication::processEvents();
+        QCOMPARE(watcher.seen, (QList<int>{1, 1}));
+        QCOMPARE(values, QList<int>{3});
+    }
+
+    {
+        // like other queued calls, the pending call survives disconnecting,
+        // but later emissions are not merged into it
+        SequenceSender sender;
+        QObject context;
+        QList<int> values;
+        QMetaObject::Connection c = connect(&sender, &SequenceSender::sequence, &context,
+                                            [&](int, int value) { values << value; }, type);
+        emit sender.sequence(0, 1);
+        emit sender.sequence(0, 2);
+        QVERIFY(QObject::disconnect(c));
+        emit sender.sequence(0, 3);
+        QCoreApplication::processEvents();
+        QCOMPARE(values, QList<int>{2});
+    }
+
+    {
+        // the receiver is destroyed with the call pending
+        SequenceSender sender;
+        auto context = std::make_unique<QObject>();
+        connect(&sender, &SequenceSender::sequence, context.get(), [] {}, type);
+        emit sender.sequence(0, 1);
+        context.reset();
+        emit sender.sequence(0, 2);
+        QCoreApplication::processEvents();
+    }
+
+    {
+        // emissions from another thread
+        constexpr int Emissions = 10000;
+        SequenceSender sender;
+        QObject context;
+        int calls = 0;
+        int lastValue = 0;
+        bool outOfOrder = false;
+        connect(&sender, &SequenceSender::sequence, &context, [&](int, int value) {
+            if (value <= lastValue)
+                outOfOrder = true;
+            lastValue = value;
+            ++calls;
+        }, Qt::ConnectionType(Qt::AutoConnection | Qt::CoalescedConnection));
+
+        std::unique_ptr<QThread> thread(QThread::create([&sender] {
+            for (int value = 1; value <= Emissions; ++value)
+                emit sender.sequence(0, value);
+        }));
+        thread->start();
+        while (!thread->isFinished())
+            QCoreApplication::processEvents();
+        QVERIFY(thread->wait());
+        QCoreApplication::processEvents();
+
+        QCOMPARE(lastValue, Emissions);
+        QVERIFY(calls <= Emissions);
+        QVERIFY(!outOfOrder);
+    }
+}
+
+void tst_QObject::metaCallEventPool()
+{
+#ifdef QT_BUILD_INTERNAL
+    SequenceSender sender;
+    SequenceReceiver receiver;
+    connect(&sender, &SequenceSender::sequence, &receiver, &SequenceReceiver::receive,
+            Qt::QueuedConnection);
+
+    {
+        // events are recycled by the thread that allocated them, small
+        // arguments are stored inside the event
+        const auto before = QMetaCallEvent::allocationCounters();
+        for (int round = 0; round < 2; ++round) {
+            for (int i = 1; i <= 10; ++i)
+                emit sender.sequence(round, i);
+            QCoreApplication::processEvents();
+        }
+        const auto after = QMetaCallEvent::allocationCounters();
+
+        QCOMPARE(receiver.count, 20);
+        QCOMPARE(after.allocated - before.allocated, 20u);
+        QVERIFY(after.reused - before.reused >= 10);
+        QCOMPARE(after.inlineArgs - before.inlineArgs, 40u);
+        QCOMPARE(after.heapArgs, before.heapArgs);
+    }
+
+    {
+        // events freed by the receiving thread are handed back to the
+        // thread that allocated them
+        QSemaphore processed;
+        QMetaCallEvent::AllocationCounters counters;
+        std::unique_ptr<QThread> thread(QThread::create([&] {
+            for (int round = 0; round < 2; ++round) {
+                for (int i = 1; i <= 10; ++i)
+                    emit sender.sequence(round + 2, i);
+                processed.acquire();
+            }
+            counters = QMetaCallEvent::allocationCounters();
+        }));
+        thread->start();
+        QTRY_COMPARE(receiver.count, 30);
+        processed.release();
+        QTRY_COMPARE(receiver.count, 40);
+        processed.release();
+        QVERIFY(thread->wait());
+
+        QCOMPARE(counters.allocated, 20u);
+        QCOMPARE(counters.returnedByOthers, 10u);
+        QCOMPARE(counters.reused, 10u);
+    }
+
+    {
+        // no more blocks than the pool caches are kept when taking those
+        // handed back all at once
+        constexpr int Emissions = 300; // more than the pool's 256 blocks
+        QSemaphore emitted;
+        QSemaphore processed;
+        QMetaCallEvent::AllocationCounters counters;
+        std::unique_ptr<QThread> thread(QThread::create([&] {
+            for (int round = 0; round < 2; ++round) {
+                for (int i = 1; i <= Emissions; ++i)
+                    emit sender.sequence(round + 4, i);
+                emitted.release();
+                processed.acquire();
+            }
+            counters = QMetaCallEvent::allocationCounters();
+        }));
+        thread->start();
+        emitted.acquire();
+        QTRY_COMPARE(receiver.count, 40 + Emissions);
+        processed.release();
+        emitted.acquire();
+        QTRY_COMPARE(receiver.count, 40 + 2 * Emissions);
+        processed.release();
+        QVERIFY(thread->wait());
+
+        QCOMPARE(counters.allocated, 2u * Emissions);
+        QCOMPARE(counters.returnedByOthers, quint64(Emissions));
+        QCOMPARE(counters.reused, 256u);
+    }
+    QVERIFY(!receiver.outOfOrder);
+#else
+    QSKIP("Needs QT_BUILD_INTERNAL");
+#endif
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
@@ -91,6 +91,8 @@ private slots:
     void noDoubleNotification();
     void groupedNotifications();
     void groupedNotificationConsistency();
+    void automaticUpdateGroups();
+    void bindingProfiler();
     void bindingGroupMovingBindingData();
     void bindingGroupBindingDeleted();
     void uninstalledBindingDoesNotEvaluate();
@@ -2242,6 +2244,108 @@ void tst_QProperty::groupedNotificationConsistency()
     QVERIFY(areEqual); // value changed runs after everything has been evaluated
 }
 
+void tst_QProperty::automaticUpdateGroups()
+{
+    QProperty<int> a(0);
+    QProperty<int> b(0);
+    QProperty<int> sum;
+    int evaluations = 0;
+    sum.setBinding([&] { ++evaluations; return a.value() + b.value(); });
+    int nNotifications = 0;
+    auto handler = sum.onValueChanged([&] { ++nNotifications; });
+    QCOMPARE(evaluations, 1);
+
+    struct Receiver : QObject
+    {
+        std::function<void()> handler;
+        bool event(QEvent *) override { handler(); return true; }
+    } receiver;
+
+    // writes are applied immediately when not enabled
+    receiver.handler = [&] {
+        a = 1;
+        QCOMPARE(sum.value(), 1);
+        b = 2;
+        QCOMPARE(sum.value(), 3);
+    };
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(evaluations, 3);
+    QCOMPARE(nNotifications, 2);
+
+    QtPrivate::setAutomaticPropertyUpdateGroups(true);
+    auto cleanup = qScopeGuard([] { QtPrivate::setAutomaticPropertyUpdateGroups(false); });
+
+    // writes during an event are batched until it has been delivered
+    receiver.handler = [&] {
+        a = 10;
+        b = 20;
+        QCOMPARE(evaluations, 3);
+        QCOMPARE(nNotifications, 2);
+    };
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(evaluations, 4);
+    QCOMPARE(nNotifications, 3);
+    QCOMPARE(sum.value(), 30);
+
+    // nested events join the group of the outermost one
+    receiver.handler = [&] {
+        a = 100;
+        QEvent nested(QEvent::User);
+        struct NestedReceiver : QObject
+        {
+            QProperty<int> *b;
+            bool event(QEvent *) override { *b = 200; return true; }
+        } nestedReceiver;
+        nestedReceiver.b = &b;
+        QCoreApplication::sendEvent(&nestedReceiver, &nested);
+        QCOMPARE(evaluations, 4);
+    };
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(evaluations, 5);
+    QCOMPARE(nNotifications, 4);
+    QCOMPARE(sum.value(), 300);
+
+    // outside of event delivery, nothing changes
+    a = 0;
+    QCOMPARE(evaluations, 6);
+    QCOMPARE(sum.value(), 200);
+}
+
+void tst_QProperty::bindingProfiler()
+{
+    QProperty<int> a(1);
+    QProperty<int> b;
+    b.setBinding([&] { return a.value() % 2; });
+    auto *binding = QPropertyBindingPrivate::get(b.binding());
+
+    QPropertyBindingProfiler::reset();
+    QCOMPARE(QPropertyBindingProfiler::statistics(binding).evaluations, 0u);
+
+    QPropertyBindingProfiler::setEnabled(true);
+    auto cleanup = qScopeGuard([] {
+        QPropertyBindingProfiler::setEnabled(false);
+        QPropertyBindingProfiler::reset();
+    });
+    int nNotifications = 0;
+    auto handler = b.onValueChanged([&] { ++nNotifications; });
+
+    a = 2; // changes b
+    a = 4; // does not
+    a = 5; // changes b
+    QCOMPARE(nNotifications, 2);
+
+    const auto statistics = QPropertyBindingProfiler::statistics(binding);
+    QCOMPARE(statistics.evaluations, 3u);
+    QCOMPARE(statistics.valueChanges, 2u);
+    QCOMPARE(statistics.observersNotified, 2u);
+    QVERIFY(statistics.evaluationTime.count() >= 0);
+
+    // statistics of destroyed bindings are dropped
+    b.takeBinding();
+    QCOMPARE(QPropertyBindingProfiler::statistics(binding).evaluations, 0u);
+}
+
 void tst_QProperty::bindingGroupMovingBindingData()
 {
     auto tester = std::make_unique<ClassWithNotifiedProperty>();
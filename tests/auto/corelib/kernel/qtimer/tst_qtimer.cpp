@@ -88,6 +88,8 @@ private slots:
     void timerOrder_data();
     void timerOrderBackgroundThread();
     void timerOrderBackgroundThread_data() { timerOrder_data(); }
+    void manyTimersOrder_data();
+    void manyTimersOrder();
 
     void dontBlockEvents();
     void postedEventsShouldNotStarveTimers();
@@ -1513,6 +1515,52 @@ void tst_QTimer::timerOrderBackgroundThread()
     delete thread;
 }
 
+void tst_QTimer::manyTimersOrder_data()
+{
+    QTest::addColumn<Qt::TimerType>("timerType");
+    QTest::newRow("precise") << Qt::PreciseTimer;
+    QTest::newRow("coarse") << Qt::CoarseTimer;
+}
+
+void tst_QTimer::manyTimersOrder()
+{
+    QFETCH(Qt::TimerType, timerType);
+
+    // intervals from 0 to 190 ms, so that the timers end up in different
+    // levels of the timer wheel, started in a scrambled order
+    constexpr int TimerCount = 400;
+    QList<int> fired;
+    QList<QTimer *> timers;
+    for (int i = 0; i < TimerCount; ++i) {
+        const int index = (i * 7) % TimerCount;
+        auto timer = new QTimer(this);
+        timer->setSingleShot(true);
+        timer->setTimerType(timerType);
+        timer->setInterval((index % 20) * 10ms);
+        connect(timer, &QTimer::timeout, this, [&fired, index] { fired.append(index); });
+        timers.append(timer);
+    }
+    for (QTimer *timer : std::as_const(timers))
+        timer->start();
+
+    QTRY_COMPARE(fired.size(), TimerCount);
+    qDeleteAll(timers);
+
+    // timers with a shorter interval fire first, the others in the order they
+    // were started in
+    QList<int> expected;
+    for (int i = 0; i < TimerCount; ++i)
+        expected.append((i * 7) % TimerCount);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](int a, int b) { return a % 20 < b % 20; });
+    if (timerType == Qt::CoarseTimer) {
+        // coarse timers may be moved to a common boundary
+        std::sort(fired.begin(), fired.end());
+        std::sort(expected.begin(), expected.end());
+    }
+    QCOMPARE(fired, expected);
+}
+
 struct StaticSingleShotUser
 {
     StaticSingleShotUser()
@@ -125,6 +125,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void vectorBlockBoundaries();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -3235,6 +3236,46 @@ void tst_QtJson::nesting()
 
 }
 
+void tst_QtJson::vectorBlockBoundaries()
+{
+    // the parser scans whitespace and strings in blocks of 16 bytes; put
+    // the interesting bytes at every offset around the block boundaries
+    struct Special { const char *json; QString decoded; };
+    const Special specials[] = {
+        { "\\\"", QStringLiteral("\"") },
+        { "\\n", QStringLiteral("\n") },
+        { "\\u00e9", QStringLiteral("\u00e9") },
+        { "\xc3\xa9", QStringLiteral("\u00e9") },
+        { "\xe2\x82\xac", QStringLiteral("\u20ac") },
+    };
+    for (const Special &special : specials) {
+        for (int length = 0; length < 40; ++length) {
+            for (int at = 0; at <= length; ++at) {
+                const QByteArray json = "[" + QByteArray(length, ' ') + "\""
+                        + QByteArray(at, 'a') + special.json + QByteArray(length - at, 'b')
+                        + "\"" + QByteArray(at, '\n') + "]";
+                QJsonParseError error;
+                const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+                QCOMPARE(error.error, QJsonParseError::NoError);
+                const QString expected = QString(at, u'a') + special.decoded
+                        + QString(length - at, u'b');
+                QCOMPARE(doc.array().at(0).toString(), expected);
+            }
+        }
+    }
+
+    // an unterminated string or invalid UTF-8 must be found after any
+    // number of plain bytes
+    for (int length = 0; length < 40; ++length) {
+        QJsonParseError error;
+        QJsonDocument::fromJson("[\"" + QByteArray(length, 'a'), &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+        QJsonDocument::fromJson("[\"" + QByteArray(length, 'a') + "\xff\"]", &error);
+        QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+        QCOMPARE(error.offset, length + 2);
+    }
+}
+
 void tst_QtJson::longStrings()
 {
     // test around 15 and 16 bit boundaries, as these are limits
@@ -0,0 +1,610 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QCborValueView>
+#include <QTest>
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QThread>
+
+#include <limits>
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCborValueView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars_data();
+    void scalars();
+    void strings();
+    void chunkedStrings();
+    void tags();
+    void sameAsQCborValue_data();
+    void sameAsQCborValue();
+    void arrays();
+    void indefiniteContainers();
+    void mapLookup_data();
+    void mapLookup();
+    void nonCanonicalKeys();
+    void duplicateKeys();
+    void copiesShareIndex();
+    void indexFromThreads();
+    void malformed_data();
+    void malformed();
+    void truncated();
+    void deepNesting();
+};
+
+static QByteArray bytes(std::initializer_list<uchar> list)
+{
+    return QByteArray(reinterpret_cast<const char *>(std::data(list)), qsizetype(list.size()));
+}
+
+// Compares the view with the decoded value, recursively.
+static void compare(QCborValueView view, const QCborValue &value)
+{
+    if (value.isTag() || value.type() >= QCborValue::DateTime) {
+        QVERIFY(view.isTag());
+        QCOMPARE(view.tag(), value.tag());
+        compare(view.taggedValue(), value.taggedValue());
+        return;
+    }
+
+    QCOMPARE(view.type(), value.type());
+    switch (value.type()) {
+    case QCborValue::Integer:
+        QCOMPARE(view.toInteger(), value.toInteger());
+        break;
+    case QCborValue::Double:
+        QCOMPARE(view.toDouble(), value.toDouble());
+        break;
+    case QCborValue::ByteArray:
+        QCOMPARE(view.toByteArray(), value.toByteArray());
+        break;
+    case QCborValue::String:
+        QCOMPARE(view.toString(), value.toString());
+        break;
+    case QCborValue::Array: {
+        const QCborArray array = value.toArray();
+        const QCborArrayView arrayView = view.toArray();
+        QCOMPARE(arrayView.size(), array.size());
+        qsizetype i = 0;
+        for (QCborValueView element : arrayView) {
+            QVERIFY(i < array.size());
+            compare(element, array.at(i));
+            if (QTest::currentTestFailed())
+                return;
+            compare(arrayView.at(i), array.at(i));
+            if (QTest::currentTestFailed())
+                return;
+            ++i;
+        }
+        QCOMPARE(i, array.size());
+        break;
+    }
+    case QCborValue::Map: {
+        const QCborMap map = value.toMap();
+        const QCborMapView mapView = view.toMap();
+        QCOMPARE(mapView.size(), map.size());
+        qsizetype i = 0;
+        for (auto [key, element] : mapView) {
+            compare(key, map.keys().at(i));
+            if (QTest::currentTestFailed())
+                return;
+            compare(element, map.value(map.keys().at(i)));
+            if (QTest::currentTestFailed())
+                return;
+            if (key.isInteger())
+                compare(mapView.value(key.toInteger()), map.value(key.toInteger()));
+            else if (key.isString())
+                compare(mapView.value(key.toString()), map.value(key.toString()));
+            if (QTest::currentTestFailed())
+                return;
+            ++i;
+        }
+        QCOMPARE(i, map.size());
+        break;
+    }
+    default:
+        QCOMPARE(view.toSimpleType(), value.toSimpleType());
+        break;
+    }
+}
+
+void tst_QCborValueView::scalars_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QCborValue>("expected");
+
+    QTest::newRow("0") << bytes({ 0x00 }) << QCborValue(0);
+    QTest::newRow("23") << bytes({ 0x17 }) << QCborValue(23);
+    QTest::newRow("24") << bytes({ 0x18, 0x18 }) << QCborValue(24);
+    QTest::newRow("1000") << bytes({ 0x19, 0x03, 0xe8 }) << QCborValue(1000);
+    QTest::newRow("1000000") << bytes({ 0x1a, 0x00, 0x0f, 0x42, 0x40 }) << QCborValue(1000000);
+    QTest::newRow("int64-max") << bytes({ 0x1b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff })
+                               << QCborValue(std::numeric_limits<qint64>::max());
+    QTest::newRow("uint64-max") << bytes({ 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff })
+                                << QCborValue(18446744073709551615.);
+    QTest::newRow("-1") << bytes({ 0x20 }) << QCborValue(-1);
+    QTest::newRow("-1000") << bytes({ 0x39, 0x03, 0xe7 }) << QCborValue(-1000);
+    QTest::newRow("int64-min") << bytes({ 0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff })
+                               << QCborValue(std::numeric_limits<qint64>::min());
+    QTest::newRow("-2^64") << bytes({ 0x3b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff })
+                           << QCborValue(-18446744073709551616.);
+    QTest::newRow("half") << bytes({ 0xf9, 0x3c, 0x00 }) << QCborValue(1.0);
+    QTest::newRow("half-inf") << bytes({ 0xf9, 0x7c, 0x00 }) << QCborValue(qInf());
+    QTest::newRow("float") << bytes({ 0xfa, 0x47, 0xc3, 0x50, 0x00 }) << QCborValue(100000.0);
+    QTest::newRow("double") << bytes({ 0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a })
+                            << QCborValue(1.1);
+    QTest::newRow("false") << bytes({ 0xf4 }) << QCborValue(false);
+    QTest::newRow("true") << bytes({ 0xf5 }) << QCborValue(true);
+    QTest::newRow("null") << bytes({ 0xf6 }) << QCborValue(nullptr);
+    QTest::newRow("undefined") << bytes({ 0xf7 }) << QCborValue();
+    QTest::newRow("simple-16") << bytes({ 0xf0 }) << QCborValue(QCborSimpleType(16));
+    QTest::newRow("simple-255") << bytes({ 0xf8, 0xff }) << QCborValue(QCborSimpleType(255));
+}
+
+void tst_QCborValueView::scalars()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QCborValue, expected);
+
+    const QCborValueView view(data);
+    compare(view, expected);
+    QCOMPARE(view.toCborValue(), QCborValue::fromCbor(data));
+    QCOMPARE(view.encoded().toByteArray(), data);
+
+    QCOMPARE(view.isInteger(), expected.isInteger());
+    QCOMPARE(view.isDouble(), expected.isDouble());
+    QCOMPARE(view.isBool(), expected.isBool());
+    QCOMPARE(view.toBool(true), expected.isBool() ? expected.toBool() : true);
+    QCOMPARE(view.isSimpleType(), expected.isSimpleType());
+    QCOMPARE(view.isNull(), expected.isNull());
+    QCOMPARE(view.isUndefined(), expected.isUndefined());
+    if (!expected.isInteger())
+        QCOMPARE(view.toInteger(-42), -42);
+    if (expected.isInteger())
+        QCOMPARE(view.toDouble(), double(expected.toInteger()));
+    QVERIFY(view.toArray().isEmpty());
+    QVERIFY(view.toMap().isEmpty());
+    QCOMPARE(view.toString(u"default"_s), u"default"_s);
+
+    // trailing data is ignored
+    const QCborValueView withTrailer(data + bytes({ 0x01, 0x02 }));
+    QCOMPARE(withTrailer.type(), view.type());
+    QCOMPARE(withTrailer.encoded().toByteArray(), data);
+}
+
+void tst_QCborValueView::strings()
+{
+    const QByteArray data = QCborArray{ u"héllo"_s, QByteArray("\x00\x01\xff", 3), u""_s }.toCborValue().toCbor();
+    const QCborArrayView array = QCborValueView(data).toArray();
+    QCOMPARE(array.size(), 3);
+
+    const QCborValueView text = array.at(0);
+    QVERIFY(text.isString());
+    QCOMPARE(text.toString(), u"héllo"_s);
+    QCOMPARE(text.toUtf8StringView(), u8"héllo");
+    // zero-copy: the view points into the data
+    QVERIFY(text.toUtf8StringView().data() >= data.constData());
+    QVERIFY(text.toUtf8StringView().data() < data.constData() + data.size());
+    QVERIFY(text.toByteArrayView().isNull());
+    QCOMPARE(text.toByteArray("x"), "x");
+
+    const QCborValueView binary = array.at(1);
+    QVERIFY(binary.isByteArray());
+    QCOMPARE(binary.toByteArray(), QByteArray("\x00\x01\xff", 3));
+    QCOMPARE(binary.toByteArrayView().toByteArray(), QByteArray("\x00\x01\xff", 3));
+    QVERIFY(binary.toUtf8StringView().isNull());
+    QCOMPARE(binary.toString(u"x"_s), u"x"_s);
+
+    const QCborValueView empty = array.at(2);
+    QVERIFY(empty.isString());
+    QVERIFY(empty.toString().isEmpty());
+    QVERIFY(!empty.toUtf8StringView().isNull());
+    QVERIFY(empty.toUtf8StringView().isEmpty());
+}
+
+void tst_QCborValueView::chunkedStrings()
+{
+    // "ab" "c" as text and as bytes, then an empty chunked string
+    const QByteArray data = bytes({ 0x83, 0x7f, 0x62, 'a', 'b', 0x61, 'c', 0xff,
+                                    0x5f, 0x42, 'a', 'b', 0x41, 'c', 0xff,
+                                    0x7f, 0xff });
+    const QCborArrayView array = QCborValueView(data).toArray();
+    QCOMPARE(array.at(0).toString(), u"abc"_s);
+    QVERIFY(array.at(0).toUtf8StringView().isNull());
+    QCOMPARE(array.at(1).toByteArray(), "abc");
+    QVERIFY(array.at(1).toByteArrayView().isNull());
+    QVERIFY(array.at(2).isString());
+    QVERIFY(array.at(2).toString().isEmpty());
+    QCOMPARE(QCborValueView(data).toCborValue(), QCborValue::fromCbor(data));
+
+    // chunks must have the type of the string and a definite length
+    QCOMPARE(QCborValueView(bytes({ 0x7f, 0x41, 'a', 0xff })).toString(u"x"_s), u"x"_s);
+    QCOMPARE(QCborValueView(bytes({ 0x7f, 0x7f, 0xff, 0xff })).toString(u"x"_s), u"x"_s);
+    QVERIFY(QCborValueView(bytes({ 0x7f, 0x61, 'a' })).encoded().isEmpty());
+}
+
+void tst_QCborValueView::tags()
+{
+    const QByteArray data = QCborValue(QCborTag(1234), QCborArray{ 1, 2 }).toCbor();
+    const QCborValueView view(data);
+    QVERIFY(view.isTag());
+    QCOMPARE(view.tag(), QCborTag(1234));
+    QCOMPARE(view.taggedValue().toArray().at(1).toInteger(), 2);
+    QCOMPARE(view.toCborValue(), QCborValue::fromCbor(data));
+
+    QCOMPARE(QCborValueView(bytes({ 0x01 })).tag(), QCborTag(-1));
+    QVERIFY(QCborValueView(bytes({ 0x01 })).taggedValue().isInvalid());
+
+    // extended types of QCborValue are plain tags here
+    const QByteArray dateTime = QCborValue(QDateTime::fromSecsSinceEpoch(0, QTimeZone::UTC)).toCbor();
+    QCOMPARE(QCborValueView(dateTime).type(), QCborValue::Tag);
+    QCOMPARE(QCborValueView(dateTime).tag(), QCborTag(QCborKnownTags::DateTimeString));
+    QCOMPARE(QCborValueView(dateTime).taggedValue().toString(), u"1970-01-01T00:00:00.000Z"_s);
+}
+
+void tst_QCborValueView::sameAsQCborValue_data()
+{
+    QTest::addColumn<QCborValue>("value");
+
+    QCborMap large;
+    QCborArray largeArray;
+    for (int i = 0; i < 200; ++i) {
+        large.insert(u"key %1"_s.arg(i), QCborArray{ i, u"value %1"_s.arg(i) });
+        large.insert(i - 100, i * 0.5);
+        largeArray.append(QCborMap{ { u"index"_s, i } });
+    }
+
+    QTest::newRow("empty-array") << QCborValue(QCborArray());
+    QTest::newRow("empty-map") << QCborValue(QCborMap());
+    QTest::newRow("mixed") << QCborValue(QCborArray{
+            1, -2, 3.5, true, false, nullptr, QCborValue(), u"text"_s, QByteArray("bytes"),
+            QCborArray{ QCborArray{}, QCborMap{} },
+            QCborMap{ { 1, u"one"_s }, { u"two"_s, 2 }, { -3, QCborArray{ 3 } } } });
+    QTest::newRow("large-map") << QCborValue(large);
+    QTest::newRow("large-array") << QCborValue(largeArray);
+}
+
+void tst_QCborValueView::sameAsQCborValue()
+{
+    QFETCH(QCborValue, value);
+
+    const QByteArray data = value.toCbor();
+    const QCborValueView view(data);
+    compare(view, value);
+    QCOMPARE(view.toCborValue(), value);
+    QCOMPARE(view.encoded().size(), data.size());
+}
+
+void tst_QCborValueView::arrays()
+{
+    QCborArray array;
+    for (int i = 0; i < 100; ++i)
+        array.append(i * 3);
+    const QByteArray data = QCborValue(array).toCbor();
+    const QCborArrayView view = QCborValueView(data).toArray();
+
+    QCOMPARE(view.size(), 100);
+    QVERIFY(!view.isEmpty());
+    QCOMPARE(view.first().toInteger(), 0);
+    // first a few elements without the index, then with it
+    QCOMPARE(view.at(5).toInteger(), 15);
+    QCOMPARE(view[99].toInteger(), 297);
+    QCOMPARE(view.at(50).toInteger(), 150);
+    QCOMPARE(view.at(5).toInteger(), 15);
+    QVERIFY(view.at(100).isInvalid());
+    QVERIFY(view.at(-1).isInvalid());
+
+    const QCborArrayView small = QCborValueView(QCborValue(QCborArray{ 1 }).toCbor()).toArray();
+    QVERIFY(small.at(1).isInvalid());
+
+    const QCborArrayView empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QVERIFY(empty.at(0).isInvalid());
+    QVERIFY(empty.begin() == empty.end());
+}
+
+void tst_QCborValueView::indefiniteContainers()
+{
+    // [_ 1, {_ "a": 2, 3: [_ ]}, 4]
+    QByteArray data = bytes({ 0x9f, 0x01, 0xbf, 0x61, 'a', 0x02, 0x03, 0x9f, 0xff, 0xff, 0x04, 0xff });
+    const QCborValueView view(data);
+    QCOMPARE(view.encoded().size(), data.size());
+    compare(view, QCborValue::fromCbor(data));
+
+    const QCborArrayView array = view.toArray();
+    QCOMPARE(array.size(), 3);
+    QCOMPARE(array.at(2).toInteger(), 4);
+    const QCborMapView map = array.at(1).toMap();
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(map.value(u"a").toInteger(), 2);
+    QVERIFY(map.value(3).toArray().isEmpty());
+    QCOMPARE(map.value(3).toArray().size(), 0);
+
+    // an indefinite-length array with more elements than the linear search covers
+    data = bytes({ 0x9f });
+    for (int i = 0; i < 20; ++i)
+        data += char(i);
+    data += char(0xff);
+    QCOMPARE(QCborValueView(data).toArray().at(15).toInteger(), 15);
+    QCOMPARE(QCborValueView(data).toArray().size(), 20);
+}
+
+void tst_QCborValueView::mapLookup_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("small") << 5;
+    QTest::newRow("large") << 500;
+}
+
+void tst_QCborValueView::mapLookup()
+{
+    QFETCH(int, count);
+
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    writer.startMap(2 * count + 2);
+    for (int i = 0; i < count; ++i) {
+        writer.append(i * 1000 - 1000);
+        writer.append(i);
+        writer.append(u"key-%1"_s.arg(i));
+        writer.append(i);
+    }
+    writer.append("caf\xe9"_L1);
+    writer.append("latin1"_L1);
+    writer.append(QStringView(u"€"));
+    writer.append("utf16"_L1);
+    writer.endMap();
+    const QCborMapView view = QCborValueView(data).toMap();
+
+    QCOMPARE(view.size(), 2 * count + 2);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(view.value(i * 1000 - 1000).toInteger(), i);
+        QCOMPARE(view[u"key-%1"_s.arg(i)].toInteger(), i);
+        QCOMPARE(view.value(u"key-%1"_s.arg(i).toUtf8()).toInteger(), i);
+        QCOMPARE(view.value(u"key-%1"_s.arg(i).toLatin1()).toInteger(), i);
+    }
+    QCOMPARE(view.value("caf\xe9"_L1).toString(), u"latin1"_s);
+    QCOMPARE(view.value(u"café").toString(), u"latin1"_s);
+    QCOMPARE(view.value(u8"café").toString(), u"latin1"_s);
+    QCOMPARE(view.value(u"€").toString(), u"utf16"_s);
+
+    QVERIFY(view.contains(-1000));
+    QVERIFY(view.contains(u"key-0"));
+    QVERIFY(!view.contains(-1001));
+    QVERIFY(!view.contains(u"key"));
+    QVERIFY(!view.contains(u"key-0 "));
+    QVERIFY(view.value(u"").isInvalid());
+    // a string key doesn't match an integer key and vice versa
+    QVERIFY(view.value(u"0").isInvalid());
+
+    const QCborMapView empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QVERIFY(empty.value(1).isInvalid());
+    QVERIFY(empty.value(u"a").isInvalid());
+}
+
+void tst_QCborValueView::nonCanonicalKeys()
+{
+    // keys with needlessly long headers and a chunked key, in a small and in
+    // a large map
+    for (int padding : { 0, 20 }) {
+        QByteArray data = bytes({ 0xbf,
+                                  0x18, 0x01, 0x01,                     // 1 as 0x18 0x01
+                                  0x39, 0x00, 0x00, 0x02,               // -1 as 0x39 0x0000
+                                  0x78, 0x03, 'k', 'e', 'y', 0x03,      // "key" as 0x78 0x03
+                                  0x7f, 0x61, 'x', 0x61, 'y', 0xff, 0x04, // "x" "y" chunked
+                                  0x41, 'z', 0x05 });                   // b"z", a byte string
+        for (int i = 0; i < padding; ++i)
+            data += QCborValue(100 + i).toCbor() + QCborValue(i).toCbor();
+        data += char(0xff);
+
+        const QCborMapView map = QCborValueView(data).toMap();
+        QCOMPARE(map.value(1).toInteger(), 1);
+        QCOMPARE(map.value(-1).toInteger(), 2);
+        QCOMPARE(map.value(u"key").toInteger(), 3);
+        QCOMPARE(map.value(u"xy").toInteger(), 4);
+        QVERIFY(map.value(u"z").isInvalid());
+        if (padding)
+            QCOMPARE(map.value(119).toInteger(), 19);
+        QCOMPARE(map.size(), 5 + padding);
+    }
+}
+
+void tst_QCborValueView::duplicateKeys()
+{
+    for (int padding : { 0, 20 }) {
+        QByteArray data;
+        data += char(0xa0 | 24);
+        data += char(3 + padding);
+        data += QCborValue(u"a"_s).toCbor() + QCborValue(1).toCbor();
+        data += QCborValue(u"b"_s).toCbor() + QCborValue(2).toCbor();
+        data += QCborValue(u"a"_s).toCbor() + QCborValue(3).toCbor();
+        for (int i = 0; i < padding; ++i)
+            data += QCborValue(100 + i).toCbor() + QCborValue(i).toCbor();
+
+        const QCborMapView map = QCborValueView(data).toMap();
+        QCOMPARE(map.value(u"a").toInteger(), 1);
+        QCOMPARE(map.size(), 3 + padding);
+    }
+}
+
+void tst_QCborValueView::copiesShareIndex()
+{
+    QCborMap map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, -i);
+    const QByteArray data = QCborValue(map).toCbor();
+
+    QCborMapView view = QCborValueView(data).toMap();
+    QCOMPARE(view.value(42).toInteger(), -42);
+    QCborMapView copy = view;
+    QCOMPARE(copy.value(43).toInteger(), -43);
+    QCborMapView moved = std::move(copy);
+    QCOMPARE(moved.value(44).toInteger(), -44);
+    copy = moved;
+    QCOMPARE(copy.value(45).toInteger(), -45);
+    view = QCborMapView();
+    QVERIFY(view.value(42).isInvalid());
+    QCOMPARE(copy.value(42).toInteger(), -42);
+}
+
+void tst_QCborValueView::indexFromThreads()
+{
+#if QT_CONFIG(thread)
+    constexpr int ThreadCount = 4;
+    constexpr int Count = 1000;
+
+    QCborMap map;
+    QCborArray array;
+    for (int i = 0; i < Count; ++i) {
+        map.insert(i, -i);
+        array.append(i);
+    }
+    const QByteArray mapData = QCborValue(map).toCbor();
+    const QByteArray arrayData = QCborValue(array).toCbor();
+
+    // the threads build the indexes of the same views, and of copies of them,
+    // at the same time
+    const QCborMapView mapView = QCborValueView(mapData).toMap();
+    const QCborArrayView arrayView = QCborValueView(arrayData).toArray();
+    bool ok[ThreadCount] = {};
+    std::unique_ptr<QThread> threads[ThreadCount];
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads[t].reset(QThread::create([&, t, &ok = ok[t]] {
+            const QCborMapView mapCopy = mapView;
+            const QCborArrayView arrayCopy = arrayView;
+            ok = true;
+            for (int i = 0; i < Count; ++i) {
+                const int j = (i * 7 + t) % Count;
+                ok = ok && mapView.value(j).toInteger() == -j && mapCopy.value(i).toInteger() == -i
+                        && arrayView.at(j).toInteger() == j && arrayCopy.at(i).toInteger() == i;
+            }
+        }));
+        threads[t]->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    for (bool threadOk : ok)
+        QVERIFY(threadOk);
+#else
+    QSKIP("This test requires thread support");
+#endif
+}
+
+void tst_QCborValueView::malformed_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("reserved-28") << bytes({ 0x1c });
+    QTest::newRow("reserved-30") << bytes({ 0x5e });
+    QTest::newRow("indefinite-integer") << bytes({ 0x1f });
+    QTest::newRow("indefinite-tag") << bytes({ 0xdf, 0x01 });
+    QTest::newRow("break") << bytes({ 0xff });
+    QTest::newRow("truncated-argument") << bytes({ 0x19, 0x01 });
+    QTest::newRow("truncated-string") << bytes({ 0x63, 'a', 'b' });
+    QTest::newRow("huge-string") << bytes({ 0x5b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 'a' });
+    QTest::newRow("huge-array") << bytes({ 0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 });
+    QTest::newRow("huge-map") << bytes({ 0xbb, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01 });
+    QTest::newRow("odd-indefinite-map") << bytes({ 0xbf, 0x01, 0xff });
+    QTest::newRow("unterminated-array") << bytes({ 0x9f, 0x01, 0x02 });
+    QTest::newRow("array-with-break") << bytes({ 0x82, 0x01, 0xff });
+    QTest::newRow("tag-without-value") << bytes({ 0xc1 });
+}
+
+// Accesses everything in the view; none of this may crash or read outside of
+// the data.
+static void walk(QCborValueView view, int depth = 0)
+{
+    view.type();
+    view.toInteger();
+    view.toDouble();
+    view.toString();
+    view.toByteArray();
+    view.toUtf8StringView();
+    view.encoded();
+    if (depth > 10)
+        return;
+    walk(view.taggedValue(), depth + 1);
+    const QCborArrayView array = view.toArray();
+    array.size();
+    array.at(0);
+    array.at(20);
+    for (QCborValueView element : array)
+        walk(element, depth + 1);
+    const QCborMapView map = view.toMap();
+    map.size();
+    map.value(1);
+    map.value(u"a");
+    for (auto [key, value] : map) {
+        walk(key, depth + 1);
+        walk(value, depth + 1);
+    }
+}
+
+void tst_QCborValueView::malformed()
+{
+    QFETCH(QByteArray, data);
+
+    // use a copy without spare room, so that tools can detect reading beyond it
+    const std::unique_ptr<char[]> copy(new char[data.size() + 1]);
+    memcpy(copy.get(), data.constData(), data.size());
+    const QCborValueView view(QByteArrayView(copy.get(), data.size()));
+    QVERIFY(view.encoded().isEmpty());
+    QCOMPARE(view.toCborValue(), QCborValue(QCborValue::Invalid));
+    walk(view);
+}
+
+void tst_QCborValueView::truncated()
+{
+    const QCborValue value(QCborMap{
+            { u"numbers"_s, QCborArray{ 1, 1000, 100000, 10000000000LL, 1.5, -2 } },
+            { u"strings"_s, QCborArray{ u"short"_s, u"somewhat longer text"_s, QByteArray(30, 'x') } },
+            { 7, QCborMap{ { u"nested"_s, QCborArray{ QCborArray{ true } } } } },
+            { u"tagged"_s, QCborValue(QCborTag(42), u"tagged"_s) } });
+    const QByteArray data = value.toCbor();
+
+    for (qsizetype size = 0; size < data.size(); ++size) {
+        const std::unique_ptr<char[]> copy(new char[size + 1]);
+        memcpy(copy.get(), data.constData(), size);
+        const QCborValueView view(QByteArrayView(copy.get(), size));
+        QVERIFY2(view.encoded().isEmpty(), QByteArray::number(size));
+        walk(view);
+    }
+    compare(QCborValueView(data), value);
+}
+
+void tst_QCborValueView::deepNesting()
+{
+    constexpr int depth = 5000;
+    QByteArray data(depth, char(0x81));
+    data += char(0x01);
+
+    QCborValueView view(data);
+    // too deep to read completely, but each level can be navigated
+    QVERIFY(view.encoded().isEmpty());
+    QVERIFY(view.isArray());
+    for (int i = 0; i < depth; ++i)
+        view = view.toArray().first();
+    QCOMPARE(view.toInteger(), 1);
+
+    QByteArray tags(depth, char(0xc1));
+    tags += char(0x01);
+    QVERIFY(QCborValueView(tags).encoded().isEmpty());
+    QCOMPARE(QCborValueView(tags).taggedValue().tag(), QCborTag(1));
+}
+
+QTEST_MAIN(tst_QCborValueView)
+
+#include "tst_qcborvalueview.moc"
@@ -182,6 +182,11 @@ private slots:
 
     void status_QList_QVector();
 
+    void stream_QList_rawSpan_data();
+    void stream_QList_rawSpan();
+    void rawSpan_data();
+    void rawSpan();
+
     void streamToAndFromQByteArray();
 
     void streamRealDataTypes();
@@ -3239,6 +3244,187 @@ void tst_QDataStream::status_QList_QVector()
     }
 }
 
+template <typename T>
+static void checkRawSpanList(QDataStream::ByteOrder byteOrder, int version,
+                             QDataStream::FloatingPointPrecision precision)
+{
+    const auto setup = [&](QDataStream &stream) {
+        stream.setByteOrder(byteOrder);
+        stream.setVersion(version);
+        stream.setFloatingPointPrecision(precision);
+    };
+
+    QList<T> list;
+    for (int i = 0; i < 10000; ++i)
+        list.append(T(i * 37 - 500));
+
+    // the bulk path must produce what streaming element by element does
+    QByteArray expected;
+    {
+        QDataStream stream(&expected, QIODevice::WriteOnly);
+        setup(stream);
+        stream << quint32(list.size());
+        for (T t : std::as_const(list))
+            stream << t;
+    }
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        setup(stream);
+        stream << list;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(data, expected);
+
+    // and read what reading element by element does (for qint64 in Qt 3
+    // formats, that's not what was written)
+    QList<T> expectedList;
+    {
+        QDataStream stream(data);
+        setup(stream);
+        quint32 size;
+        stream >> size;
+        for (quint32 i = 0; i < size; ++i) {
+            T t;
+            stream >> t;
+            expectedList.append(t);
+        }
+    }
+    QList<T> result;
+    {
+        QDataStream stream(data);
+        setup(stream);
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QVERIFY(stream.atEnd());
+    }
+    QCOMPARE(result, expectedList);
+
+    {
+        QDataStream stream(data.chopped(1));
+        setup(stream);
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(result.isEmpty());
+    }
+}
+
+void tst_QDataStream::stream_QList_rawSpan_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<int>("version");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+
+    const std::pair<const char *, QDataStream::ByteOrder> byteOrders[] = {
+        { "BE", QDataStream::BigEndian }, { "LE", QDataStream::LittleEndian } };
+    const std::pair<const char *, int> versions[] = {
+        { "Qt3.0", QDataStream::Qt_3_0 }, { "Qt4.5", QDataStream::Qt_4_5 },
+        { "current", QDataStream::Qt_DefaultCompiledVersion } };
+    const std::pair<const char *, QDataStream::FloatingPointPrecision> precisions[] = {
+        { "single", QDataStream::SinglePrecision }, { "double", QDataStream::DoublePrecision } };
+
+    for (const auto &byteOrder : byteOrders) {
+        for (const auto &version : versions) {
+            for (const auto &precision : precisions) {
+                QTest::addRow("%s-%s-%s", byteOrder.first, version.first, precision.first)
+                        << byteOrder.second << version.second << precision.second;
+            }
+        }
+    }
+}
+
+void tst_QDataStream::stream_QList_rawSpan()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(int, version);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+
+#define CHECK_RAW_SPAN_LIST(T) \
+    checkRawSpanList<T>(byteOrder, version, precision); \
+    if (QTest::currentTestFailed()) \
+        QFAIL("Failed for " #T);
+
+    CHECK_RAW_SPAN_LIST(char);
+    CHECK_RAW_SPAN_LIST(qint8);
+    CHECK_RAW_SPAN_LIST(quint16);
+    CHECK_RAW_SPAN_LIST(char16_t);
+    CHECK_RAW_SPAN_LIST(qint32);
+    CHECK_RAW_SPAN_LIST(char32_t);
+    CHECK_RAW_SPAN_LIST(qint64);
+    CHECK_RAW_SPAN_LIST(quint64);
+    CHECK_RAW_SPAN_LIST(float);
+    CHECK_RAW_SPAN_LIST(double);
+#undef CHECK_RAW_SPAN_LIST
+}
+
+void tst_QDataStream::rawSpan_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+
+    QTest::newRow("BigEndian") << QDataStream::BigEndian;
+    QTest::newRow("LittleEndian") << QDataStream::LittleEndian;
+}
+
+void tst_QDataStream::rawSpan()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+
+    // more than fits into the buffer used for swapping
+    QList<quint32> values(10001);
+    for (qsizetype i = 0; i < values.size(); ++i)
+        values[i] = quint32(i * 0x01020304);
+
+    QByteArray expected;
+    for (quint32 value : std::as_const(values)) {
+        char bytes[sizeof(value)];
+        if (byteOrder == QDataStream::BigEndian)
+            qToBigEndian(value, bytes);
+        else
+            qToLittleEndian(value, bytes);
+        expected.append(bytes, sizeof(bytes));
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        QCOMPARE(stream.writeRawSpan(values.constData(), values.size()), values.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(data, expected);
+
+    {
+        QList<quint32> result(values.size());
+        QDataStream stream(data);
+        stream.setByteOrder(byteOrder);
+        QCOMPARE(stream.readRawSpan(result.data(), result.size()), result.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(result, values);
+    }
+
+    {
+        // a partial element isn't counted
+        QList<quint32> result(values.size());
+        QDataStream stream(data.first(4 * 100 + 3));
+        stream.setByteOrder(byteOrder);
+        QCOMPARE(stream.readRawSpan(result.data(), result.size()), 100);
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QCOMPARE(result.first(100), values.first(100));
+    }
+
+    {
+        // floating point precision doesn't apply
+        const float floats[] = { 1.5f, -2.25f };
+        QByteArray floatData;
+        QDataStream stream(&floatData, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+        QCOMPARE(stream.writeRawSpan(floats, 2), 2);
+        QCOMPARE(floatData.size(), qsizetype(sizeof(floats)));
+    }
+
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
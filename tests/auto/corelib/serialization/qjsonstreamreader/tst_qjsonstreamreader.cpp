@@ -0,0 +1,578 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QJsonStreamReader>
+#include <QTest>
+
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Qt::StringLiterals;
+
+// Reads all tokens and describes them in a compact form. Premature ends are
+// skipped when feeding the data in chunks.
+static QStringList tokens(QJsonStreamReader &reader)
+{
+    QStringList result;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::NoToken:
+            result.append(u"?"_s);
+            break;
+        case QJsonStreamReader::Invalid:
+            result.append(u"error"_s);
+            break;
+        case QJsonStreamReader::EndDocument:
+            break;
+        case QJsonStreamReader::StartObject:
+            result.append(u"{"_s);
+            break;
+        case QJsonStreamReader::EndObject:
+            result.append(u"}"_s);
+            break;
+        case QJsonStreamReader::StartArray:
+            result.append(u"["_s);
+            break;
+        case QJsonStreamReader::EndArray:
+            result.append(u"]"_s);
+            break;
+        case QJsonStreamReader::Name:
+            result.append(u"name:"_s + reader.text().toString());
+            break;
+        case QJsonStreamReader::String:
+            result.append(u"string:"_s + reader.text().toString());
+            break;
+        case QJsonStreamReader::Number:
+            result.append(u"number:"_s + reader.text().toString());
+            break;
+        case QJsonStreamReader::Bool:
+            result.append(reader.toBool() ? u"true"_s : u"false"_s);
+            break;
+        case QJsonStreamReader::Null:
+            result.append(u"null"_s);
+            break;
+        }
+    }
+    return result;
+}
+
+static const char testDocument[] =
+        "{\n"
+        "    \"name\": \"tst_qjsonstreamreader\",\n"
+        "    \"escapes\": \"tab\\there \\\"quoted\\\" \\u00e9\\ud83d\\ude00 \\/\",\n"
+        "    \"numbers\": [0, -1, 1.5, 2e10, -0.25E-3, 9223372036854775807],\n"
+        "    \"literals\": [true, false, null],\n"
+        "    \"nested\": {\"empty object\": {}, \"empty array\": [], \"deep\": [[[{\"x\": \"y\"}]]]},\n"
+        "    \"utf8\": \"Grüße, мир, 世界 😀\"\n"
+        "}";
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+private slots:
+    void tokens_data();
+    void tokens();
+    void errors_data();
+    void errors();
+    void chunked();
+    void device();
+    void largeStringFromDevice();
+    void prematureEnd();
+    void trailingNumber();
+    void sequence();
+    void readValue_data();
+    void readValue();
+    void skipCurrentValue();
+    void text();
+    void utf8TextDoesNotCopy();
+    void numbers_data();
+    void numbers();
+    void offsetAndDepth();
+    void byteOrderMark();
+    void deepNesting();
+    void raiseError();
+    void clear();
+};
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::addRow("empty") << QByteArray() << QStringList();
+    QTest::addRow("whitespace") << " \t\r\n"_ba << QStringList();
+    QTest::addRow("empty-object") << "{}"_ba << QStringList{u"{"_s, u"}"_s};
+    QTest::addRow("empty-array") << " [ ] "_ba << QStringList{u"["_s, u"]"_s};
+    QTest::addRow("object")
+            << R"({"a": 1, "b": [true, false, null], "c": {"d": "e"}})"_ba
+            << QStringList{u"{"_s, u"name:a"_s, u"number:1"_s, u"name:b"_s, u"["_s, u"true"_s,
+                           u"false"_s, u"null"_s, u"]"_s, u"name:c"_s, u"{"_s, u"name:d"_s,
+                           u"string:e"_s, u"}"_s, u"}"_s};
+    QTest::addRow("scalar-string") << R"("text")"_ba << QStringList{u"string:text"_s};
+    QTest::addRow("scalar-number") << "-12.5e3"_ba << QStringList{u"number:-12.5e3"_s};
+    QTest::addRow("scalar-literal") << "null"_ba << QStringList{u"null"_s};
+    QTest::addRow("empty-name") << R"({"": ""})"_ba
+                                << QStringList{u"{"_s, u"name:"_s, u"string:"_s, u"}"_s};
+    QTest::addRow("duplicate-names") << R"({"a": 1, "a": 2})"_ba
+                                     << QStringList{u"{"_s, u"name:a"_s, u"number:1"_s,
+                                                    u"name:a"_s, u"number:2"_s, u"}"_s};
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(const QByteArray, json);
+    QFETCH(const QStringList, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(::tokens(reader), expected);
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QStringList>("expected");
+    QTest::addColumn<QString>("errorString");
+    QTest::addColumn<qint64>("offset");
+
+    const QString unterminatedObject = QJsonParseError{0, QJsonParseError::UnterminatedObject}.errorString();
+    const QString unterminatedArray = QJsonParseError{0, QJsonParseError::UnterminatedArray}.errorString();
+    const QString missingNameSeparator = QJsonParseError{0, QJsonParseError::MissingNameSeparator}.errorString();
+    const QString missingValueSeparator = QJsonParseError{0, QJsonParseError::MissingValueSeparator}.errorString();
+    const QString missingObject = QJsonParseError{0, QJsonParseError::MissingObject}.errorString();
+    const QString illegalValue = QJsonParseError{0, QJsonParseError::IllegalValue}.errorString();
+    const QString illegalNumber = QJsonParseError{0, QJsonParseError::IllegalNumber}.errorString();
+    const QString illegalEscape = QJsonParseError{0, QJsonParseError::IllegalEscapeSequence}.errorString();
+    const QString illegalUtf8 = QJsonParseError{0, QJsonParseError::IllegalUTF8String}.errorString();
+    const QString unterminatedString = QJsonParseError{0, QJsonParseError::UnterminatedString}.errorString();
+
+    QTest::addRow("unterminated-object") << "{\"a\": 1"_ba << QStringList{u"{"_s, u"name:a"_s, u"number:1"_s, u"error"_s}
+                                         << unterminatedObject << qint64(7);
+    QTest::addRow("unterminated-array") << "[1, "_ba << QStringList{u"["_s, u"number:1"_s, u"error"_s}
+                                        << unterminatedArray << qint64(4);
+    QTest::addRow("missing-name-separator") << "{\"a\" 1}"_ba << QStringList{u"{"_s, u"name:a"_s, u"error"_s}
+                                            << missingNameSeparator << qint64(5);
+    QTest::addRow("missing-value-separator") << "[1 2]"_ba << QStringList{u"["_s, u"number:1"_s, u"error"_s}
+                                             << missingValueSeparator << qint64(3);
+    QTest::addRow("missing-member-separator") << "{\"a\":1 \"b\":2}"_ba
+                                              << QStringList{u"{"_s, u"name:a"_s, u"number:1"_s, u"error"_s}
+                                              << unterminatedObject << qint64(7);
+    QTest::addRow("trailing-comma-object") << "{\"a\":1,}"_ba
+                                           << QStringList{u"{"_s, u"name:a"_s, u"number:1"_s, u"error"_s}
+                                           << missingObject << qint64(7);
+    QTest::addRow("trailing-comma-array") << "[1,]"_ba << QStringList{u"["_s, u"number:1"_s, u"error"_s}
+                                          << missingObject << qint64(3);
+    QTest::addRow("name-not-string") << "{1: 2}"_ba << QStringList{u"{"_s, u"error"_s}
+                                     << unterminatedObject << qint64(1);
+    QTest::addRow("bad-literal") << "[nul]"_ba << QStringList{u"["_s, u"error"_s}
+                                 << illegalValue << qint64(1);
+    QTest::addRow("truncated-literal") << "tru"_ba << QStringList{u"error"_s}
+                                       << illegalValue << qint64(0);
+    QTest::addRow("garbage") << "[x]"_ba << QStringList{u"["_s, u"error"_s}
+                             << illegalValue << qint64(1);
+    QTest::addRow("closing-at-top") << "]"_ba << QStringList{u"error"_s}
+                                    << illegalValue << qint64(0);
+    QTest::addRow("mismatched-close") << "[}"_ba << QStringList{u"["_s, u"error"_s}
+                                      << missingObject << qint64(1);
+    QTest::addRow("number-no-digits") << "[-]"_ba << QStringList{u"["_s, u"error"_s}
+                                      << illegalNumber << qint64(1);
+    QTest::addRow("number-no-fraction") << "[1.]"_ba << QStringList{u"["_s, u"error"_s}
+                                        << illegalNumber << qint64(1);
+    QTest::addRow("number-no-exponent") << "[1e+]"_ba << QStringList{u"["_s, u"error"_s}
+                                        << illegalNumber << qint64(1);
+    QTest::addRow("bad-unicode-escape") << R"(["\u12x4"])"_ba << QStringList{u"["_s, u"error"_s}
+                                        << illegalEscape << qint64(2);
+    QTest::addRow("bad-utf8") << "[\"\xc3\x28\"]"_ba << QStringList{u"["_s, u"error"_s}
+                              << illegalUtf8 << qint64(2);
+    QTest::addRow("overlong-utf8") << "[\"\xc0\xaf\"]"_ba << QStringList{u"["_s, u"error"_s}
+                                   << illegalUtf8 << qint64(2);
+    QTest::addRow("unterminated-string") << "[\"abc"_ba << QStringList{u"["_s, u"error"_s}
+                                         << unterminatedString << qint64(1);
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(const QByteArray, json);
+    QFETCH(const QStringList, expected);
+    QFETCH(const QString, errorString);
+    QFETCH(const qint64, offset);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(::tokens(reader), expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.errorString(), errorString);
+    QCOMPARE(reader.offset(), offset);
+    QVERIFY(reader.atEnd());
+
+    // the error is final
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+
+    // QJsonDocument rejects the same documents, except that it accepts
+    // numbers with an empty fraction
+    if ((json.startsWith('{') || json.startsWith('['))
+        && qstrcmp(QTest::currentDataTag(), "number-no-fraction") != 0) {
+        QJsonParseError error;
+        QJsonDocument::fromJson(json, &error);
+        QCOMPARE_NE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void tst_QJsonStreamReader::chunked()
+{
+    const QByteArray json(testDocument);
+    QJsonStreamReader whole(json);
+    const QStringList expected = ::tokens(whole);
+    QVERIFY(!whole.hasError());
+
+    for (qsizetype chunkSize : {1, 2, 3, 7, 64}) {
+        QJsonStreamReader reader;
+        QStringList result;
+        for (qsizetype i = 0; i < json.size(); i += chunkSize) {
+            reader.addData(QByteArrayView(json).sliced(i, qMin(chunkSize, json.size() - i)));
+            result += ::tokens(reader);
+            if (reader.error() == QJsonStreamReader::PrematureEndOfDocumentError) {
+                QVERIFY(reader.atEnd());
+                QCOMPARE(result.takeLast(), u"error"_s);
+            }
+        }
+        QCOMPARE(result, expected);
+        QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+        QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+    }
+}
+
+void tst_QJsonStreamReader::device()
+{
+    QByteArray json(testDocument);
+    QJsonStreamReader whole(json);
+    const QStringList expected = ::tokens(whole);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QCOMPARE(::tokens(reader), expected);
+    QVERIFY(!reader.hasError());
+    QVERIFY(buffer.atEnd());
+
+    // addData() is ignored while a device is set
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamReader: addData() with device()");
+    reader.addData("[]");
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::largeStringFromDevice()
+{
+    const QString large = QString(100'000, u'x') + u"é\n"_s + QString(100'000, u'y');
+    QByteArray json = QJsonDocument(QJsonArray{large, 42}).toJson(QJsonDocument::Compact);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), large);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 42);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::prematureEnd()
+{
+    QJsonStreamReader reader;
+    reader.addData(R"({"key": "val)");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    QVERIFY(reader.hasError());
+    QVERIFY(reader.atEnd());
+
+    reader.addData(R"(ue")");
+    QVERIFY(!reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QCOMPARE(reader.text(), u"value"_s);
+
+    // between tokens inside a container
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("}");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.atEnd());
+
+    // more values may follow
+    reader.addData("[]");
+    QVERIFY(!reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::trailingNumber()
+{
+    // complete data: the number ends with the data
+    QJsonStreamReader reader("123"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 123);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // added data: more digits may follow
+    reader.clear();
+    reader.addData("12");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("3\n");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 123);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // the same for literals and strings, which must be complete in any case
+    reader.clear();
+    reader.addData("[tr");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("ue]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QVERIFY(reader.toBool());
+}
+
+void tst_QJsonStreamReader::sequence()
+{
+    // newline-delimited JSON
+    const QByteArray json = "{\"id\": 1}\n{\"id\": 2}\n\n[3]\n\"four\"\n5\n"_ba;
+    const QList<QJsonValue> expected = {
+        QJsonObject{{u"id"_s, 1}}, QJsonObject{{u"id"_s, 2}}, QJsonArray{3}, u"four"_s, 5
+    };
+
+    QJsonStreamReader reader(json);
+    QList<QJsonValue> values;
+    while (reader.readNext() != QJsonStreamReader::EndDocument) {
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QCOMPARE(reader.depth(), reader.isStartObject() || reader.isStartArray() ? 1 : 0);
+        values.append(reader.readValue());
+        QCOMPARE(reader.depth(), 0);
+    }
+    QCOMPARE(values, expected);
+}
+
+void tst_QJsonStreamReader::readValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::addRow("test-document") << QByteArray(testDocument);
+    QTest::addRow("empty-object") << "{}"_ba;
+    QTest::addRow("empty-array") << "[]"_ba;
+    QTest::addRow("numbers") << "[1, -1, 1.0, 1e3, 1.5, -0, 9007199254740993, 1e300]"_ba;
+    QTest::addRow("duplicate-names") << R"({"a": 1, "b": 2, "a": 3})"_ba;
+    QTest::addRow("lone-surrogate") << R"(["\ud800", "\udc00x"])"_ba;
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    QFETCH(const QByteArray, json);
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonValue expected = document.isObject() ? QJsonValue(document.object())
+                                                    : QJsonValue(document.array());
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    const QJsonValue value = reader.readValue();
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(value, expected);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // values that are not at the start of a value
+    reader.clear();
+    QVERIFY(reader.readValue().isUndefined());
+}
+
+void tst_QJsonStreamReader::skipCurrentValue()
+{
+    QJsonStreamReader reader(R"({"skip": {"a": [1, {"b": []}], "c": {}}, "keep": [2]})"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    reader.skipCurrentValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.text(), u"keep"_s);
+
+    // not a container: nothing happens
+    reader.skipCurrentValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Name);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    reader.skipCurrentValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::text()
+{
+    QJsonStreamReader reader(R"(["plain", "esc\"aped\né😀\/\q", "\ud800", 1.5, true])"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(reader.text().isEmpty());
+    QVERIFY(reader.utf8Text().isEmpty());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), u"plain"_s);
+    QCOMPARE(reader.utf8Text().toByteArray(), "plain"_ba);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), u"esc\"aped\né\U0001F600/q"_s);
+    QCOMPARE(reader.utf8Text().toByteArray(), reader.text().toUtf8());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text().size(), 1);
+    QCOMPARE(reader.text().front(), QChar(0xd800));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.text(), u"1.5"_s);
+    QCOMPARE(reader.utf8Text().toByteArray(), "1.5"_ba);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QVERIFY(reader.text().isEmpty());
+}
+
+void tst_QJsonStreamReader::utf8TextDoesNotCopy()
+{
+    const QByteArray json = R"({"name": "value"})"_ba;
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QVERIFY(reader.utf8Text().data() == json.constData() + 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QVERIFY(reader.utf8Text().data() == json.constData() + 10);
+}
+
+void tst_QJsonStreamReader::numbers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<double>("value");
+    QTest::addColumn<qint64>("integer");
+
+    constexpr qint64 none = -42;
+    QTest::addRow("zero") << "0"_ba << 0.0 << qint64(0);
+    QTest::addRow("negative") << "-17"_ba << -17.0 << qint64(-17);
+    QTest::addRow("fraction") << "1.5"_ba << 1.5 << none;
+    QTest::addRow("integral-fraction") << "2.0"_ba << 2.0 << qint64(2);
+    QTest::addRow("exponent") << "1e3"_ba << 1000.0 << qint64(1000);
+    QTest::addRow("negative-exponent") << "25E-1"_ba << 2.5 << none;
+    QTest::addRow("max") << "9223372036854775807"_ba << 9223372036854775807.0
+                         << std::numeric_limits<qint64>::max();
+    QTest::addRow("min") << "-9223372036854775808"_ba << -9223372036854775808.0
+                         << std::numeric_limits<qint64>::min();
+    QTest::addRow("beyond-double") << "9007199254740993"_ba << 9007199254740992.0
+                                   << qint64(9007199254740993);
+    QTest::addRow("too-large") << "1e20"_ba << 1e20 << none;
+}
+
+void tst_QJsonStreamReader::numbers()
+{
+    QFETCH(const QByteArray, json);
+    QFETCH(const double, value);
+    QFETCH(const qint64, integer);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toDouble(), value);
+    QCOMPARE(reader.toInteger(-42), integer);
+    QCOMPARE(reader.utf8Text().toByteArray(), json);
+}
+
+void tst_QJsonStreamReader::offsetAndDepth()
+{
+    QJsonStreamReader reader(R"( {"a" : [ 1 , "x" ] } )"_ba);
+    const QList<std::pair<qint64, int>> expected = {
+        {1, 1}, {2, 1}, {8, 2}, {10, 2}, {14, 2}, {18, 1}, {20, 0}, {22, 0}
+    };
+    for (const auto &[offset, depth] : expected) {
+        reader.readNext();
+        QCOMPARE(reader.offset(), offset);
+        QCOMPARE(reader.depth(), depth);
+    }
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::byteOrderMark()
+{
+    QJsonStreamReader reader("\xef\xbb\xbf[1]"_ba);
+    QCOMPARE(::tokens(reader), (QStringList{u"["_s, u"number:1"_s, u"]"_s}));
+    QVERIFY(!reader.hasError());
+
+    // split across chunks
+    reader.clear();
+    reader.addData("\xef\xbb");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("\xbf[]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    const QByteArray ok = QByteArray(1024, '[') + QByteArray(1024, ']');
+    QJsonStreamReader reader(ok);
+    QCOMPARE(::tokens(reader).size(), 2048);
+    QVERIFY(!reader.hasError());
+
+    const QByteArray tooDeep = QByteArray(1025, '[') + QByteArray(1025, ']');
+    reader.clear();
+    reader.addData(tooDeep);
+    ::tokens(reader);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.errorString(),
+             QJsonParseError({0, QJsonParseError::DeepNesting}).errorString());
+    QCOMPARE(reader.offset(), 1024);
+}
+
+void tst_QJsonStreamReader::raiseError()
+{
+    QJsonStreamReader reader(R"({"version": 3})"_ba);
+    reader.readNext();
+    reader.readNext();
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    reader.raiseError(u"unsupported version"_s);
+    QCOMPARE(reader.error(), QJsonStreamReader::CustomError);
+    QCOMPARE(reader.errorString(), u"unsupported version");
+    QCOMPARE(reader.offset(), 12);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QVERIFY(reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+}
+
+void tst_QJsonStreamReader::clear()
+{
+    QJsonStreamReader reader("[1, x]"_ba);
+    ::tokens(reader);
+    QVERIFY(reader.hasError());
+
+    reader.clear();
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.depth(), 0);
+    reader.addData("[]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.offset(), 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
@@ -0,0 +1,349 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QJsonStreamWriter>
+#include <QTest>
+
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cmath>
+#include <limits>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sameAsToJson_data();
+    void sameAsToJson();
+    void incremental_data();
+    void incremental();
+    void strings_data();
+    void strings();
+    void numbers_data();
+    void numbers();
+    void topLevelSequence();
+    void writeToDevice();
+    void deviceError();
+    void invalidCalls();
+};
+
+static const char testDocument[] =
+        "{\n"
+        "    \"id\": 42,\n"
+        "    \"name\": \"J\\u00f8rgen \\\"J\\\" S\\u00e6ther\",\n"
+        "    \"balance\": -1234.5,\n"
+        "    \"big\": 9007199254740993,\n"
+        "    \"tags\": [\"a\", \"\\n\\t\\u0001\", \"\\ud83d\\ude00\", \"\"],\n"
+        "    \"active\": true,\n"
+        "    \"parent\": null,\n"
+        "    \"empty\": {},\n"
+        "    \"emptyArray\": [],\n"
+        "    \"nested\": [[1, [2, {\"x\": [false]}]], {\"\": 0.25}]\n"
+        "}";
+
+void tst_QJsonStreamWriter::sameAsToJson_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+
+    const struct { const char *name; QByteArray json; } documents[] = {
+        { "empty-object", "{}" },
+        { "empty-array", "[]" },
+        { "nested-empty-array", "[[]]" },
+        { "nested-empty-object", "{\"a\":{}}" },
+        { "scalars", "[1, 2.5, \"three\", true, false, null]" },
+        { "document", testDocument },
+    };
+    for (const auto &document : documents) {
+        QTest::addRow("indented-%s", document.name) << document.json << QJsonDocument::Indented;
+        QTest::addRow("compact-%s", document.name) << document.json << QJsonDocument::Compact;
+    }
+}
+
+void tst_QJsonStreamWriter::sameAsToJson()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    if (doc.isObject())
+        writer.writeValue(doc.object());
+    else
+        writer.writeValue(doc.array());
+    QCOMPARE(writer.depth(), 0);
+    QVERIFY(!writer.hasError());
+    QCOMPARE(output, doc.toJson(format));
+}
+
+void tst_QJsonStreamWriter::incremental_data()
+{
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+
+    QTest::newRow("indented") << QJsonDocument::Indented;
+    QTest::newRow("compact") << QJsonDocument::Compact;
+}
+
+void tst_QJsonStreamWriter::incremental()
+{
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writer.startObject();
+    QCOMPARE(writer.depth(), 1);
+    // QJsonObject sorts its keys, so write them in that order
+    writer.writeName(u"active");
+    writer.writeBool(true);
+    writer.writeName(u8"balance");
+    writer.writeDouble(-1234.5);
+    writer.writeName(u"big");
+    writer.writeInteger(9007199254740993LL);
+    writer.writeName(u"empty");
+    writer.startObject();
+    writer.endObject();
+    writer.writeName(u"emptyArray");
+    writer.writeValue(QJsonArray());
+    writer.writeName(u"id");
+    writer.writeInteger(42);
+    writer.writeName("name"_L1);
+    writer.writeString(u"J\u00f8rgen \"J\" S\u00e6ther"_s);
+    writer.writeName(u"nested");
+    writer.writeValue(QJsonArray{ QJsonArray{ 1, QJsonArray{ 2, QJsonObject{ { "x", QJsonArray{ false } } } } },
+                                  QJsonObject{ { "", 0.25 } } });
+    writer.writeName(u"parent");
+    writer.writeNull();
+    writer.writeName(u"tags");
+    writer.startArray();
+    QCOMPARE(writer.depth(), 2);
+    writer.writeString("a"_L1);
+    writer.writeString(u8"\n\t\u0001");
+    writer.writeString(u"\U0001F600");
+    writer.writeString(QString());
+    writer.endArray();
+    writer.endObject();
+    QCOMPARE(writer.depth(), 0);
+
+    const QJsonDocument expected = QJsonDocument::fromJson(testDocument);
+    QVERIFY(expected.isObject());
+    QCOMPARE(output, expected.toJson(format));
+}
+
+void tst_QJsonStreamWriter::strings_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("empty") << QString() << QByteArray("\"\"");
+    QTest::newRow("ascii") << u"hello"_s << QByteArray("\"hello\"");
+    QTest::newRow("quote-backslash") << u"a\"b\\c"_s << QByteArray("\"a\\\"b\\\\c\"");
+    QTest::newRow("slash") << u"a/b"_s << QByteArray("\"a/b\"");
+    QTest::newRow("short-escapes") << u"\b\f\n\r\t"_s << QByteArray("\"\\b\\f\\n\\r\\t\"");
+    QTest::newRow("control") << u"\u0001\u001f\u007f"_s << QByteArray("\"\\u0001\\u001f\x7f\"");
+    QTest::newRow("latin1") << u"caf\u00e9"_s << QByteArray("\"caf\xc3\xa9\"");
+    QTest::newRow("bmp") << u"\u20ac"_s << QByteArray("\"\xe2\x82\xac\"");
+    QTest::newRow("surrogate-pair") << u"\U0001F600"_s << QByteArray("\"\xf0\x9f\x98\x80\"");
+    QTest::newRow("lone-high-surrogate") << QString(QChar(0xd800)) << QByteArray("\"\\ud800\"");
+    QTest::newRow("lone-low-surrogate") << QString(QChar(0xdc00)) + u'x'
+                                        << QByteArray("\"\\udc00x\"");
+
+    // long enough to need the output to grow while escaping
+    QString longText;
+    QByteArray longExpected = "\"";
+    for (int i = 0; i < 1000; ++i) {
+        longText += u"ab\u00e9\n\u20ac\"\u0002"_s;
+        longExpected += "ab\xc3\xa9\\n\xe2\x82\xac\\\"\\u0002";
+    }
+    longExpected += '"';
+    QTest::newRow("long") << longText << longExpected;
+}
+
+void tst_QJsonStreamWriter::strings()
+{
+    QFETCH(QString, text);
+    QFETCH(QByteArray, expected);
+
+    const auto write = [](QAnyStringView text) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output);
+        writer.setFormat(QJsonDocument::Compact);
+        writer.writeString(text);
+        return output;
+    };
+
+    QCOMPARE(write(text), expected);
+
+    // the other encodings of QAnyStringView, where they can represent the text
+    const QByteArray utf8 = text.toUtf8();
+    if (QString::fromUtf8(utf8) == text)
+        QCOMPARE(write(QUtf8StringView(utf8)), expected);
+    const bool isLatin1 = std::all_of(text.cbegin(), text.cend(),
+                                      [](QChar c) { return c.unicode() < 0x100; });
+    if (isLatin1) {
+        const QByteArray latin1 = text.toLatin1();
+        QCOMPARE(write(QLatin1StringView(latin1)), expected);
+    }
+
+    // the result is the same as QJsonDocument's
+    const QByteArray array = QJsonDocument(QJsonArray{ text }).toJson(QJsonDocument::Compact);
+    QCOMPARE(array, '[' + expected + ']');
+}
+
+void tst_QJsonStreamWriter::numbers_data()
+{
+    QTest::addColumn<double>("value");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("zero") << 0.0 << QByteArray("0");
+    QTest::newRow("fraction") << 0.1 << QByteArray("0.1");
+    QTest::newRow("negative") << -2.5 << QByteArray("-2.5");
+    QTest::newRow("large") << 1e300 << QByteArray("1e+300");
+    QTest::newRow("nan") << qQNaN() << QByteArray("null");
+    QTest::newRow("inf") << qInf() << QByteArray("null");
+    QTest::newRow("-inf") << -qInf() << QByteArray("null");
+}
+
+void tst_QJsonStreamWriter::numbers()
+{
+    QFETCH(double, value);
+    QFETCH(QByteArray, expected);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+    writer.writeDouble(value);
+    QCOMPARE(output, expected);
+
+    output.clear();
+    QJsonStreamWriter integers(&output);
+    integers.setFormat(QJsonDocument::Compact);
+    integers.startArray();
+    integers.writeInteger(std::numeric_limits<qint64>::min());
+    integers.writeInteger(std::numeric_limits<qint64>::max());
+    integers.writeInteger(0);
+    integers.writeInteger(-1);
+    integers.endArray();
+    QCOMPARE(output, "[-9223372036854775808,9223372036854775807,0,-1]");
+}
+
+void tst_QJsonStreamWriter::topLevelSequence()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+    writer.writeInteger(1);
+    writer.writeValue(QJsonObject{ { "a", 2 } });
+    writer.writeString(u"three");
+    QCOMPARE(output, "1\n{\"a\":2}\n\"three\"");
+
+    output.clear();
+    QJsonStreamWriter indented(&output);
+    indented.writeInteger(1);
+    indented.writeValue(QJsonObject{ { "a", 2 } });
+    QCOMPARE(output, "1\n{\n    \"a\": 2\n}\n");
+}
+
+void tst_QJsonStreamWriter::writeToDevice()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    QJsonArray expected;
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.startArray();
+        for (int i = 0; i < 10000; ++i) {
+            const QJsonObject element{ { "index", i }, { "text", u"element %1"_s.arg(i) } };
+            writer.writeValue(element);
+            expected.append(element);
+        }
+        // the output is passed on while writing, not only at the end
+        const qsizetype total = QJsonDocument(expected).toJson().size() - qsizetype(sizeof("\n]\n")) + 1;
+        QVERIFY(buffer.size() > 0);
+        QCOMPARE_LT(total - buffer.size(), 17 * 1024);
+        writer.endArray();
+        writer.flush();
+        QCOMPARE(buffer.data(), QJsonDocument(expected).toJson());
+
+        writer.startArray();
+        writer.endArray();
+        QVERIFY(!writer.hasError());
+    }
+    // the destructor flushes
+    QCOMPARE(buffer.data(), QJsonDocument(expected).toJson() + "[\n]\n");
+}
+
+void tst_QJsonStreamWriter::deviceError()
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QJsonStreamWriter writer(&buffer);
+    writer.writeValue(QJsonArray{ 1, 2, 3 });
+    QVERIFY(!writer.hasError());
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    writer.flush();
+    QVERIFY(writer.hasError());
+    QVERIFY(data.isEmpty());
+
+    QJsonStreamWriter noDevice;
+    QCOMPARE(noDevice.device(), nullptr);
+    noDevice.writeNull();
+    noDevice.flush();
+    QVERIFY(noDevice.hasError());
+}
+
+void tst_QJsonStreamWriter::invalidCalls()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QJsonStreamWriter: endObject() called without a matching start");
+    writer.endObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: writeName() called outside of an "
+                                       "object or twice in a row");
+    writer.writeName(u"a");
+
+    writer.startObject();
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QJsonStreamWriter: number written in an object without a name");
+    writer.writeInteger(1);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QJsonStreamWriter: array written in an object without a name");
+    writer.startArray();
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QJsonStreamWriter: endArray() called without a matching start");
+    writer.endArray();
+    writer.writeName(u"a");
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: writeName() called outside of an "
+                                       "object or twice in a row");
+    writer.writeName(u"b");
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QJsonStreamWriter: endObject() called after a name without a value");
+    writer.endObject();
+    writer.writeBool(false);
+    writer.endObject();
+
+    QCOMPARE(output, "{\"a\":false}");
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -91,6 +91,8 @@ private slots:
 
     void doubleRoundTrip_data();
     void doubleRoundTrip();
+    void shortestDoubleRoundTrip_data();
+    void shortestDoubleRoundTrip();
     void integerRoundTrip_data();
     void integerRoundTrip();
     void negativeNumbers();
@@ -2655,6 +2657,54 @@ void tst_QLocale::doubleRoundTrip()
     QCOMPARE(locale.toString(number, numberFormat), numberText);
 }
 
+void tst_QLocale::shortestDoubleRoundTrip_data()
+{
+    QTest::addColumn<double>("number");
+    QTest::addColumn<QString>("expected");
+
+    using L = std::numeric_limits<double>;
+    QTest::newRow("zero") << 0.0 << u"0"_s;
+    QTest::newRow("-zero") << -0.0 << u"0"_s;
+    QTest::newRow("0.1") << 0.1 << u"0.1"_s;
+    QTest::newRow("0.3") << 0.3 << u"0.3"_s;
+    QTest::newRow("0.1+0.2") << 0.1 + 0.2 << u"0.30000000000000004"_s;
+    QTest::newRow("1/3") << 1.0 / 3 << u"0.3333333333333333"_s;
+    QTest::newRow("-2.5") << -2.5 << u"-2.5"_s;
+    QTest::newRow("123456") << 123456.0 << u"123456"_s;
+    QTest::newRow("1e21") << 1e21 << u"1e+21"_s;
+    QTest::newRow("1.5e-7") << 1.5e-7 << u"1.5e-07"_s;
+    QTest::newRow("2^53+2") << 9007199254740994.0 << u"9007199254740994"_s;
+    QTest::newRow("5e-324") << L::denorm_min() << u"5e-324"_s;
+    QTest::newRow("min") << L::min() << u"2.2250738585072014e-308"_s;
+    QTest::newRow("max") << L::max() << u"1.7976931348623157e+308"_s;
+    QTest::newRow("lowest") << L::lowest() << u"-1.7976931348623157e+308"_s;
+}
+
+void tst_QLocale::shortestDoubleRoundTrip()
+{
+    QFETCH(double, number);
+    QFETCH(QString, expected);
+    constexpr int Shortest = QLocale::FloatingPointShortest;
+
+    const QString text = QString::number(number, 'g', Shortest);
+    QCOMPARE(text, expected);
+    QCOMPARE(QByteArray::number(number, 'g', Shortest), expected.toLatin1());
+    QCOMPARE(QLocale::c().toString(number, 'g', Shortest), expected);
+
+    // The round trip must be exact, which QCOMPARE() would not check:
+    bool ok = false;
+    QVERIFY(text.toDouble(&ok) == number);
+    QVERIFY(ok);
+    QVERIFY(QLocale::c().toDouble(text, &ok) == number);
+    QVERIFY(ok);
+    QVERIFY(expected.toLatin1().toDouble(&ok) == number);
+    QVERIFY(ok);
+    if (!text.startsWith(u'-')) {
+        QVERIFY(QString(u'+' + text).toDouble(&ok) == number);
+        QVERIFY(ok);
+    }
+}
+
 void tst_QLocale::integerRoundTrip_data()
 {
     QTest::addColumn<QString>("localeName");
@@ -0,0 +1,354 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QMultiStringMatcher>
+#include <QTest>
+
+#include <QRandomGenerator>
+
+#include <tuple>
+
+using namespace Qt::StringLiterals;
+
+// the tuples are (position, length, needleIndex)
+using MatchList = QList<std::tuple<qsizetype, qsizetype, qsizetype>>;
+
+template <typename Match>
+static MatchList toMatchList(const QList<Match> &matches)
+{
+    MatchList result;
+    for (const Match &m : matches)
+        result.append({m.position, m.length, m.needleIndex});
+    return result;
+}
+
+// the expected order: by end position, then longest first, then by needle index
+template <typename Haystack, typename Needle>
+static MatchList bruteForce(const Haystack &haystack, const QList<Needle> &needles,
+                            Qt::CaseSensitivity cs = Qt::CaseSensitive)
+{
+    MatchList result;
+    for (qsizetype end = 1; end <= haystack.size(); ++end) {
+        for (qsizetype length = end; length > 0; --length) {
+            const auto candidate = haystack.mid(end - length, length);
+            for (qsizetype n = 0; n < needles.size(); ++n) {
+                bool equal;
+                if constexpr (std::is_same_v<Needle, QString>)
+                    equal = candidate.compare(needles.at(n), cs) == 0;
+                else
+                    equal = candidate == needles.at(n);
+                if (equal) {
+                    result.append({end - length, length, n});
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// what indexIn() returns: the match that starts first, and the longest one of those
+static std::tuple<qsizetype, qsizetype, qsizetype> leftmost(const MatchList &matches)
+{
+    Q_ASSERT(!matches.isEmpty());
+    auto result = matches.first();
+    for (const auto &match : matches) {
+        if (std::get<0>(match) < std::get<0>(result)
+            || (std::get<0>(match) == std::get<0>(result)
+                && std::get<1>(match) > std::get<1>(result))) {
+            result = match;
+        }
+    }
+    return result;
+}
+
+template <typename Matcher, typename Haystack>
+static MatchList firstMatch(const Matcher &matcher, const Haystack &haystack)
+{
+    const auto first = matcher.indexIn(haystack);
+    if (!first.isValid())
+        return {};
+    return {{first.position, first.length, first.needleIndex}};
+}
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void byteArray_data();
+    void byteArray();
+    void byteArrayFrom();
+    void byteArrayOverlapping();
+    void byteArrayDefault();
+    void byteArrayCopy();
+    void byteArrayRandom();
+    void string_data();
+    void string();
+    void stringCaseInsensitive_data();
+    void stringCaseInsensitive();
+    void stringSetters();
+    void stringOverlapping();
+    void stringRandom();
+};
+
+void tst_QMultiStringMatcher::byteArray_data()
+{
+    QTest::addColumn<QByteArrayList>("needles");
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<MatchList>("expected");
+
+    QTest::addRow("no-needles") << QByteArrayList() << "abc"_ba << MatchList();
+    QTest::addRow("empty-needle") << QByteArrayList{""_ba} << "abc"_ba << MatchList();
+    QTest::addRow("empty-haystack") << QByteArrayList{"a"_ba} << QByteArray() << MatchList();
+    QTest::addRow("single") << QByteArrayList{"lo"_ba} << "hello world"_ba
+                            << MatchList{{3, 2, 0}};
+    QTest::addRow("classic") << QByteArrayList{"he"_ba, "she"_ba, "his"_ba, "hers"_ba}
+                             << "ushers"_ba
+                             << MatchList{{1, 3, 1}, {2, 2, 0}, {2, 4, 3}};
+    QTest::addRow("overlapping") << QByteArrayList{"aa"_ba} << "aaaa"_ba
+                                 << MatchList{{0, 2, 0}, {1, 2, 0}, {2, 2, 0}};
+    QTest::addRow("nested") << QByteArrayList{"b"_ba, "abc"_ba, "bc"_ba} << "abcd"_ba
+                            << MatchList{{1, 1, 0}, {0, 3, 1}, {1, 2, 2}};
+    QTest::addRow("duplicates") << QByteArrayList{"x"_ba, "ab"_ba, "ab"_ba} << "cabab"_ba
+                                << MatchList{{1, 2, 1}, {3, 2, 1}};
+    QTest::addRow("binary") << QByteArrayList{"\0\xff"_ba, "\xfe"_ba} << "\xfe\0\xff\0"_ba
+                            << MatchList{{0, 1, 1}, {1, 2, 0}};
+    QTest::addRow("no-match") << QByteArrayList{"xyz"_ba, "zz"_ba} << "xyxzy"_ba
+                              << MatchList();
+}
+
+void tst_QMultiStringMatcher::byteArray()
+{
+    QFETCH(const QByteArrayList, needles);
+    QFETCH(const QByteArray, haystack);
+    QFETCH(const MatchList, expected);
+
+    const QMultiByteArrayMatcher matcher(needles);
+    QCOMPARE(matcher.needles(), needles);
+    QCOMPARE(toMatchList(matcher.matches(haystack)), expected);
+    QCOMPARE(expected, bruteForce(haystack, needles));
+
+    const QMultiByteArrayMatcher::Match first = matcher.indexIn(haystack);
+    if (expected.isEmpty()) {
+        QVERIFY(!first.isValid());
+        QCOMPARE(first.position, -1);
+    } else {
+        QVERIFY(first.isValid());
+        QCOMPARE(std::tuple(first.position, first.length, first.needleIndex),
+                 leftmost(expected));
+    }
+}
+
+void tst_QMultiStringMatcher::byteArrayFrom()
+{
+    const QMultiByteArrayMatcher matcher({"ab"_ba, "b"_ba});
+    const QByteArray haystack = "abab"_ba;
+
+    QCOMPARE(matcher.indexIn(haystack, 1).position, 1);
+    QCOMPARE(matcher.indexIn(haystack, 1).needleIndex, 1);
+    QCOMPARE(matcher.indexIn(haystack, 2).position, 2);
+    QCOMPARE(matcher.indexIn(haystack, 2).needleIndex, 0);
+    QCOMPARE(matcher.indexIn(haystack, -1).position, 3);
+    QCOMPARE(matcher.indexIn(haystack, -100).position, 0);
+    QVERIFY(!matcher.indexIn(haystack, 4).isValid());
+    QVERIFY(!matcher.indexIn(haystack, 100).isValid());
+
+    const MatchList fromTwo{{2, 2, 0}, {3, 1, 1}};
+    QCOMPARE(toMatchList(matcher.matches(haystack, 2)), fromTwo);
+    QCOMPARE(toMatchList(matcher.matches(haystack, -2)), fromTwo);
+    QVERIFY(matcher.matches(haystack, 4).isEmpty());
+}
+
+void tst_QMultiStringMatcher::byteArrayOverlapping()
+{
+    // the first match to end is "bc", but "abcd" starts before it
+    const QMultiByteArrayMatcher matcher({"abcd"_ba, "bc"_ba});
+    QCOMPARE(firstMatch(matcher, "abcd"_ba), (MatchList{{0, 4, 0}}));
+    QCOMPARE(firstMatch(matcher, "xabcdx"_ba), (MatchList{{1, 4, 0}}));
+    QCOMPARE(firstMatch(matcher, "abcbcd"_ba), (MatchList{{1, 2, 1}}));
+    QCOMPARE(matcher.indexIn("abcd"_ba, 1).position, 1);
+
+    // of several needles starting at the same position, the longest one wins
+    const QMultiByteArrayMatcher nested({"c"_ba, "bcd"_ba, "abcdef"_ba, "bc"_ba});
+    QCOMPARE(firstMatch(nested, "abcdef"_ba), (MatchList{{0, 6, 2}}));
+    QCOMPARE(firstMatch(nested, "abcdex"_ba), (MatchList{{1, 3, 1}}));
+}
+
+void tst_QMultiStringMatcher::byteArrayDefault()
+{
+    QMultiByteArrayMatcher matcher;
+    QVERIFY(matcher.needles().isEmpty());
+    QVERIFY(!matcher.indexIn("abc").isValid());
+    QVERIFY(matcher.matches("abc").isEmpty());
+
+    matcher.setNeedles({"c"_ba});
+    QCOMPARE(matcher.indexIn("abc").position, 2);
+}
+
+void tst_QMultiStringMatcher::byteArrayCopy()
+{
+    QMultiByteArrayMatcher matcher({"a"_ba});
+    QMultiByteArrayMatcher copy = matcher;
+    matcher.setNeedles({"b"_ba});
+    QCOMPARE(copy.needles(), QByteArrayList{"a"_ba});
+    QCOMPARE(copy.indexIn("ba").position, 1);
+    QCOMPARE(matcher.indexIn("ba").position, 0);
+
+    copy = std::move(matcher);
+    QCOMPARE(copy.indexIn("ab").position, 1);
+    matcher = copy;
+    QCOMPARE(matcher.indexIn("ab").position, 1);
+
+    QMultiByteArrayMatcher other({"x"_ba});
+    other.swap(matcher);
+    QCOMPARE(other.needles(), QByteArrayList{"b"_ba});
+    QCOMPARE(matcher.needles(), QByteArrayList{"x"_ba});
+}
+
+void tst_QMultiStringMatcher::byteArrayRandom()
+{
+    // small alphabet, so that there are many overlapping matches
+    QRandomGenerator rng(42);
+    const auto randomBytes = [&](qsizetype length) {
+        QByteArray result(length, Qt::Uninitialized);
+        for (char &c : result)
+            c = char('a' + rng.bounded(3));
+        return result;
+    };
+    for (int round = 0; round < 200; ++round) {
+        QByteArrayList needles;
+        for (int i = 0, count = rng.bounded(1, 8); i < count; ++i)
+            needles.append(randomBytes(rng.bounded(0, 5)));
+        const QByteArray haystack = randomBytes(rng.bounded(0, 40));
+        const QMultiByteArrayMatcher matcher(needles);
+        const MatchList expected = bruteForce(haystack, needles);
+        QCOMPARE(toMatchList(matcher.matches(haystack)), expected);
+        QCOMPARE(firstMatch(matcher, haystack),
+                 expected.isEmpty() ? MatchList() : MatchList{leftmost(expected)});
+    }
+}
+
+void tst_QMultiStringMatcher::string_data()
+{
+    QTest::addColumn<QStringList>("needles");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<MatchList>("expected");
+
+    QTest::addRow("ascii") << QStringList{u"he"_s, u"she"_s, u"his"_s, u"hers"_s}
+                           << u"ushers"_s
+                           << MatchList{{1, 3, 1}, {2, 2, 0}, {2, 4, 3}};
+    QTest::addRow("latin1") << QStringList{u"ä"_s, u"öl"_s} << u"Höl ä"_s
+                            << MatchList{{1, 2, 1}, {4, 1, 0}};
+    QTest::addRow("non-latin1") << QStringList{u"мир"_s, u"ми"_s, u"世界"_s}
+                                << u"миру мир 世界"_s
+                                << MatchList{{0, 2, 1}, {0, 3, 0}, {5, 2, 1}, {5, 3, 0},
+                                             {9, 2, 2}};
+    QTest::addRow("surrogates") << QStringList{u"😀"_s, u"a😀"_s} << u"xa😀😀"_s
+                                << MatchList{{1, 3, 1}, {2, 2, 0}, {4, 2, 0}};
+    QTest::addRow("case-sensitive") << QStringList{u"Foo"_s} << u"foo FOO Foo"_s
+                                    << MatchList{{8, 3, 0}};
+}
+
+void tst_QMultiStringMatcher::string()
+{
+    QFETCH(const QStringList, needles);
+    QFETCH(const QString, haystack);
+    QFETCH(const MatchList, expected);
+
+    const QMultiStringMatcher matcher(needles);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QCOMPARE(toMatchList(matcher.matches(haystack)), expected);
+    QCOMPARE(expected, bruteForce(haystack, needles));
+
+    const QMultiStringMatcher::Match first = matcher.indexIn(haystack);
+    QVERIFY(first.isValid());
+    QCOMPARE(std::tuple(first.position, first.length, first.needleIndex), leftmost(expected));
+}
+
+void tst_QMultiStringMatcher::stringCaseInsensitive_data()
+{
+    QTest::addColumn<QStringList>("needles");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<MatchList>("expected");
+
+    QTest::addRow("ascii") << QStringList{u"Foo"_s, u"BAR"_s} << u"foo FOO bar"_s
+                           << MatchList{{0, 3, 0}, {4, 3, 0}, {8, 3, 1}};
+    QTest::addRow("latin1") << QStringList{u"Äpfel"_s} << u"ÄPFEL äpfel"_s
+                            << MatchList{{0, 5, 0}, {6, 5, 0}};
+    QTest::addRow("cyrillic") << QStringList{u"мир"_s} << u"МИР Мир"_s
+                              << MatchList{{0, 3, 0}, {4, 3, 0}};
+    QTest::addRow("kelvin") << QStringList{u"k"_s} << u"KKk"_s
+                            << MatchList{{0, 1, 0}, {1, 1, 0}, {2, 1, 0}};
+    QTest::addRow("micro") << QStringList{u"µ"_s} << u"μΜ"_s
+                           << MatchList{{0, 1, 0}, {1, 1, 0}};
+}
+
+void tst_QMultiStringMatcher::stringCaseInsensitive()
+{
+    QFETCH(const QStringList, needles);
+    QFETCH(const QString, haystack);
+    QFETCH(const MatchList, expected);
+
+    const QMultiStringMatcher matcher(needles, Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(toMatchList(matcher.matches(haystack)), expected);
+    QCOMPARE(expected, bruteForce(haystack, needles, Qt::CaseInsensitive));
+}
+
+void tst_QMultiStringMatcher::stringSetters()
+{
+    QMultiStringMatcher matcher;
+    QVERIFY(!matcher.indexIn(u"abc").isValid());
+
+    matcher.setNeedles({u"B"_s});
+    QVERIFY(!matcher.indexIn(u"abc").isValid());
+
+    const QMultiStringMatcher copy = matcher;
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn(u"abc").position, 1);
+    QCOMPARE(matcher.needles(), QStringList{u"B"_s});
+    QCOMPARE(copy.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(!copy.indexIn(u"abc").isValid());
+
+    matcher.setNeedles({u"C"_s});
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn(u"abc").position, 2);
+}
+
+void tst_QMultiStringMatcher::stringOverlapping()
+{
+    const QMultiStringMatcher matcher({u"abcd"_s, u"bc"_s});
+    QCOMPARE(firstMatch(matcher, u"abcd"_s), (MatchList{{0, 4, 0}}));
+
+    const QMultiStringMatcher insensitive({u"МИРА"_s, u"ир"_s}, Qt::CaseInsensitive);
+    QCOMPARE(firstMatch(insensitive, u"x мира"_s), (MatchList{{2, 4, 0}}));
+}
+
+void tst_QMultiStringMatcher::stringRandom()
+{
+    QRandomGenerator rng(4711);
+    const char16_t alphabet[] = u"aAbBäÄфФ";
+    const auto randomString = [&](qsizetype length) {
+        QString result;
+        for (qsizetype i = 0; i < length; ++i)
+            result.append(QChar(alphabet[rng.bounded(int(std::size(alphabet) - 1))]));
+        return result;
+    };
+    for (Qt::CaseSensitivity cs : {Qt::CaseSensitive, Qt::CaseInsensitive}) {
+        for (int round = 0; round < 200; ++round) {
+            QStringList needles;
+            for (int i = 0, count = rng.bounded(1, 8); i < count; ++i)
+                needles.append(randomString(rng.bounded(0, 4)));
+            const QString haystack = randomString(rng.bounded(0, 30));
+            const QMultiStringMatcher matcher(needles, cs);
+            const MatchList expected = bruteForce(haystack, needles, cs);
+            QCOMPARE(toMatchList(matcher.matches(haystack)), expected);
+            QCOMPARE(firstMatch(matcher, haystack),
+                     expected.isEmpty() ? MatchList() : MatchList{leftmost(expected)});
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
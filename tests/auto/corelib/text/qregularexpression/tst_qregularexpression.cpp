@@ -14,7 +14,11 @@
 #include <qthread.h>
 
 #include <iostream>
+#include <memory>
 #include <optional>
+#include <vector>
+
+using namespace Qt::StringLiterals;
 
 #ifndef QTEST_THROW_ON_FAIL
 # error This test requires QTEST_THROW_ON_FAIL being active.
@@ -75,6 +79,10 @@ private slots:
     void wildcard();
     void testInvalidWildcard_data();
     void testInvalidWildcard();
+    void compiledPatternSharing();
+    void regularExpressionSet_data();
+    void regularExpressionSet();
+    void regularExpressionSetModification();
 
 private:
     void provideRegularExpressions();
@@ -2558,6 +2566,173 @@ void tst_QRegularExpression::testInvalidWildcard()
     QCOMPARE(re.isValid(), isValid);
 }
 
+void tst_QRegularExpression::compiledPatternSharing()
+{
+    // Identical patterns share their compiled form; different options must not
+    const QString pattern = u"(?<word>h\\w+)"_s;
+    QRegularExpression first(pattern);
+    QRegularExpression second(pattern);
+    QRegularExpression insensitive(pattern, QRegularExpression::CaseInsensitiveOption);
+    QRegularExpression noCapture(pattern, QRegularExpression::DontCaptureOption);
+
+    QVERIFY(first.match(u"say hello").hasMatch());
+    QCOMPARE(second.match(u"say hello").captured(u"word"), u"hello");
+    QVERIFY(!second.match(u"SAY HELLO").hasMatch());
+    QCOMPARE(insensitive.match(u"SAY HELLO").captured(u"word"), u"HELLO");
+    QCOMPARE(first.captureCount(), 1);
+    QCOMPARE(noCapture.captureCount(), 1);  // named groups still capture
+
+    // changing the pattern of one doesn't affect the other
+    second.setPattern(u"x+"_s);
+    QVERIFY(first.match(u"hi").hasMatch());
+    QVERIFY(!second.match(u"hi").hasMatch());
+    second.setPattern(pattern);
+    QCOMPARE(second.match(u"oh hi").captured(0), u"hi");
+
+    // invalid patterns keep reporting their errors
+    for (int i = 0; i < 2; ++i) {
+        QRegularExpression invalid(u"a(b"_s);
+        QVERIFY(!invalid.isValid());
+        QCOMPARE(invalid.patternErrorOffset(), 3);
+    }
+
+    // and the compiled patterns can be used from several threads at once
+    std::vector<std::unique_ptr<QThread>> threads;
+    QAtomicInteger<int> failures = 0;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = 0; j < 200; ++j) {
+                QRegularExpression re(pattern);
+                if (re.match(u"abc hij"_s).captured(u"word") != u"hij"_s)
+                    ++failures;
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
+void tst_QRegularExpression::regularExpressionSet_data()
+{
+    QTest::addColumn<QList<QRegularExpression>>("expressions");
+    QTest::addColumn<QString>("subject");
+    QTest::addColumn<QList<qsizetype>>("expected");
+
+    using RE = QRegularExpression;
+    const QList<QRegularExpression> logFilters = {
+        RE(u"^ERROR\\b"_s),
+        RE(u"timeout"_s, RE::CaseInsensitiveOption),
+        RE(u"user=(\\w+)"_s),
+        RE(u"(?<code>\\d{3}) (?<text>\\w+)"_s),
+    };
+    QTest::newRow("empty-set") << QList<QRegularExpression>() << u"anything"_s
+                               << QList<qsizetype>();
+    QTest::newRow("none") << logFilters << u"INFO: all good"_s << QList<qsizetype>();
+    QTest::newRow("first") << logFilters << u"ERROR: disk full"_s << QList<qsizetype>{ 0 };
+    QTest::newRow("all") << logFilters << u"ERROR 504 Gateway TIMEOUT, user=bob"_s
+                         << QList<qsizetype>{ 0, 1, 2, 3 };
+    QTest::newRow("later-in-subject") << logFilters << u"user=bob hit a timeout"_s
+                                      << QList<qsizetype>{ 1, 2 };
+
+    // these cannot be part of the combined expression
+    const QList<QRegularExpression> special = {
+        RE(u"(a)\\1"_s),                                 // backreference
+        RE(u"(?<w>x)\\k<w>"_s),                          // named backreference
+        RE(u"b(*COMMIT)c|bd"_s),                         // verb affecting the alternation
+        RE(u"\\Qa|b"_s),                                 // quoted to the end
+        RE(u"\\w+\\b"_s, RE::UseUnicodePropertiesOption),
+        RE(u"(?<v>y)"_s),
+        RE(u"(x"_s),                                     // invalid
+        RE(u"z  # a comment"_s, RE::ExtendedPatternSyntaxOption),
+        RE(u"q.r"_s, RE::DotMatchesEverythingOption),
+        RE(u"^end$"_s, RE::MultilineOption),
+        RE(u"(p)(q)"_s, RE::DontCaptureOption),
+        RE(u"(?<v>zz)"_s),                               // duplicate name
+        RE(u"c(?C1)d"_s),                                // callout
+    };
+    QTest::newRow("special-none") << special << u"...."_s << QList<qsizetype>();
+    QTest::newRow("special-backref") << special << u"aa"_s << QList<qsizetype>{ 0, 4 };
+    QTest::newRow("special-named-backref") << special << u"xx"_s << QList<qsizetype>{ 1, 4 };
+    QTest::newRow("special-verb") << special << u"bx q\nr"_s << QList<qsizetype>{ 4, 8 };
+    QTest::newRow("special-quote") << special << u"a|b"_s << QList<qsizetype>{ 3, 4 };
+    QTest::newRow("special-unicode") << special << u"\u00e9"_s << QList<qsizetype>{ 4 };
+    QTest::newRow("special-dup-name") << special << u"y zz"_s << QList<qsizetype>{ 4, 5, 7, 11 };
+    QTest::newRow("special-options") << special << u"q\nr\nend\npq"_s
+                                     << QList<qsizetype>{ 4, 8, 9, 10 };
+    QTest::newRow("special-callout") << special << u"cd"_s << QList<qsizetype>{ 4, 12 };
+
+    // more expressions than fit the preallocated bookkeeping, matching in any order
+    QList<QRegularExpression> many;
+    for (int i = 0; i < 100; ++i)
+        many.append(RE(u"\\bw%1\\b"_s.arg(i)));
+    QTest::newRow("many") << many << u"w99 w7 x w42 w7"_s << QList<qsizetype>{ 7, 42, 99 };
+    QTest::newRow("many-none") << many << u"w100 w-1"_s << QList<qsizetype>();
+}
+
+void tst_QRegularExpression::regularExpressionSet()
+{
+    QFETCH(QList<QRegularExpression>, expressions);
+    QFETCH(QString, subject);
+    QFETCH(QList<qsizetype>, expected);
+
+    // check the test data against matching one by one
+    QList<qsizetype> oneByOne;
+    for (qsizetype i = 0; i < expressions.size(); ++i) {
+        if (expressions.at(i).isValid() && expressions.at(i).match(subject).hasMatch())
+            oneByOne.append(i);
+    }
+    QCOMPARE(oneByOne, expected);
+
+    const QRegularExpressionSet set(expressions);
+    QCOMPARE(set.size(), expressions.size());
+    QCOMPARE(set.matchingIndexes(subject), expected);
+    QCOMPARE(set.matchesAny(subject), !expected.isEmpty());
+    // once more, now that it's prepared
+    QCOMPARE(set.matchingIndexes(subject), expected);
+
+    QRegularExpressionSet appended;
+    for (const QRegularExpression &re : std::as_const(expressions))
+        appended.append(re);
+    QCOMPARE(appended.matchingIndexes(subject), expected);
+}
+
+void tst_QRegularExpression::regularExpressionSetModification()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.isEmpty());
+    QVERIFY(set.isValid());
+    QVERIFY(!set.matchesAny(u"abc"));
+
+    QCOMPARE(set.append(QRegularExpression(u"b"_s)), 0);
+    QCOMPARE(set.matchingIndexes(u"abc"), QList<qsizetype>{ 0 });
+
+    const QRegularExpressionSet copy = set;
+    QCOMPARE(set.append(QRegularExpression(u"c$"_s)), 1);
+    QCOMPARE(set.matchingIndexes(u"abc"), (QList<qsizetype>{ 0, 1 }));
+    QCOMPARE(copy.size(), 1);
+    QCOMPARE(copy.matchingIndexes(u"abc"), QList<qsizetype>{ 0 });
+
+    set.append(QRegularExpression(u"(unbalanced"_s));
+    QVERIFY(!set.isValid());
+    QCOMPARE(set.matchingIndexes(u"abc"), (QList<qsizetype>{ 0, 1 }));
+
+    set.setExpressions({ QRegularExpression(u"x"_s) });
+    QCOMPARE(set.size(), 1);
+    QVERIFY(!set.matchesAny(u"abc"));
+    QVERIFY(set.matchesAny(u"xyz"));
+
+    set.clear();
+    QVERIFY(set.isEmpty());
+    QVERIFY(!set.matchesAny(u"xyz"));
+
+    // anchoring applies to every expression
+    set.setExpressions({ QRegularExpression(u"b"_s), QRegularExpression(u"\\w"_s) });
+    QCOMPARE(set.matchingIndexes(u"abc", QRegularExpression::AnchorAtOffsetMatchOption),
+             QList<qsizetype>{ 1 });
+}
+
 QTEST_APPLESS_MAIN(tst_QRegularExpression)
 
 #include "tst_qregularexpression.moc"
@@ -0,0 +1,238 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QSmallString>
+#include <QTest>
+
+#include <QHash>
+#include <QList>
+
+#include <private/qcomparisontesthelper_p.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+private slots:
+    void compareCompiles();
+    void construct_data();
+    void construct();
+    void inlineCapacity();
+    void sharesLongStrings();
+    void copyAndMove();
+    void compare();
+    void hash();
+    void inContainers();
+    void byteArray();
+    void byteArrayCompare();
+};
+
+void tst_QSmallString::compareCompiles()
+{
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallString>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallString, QStringView>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallString, QString>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallString, QLatin1StringView>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallByteArray>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallByteArray, QByteArrayView>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallByteArray, QByteArray>();
+    QTestPrivate::testAllComparisonOperatorsCompile<QSmallByteArray, const char *>();
+}
+
+void tst_QSmallString::construct_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::addRow("empty") << QString();
+    QTest::addRow("one") << u"a"_s;
+    QTest::addRow("identifier") << u"objectName"_s;
+    QTest::addRow("non-latin1") << u"файл"_s;
+    QTest::addRow("surrogates") << u"\U0001F600\U0001F600"_s;
+    QTest::addRow("at-capacity") << QString(QSmallString::InlineCapacity, u'x');
+    QTest::addRow("above-capacity") << QString(QSmallString::InlineCapacity + 1, u'y');
+    QTest::addRow("long") << u"a string that is too long to be stored inline"_s;
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(const QString, string);
+    const bool fitsInline = string.size() <= QSmallString::InlineCapacity;
+
+    auto check = [&](const QSmallString &s) {
+        QCOMPARE(s.size(), string.size());
+        QCOMPARE(s.isEmpty(), string.isEmpty());
+        QCOMPARE(s.isInline(), fitsInline);
+        QCOMPARE(s.view(), QStringView(string));
+        QCOMPARE(s.toString(), string);
+        QCOMPARE(s.utf16()[s.size()], u'\0');
+        QCOMPARE(QStringView(s.begin(), s.end()), QStringView(string));
+        if (!string.isEmpty()) {
+            QCOMPARE(s.at(0), string.at(0));
+            QCOMPARE(s[s.size() - 1], string.back());
+        }
+    };
+
+    check(QSmallString(string));
+    check(QSmallString(QString(string)));
+    check(QSmallString(QStringView(string)));
+    if (QtPrivate::isLatin1(QStringView(string)))
+        check(QSmallString(QLatin1StringView(string.toLatin1())));
+
+    QSmallString s(string);
+    s.clear();
+    QVERIFY(s.isEmpty());
+    QVERIFY(s.isInline());
+    QCOMPARE(s.toString(), QString());
+}
+
+void tst_QSmallString::inlineCapacity()
+{
+    QCOMPARE(sizeof(QSmallString), sizeof(QString) + sizeof(void *));
+    QCOMPARE(sizeof(QSmallByteArray), sizeof(QByteArray) + sizeof(void *));
+    QCOMPARE_GE(QSmallString::InlineCapacity, 6);
+    QCOMPARE_GE(QSmallByteArray::InlineCapacity, 14);
+    if constexpr (sizeof(void *) == 8) {
+        QCOMPARE(QSmallString::InlineCapacity, 14);
+        QCOMPARE(QSmallByteArray::InlineCapacity, 30);
+    }
+}
+
+void tst_QSmallString::sharesLongStrings()
+{
+    const QString longString(64, u'z');
+    const QSmallString s(longString);
+    QVERIFY(!s.isInline());
+    QVERIFY(s.toString().isSharedWith(longString));
+    QCOMPARE(s.constData(), longString.constData());
+
+    // views are always copied
+    const QSmallString fromView{QStringView(longString)};
+    QVERIFY(!fromView.isInline());
+    QCOMPARE_NE(fromView.constData(), longString.constData());
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    const QSmallString shortString(u"short"_s);
+    const QSmallString longString(QString(40, u'l'));
+
+    QSmallString copy = shortString;
+    QCOMPARE(copy, shortString);
+    copy = longString;
+    QCOMPARE(copy, longString);
+    QVERIFY(!copy.isInline());
+    copy = shortString;
+    QCOMPARE(copy, shortString);
+    QVERIFY(copy.isInline());
+
+    QSmallString moved = QSmallString(longString);
+    QSmallString target = std::move(moved);
+    QCOMPARE(target, longString);
+    QVERIFY(moved.isEmpty()); // NOLINT(bugprone-use-after-move)
+    moved = target;
+    QCOMPARE(moved, longString);
+
+    target.swap(copy);
+    QCOMPARE(target, shortString);
+    QCOMPARE(copy, longString);
+    swap(target, copy);
+    QCOMPARE(target, longString);
+    QCOMPARE(copy, shortString);
+
+    // self-assignment
+    auto &self = copy;
+    copy = self;
+    QCOMPARE(copy, shortString);
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString a(u"apple"_s);
+    const QSmallString b(u"banana"_s);
+    const QSmallString longB(u"banana banana banana"_s);
+
+    QT_TEST_ALL_COMPARISON_OPS(a, b, Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(b, longB, Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(a, QSmallString(u"apple"_s), Qt::strong_ordering::equal);
+    QT_TEST_ALL_COMPARISON_OPS(a, u"apple"_s, Qt::strong_ordering::equal);
+    QT_TEST_ALL_COMPARISON_OPS(a, QStringView(u"apples"), Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(b, "apple"_L1, Qt::strong_ordering::greater);
+    QT_TEST_ALL_COMPARISON_OPS(QSmallString(u"é"_s), "\xe9"_L1, Qt::strong_ordering::equal);
+}
+
+void tst_QSmallString::hash()
+{
+    for (const QString &s : { QString(), u"key"_s, QString(50, u'k') }) {
+        QCOMPARE(qHash(QSmallString(s)), qHash(s));
+        QCOMPARE(qHash(QSmallString(s), 42), qHash(s, 42));
+    }
+    QCOMPARE(qHash(QSmallByteArray("key"_ba), 42), qHash("key"_ba, 42));
+}
+
+void tst_QSmallString::inContainers()
+{
+    QList<QSmallString> list;
+    QHash<QSmallString, int> hash;
+    for (int i = 0; i < 200; ++i) {
+        // every tenth string is long
+        const QString s = i % 10 ? QString::number(i) : QString::number(i).repeated(10);
+        list.append(QSmallString(s));
+        hash.insert(QSmallString(s), i);
+    }
+    list.insert(5, QSmallString(QString(30, u'!'))); // relocates the elements behind it
+    list.removeAt(5);
+    for (int i = 0; i < 200; ++i) {
+        const QString s = i % 10 ? QString::number(i) : QString::number(i).repeated(10);
+        QCOMPARE(list.at(i), s);
+        QCOMPARE(hash.value(QSmallString(s), -1), i);
+    }
+}
+
+void tst_QSmallString::byteArray()
+{
+    const QSmallByteArray empty;
+    QVERIFY(empty.isEmpty());
+    QVERIFY(empty.isInline());
+    QCOMPARE(empty.constData()[0], '\0');
+    QCOMPARE(empty.toByteArray(), QByteArray());
+
+    const QSmallByteArray shortArray("content-type"_ba);
+    QVERIFY(shortArray.isInline());
+    QCOMPARE(shortArray.size(), 12);
+    QCOMPARE(shortArray.view(), "content-type");
+    QCOMPARE(qstrlen(shortArray.constData()), 12u);
+    QCOMPARE(shortArray.at(0), 'c');
+    QCOMPARE(shortArray.toByteArray(), "content-type"_ba);
+
+    const QByteArray binary("a\0b", 3);
+    const QSmallByteArray withNull(binary);
+    QCOMPARE(withNull.size(), 3);
+    QCOMPARE(withNull, binary);
+
+    const QByteArray longArray(QSmallByteArray::InlineCapacity + 1, 'x');
+    const QSmallByteArray fromLong(longArray);
+    QVERIFY(!fromLong.isInline());
+    QCOMPARE(fromLong.constData(), longArray.constData());
+    QCOMPARE(QSmallByteArray(QByteArrayView(longArray)), longArray);
+
+    QSmallByteArray copy = fromLong;
+    QCOMPARE(copy, fromLong);
+    copy = shortArray;
+    QCOMPARE(copy, shortArray);
+    copy.clear();
+    QVERIFY(copy.isEmpty());
+}
+
+void tst_QSmallString::byteArrayCompare()
+{
+    const QSmallByteArray a("abc"_ba);
+    QT_TEST_ALL_COMPARISON_OPS(a, QSmallByteArray("abd"_ba), Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(a, "abc"_ba, Qt::strong_ordering::equal);
+    QT_TEST_ALL_COMPARISON_OPS(a, QByteArrayView("ab"), Qt::strong_ordering::greater);
+    QT_TEST_ALL_COMPARISON_OPS(a, "abc", Qt::strong_ordering::equal);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+
+#include "tst_qsmallstring.moc"
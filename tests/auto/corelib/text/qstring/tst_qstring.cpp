@@ -8219,6 +8219,22 @@ void tst_QString::compare_data()
         QTest::addRow("nonascii-nonascii-notequal-%d", i)
                 << (padding + nbsp) << (padding + smallAWithAcute) << -1 << -1;
     }
+
+    // characters outside of Latin-1 that fold to (or like) Latin-1 ones, at
+    // every position relative to the blocks of the vectorized comparison
+    for (int i = 1; i <= 20; ++i) {
+        QString padding(i - 1, u'x');
+        QTest::addRow("kelvin-%d", i)
+                << (padding + u"\u212Aelvin"_s) << (padding + u"KELVIN"_s) << 1 << 0;
+        QTest::addRow("micro-%d", i)
+                << (padding + u"\u00b5"_s) << (padding + u"\u039c"_s) << -1 << 0;
+        QTest::addRow("surrogate-caseequal-%d", i)
+                << (padding + upper + u"AB"_s) << (padding + lower + u"ab"_s) << -1 << 0;
+        QTest::addRow("latin1-caseequal-%d", i)
+                << (padding + u"ÀÉÎÕÜÝÞ"_s) << (padding + u"àéîõüýþ"_s) << -1 << 0;
+        QTest::addRow("latin1-multiplication-%d", i)
+                << (padding + u"\u00d7"_s) << (padding + u"\u00f7"_s) << -1 << -1;
+    }
 }
 
 static bool isLatin(const QString &s)
@@ -170,6 +170,10 @@ private slots:
 
     void utf8Codec_data();
     void utf8Codec();
+    void utf8MultiByteRuns_data();
+    void utf8MultiByteRuns();
+    void utf8InvalidInMultiByteRun_data();
+    void utf8InvalidInMultiByteRun();
 
     void utf8bom_data();
     void utf8bom();
@@ -1821,6 +1825,104 @@ void tst_QStringConverter::utf8Codec()
     QCOMPARE(str, res);
 }
 
+// straightforward encoder, to check the optimized code against
+static QByteArray referenceUtf8(QStringView str)
+{
+    QByteArray result;
+    for (char32_t ucs : str.toUcs4()) {
+        if (ucs < 0x80) {
+            result += char(ucs);
+        } else if (ucs < 0x800) {
+            result += char(0xc0 | (ucs >> 6));
+            result += char(0x80 | (ucs & 0x3f));
+        } else if (ucs < 0x10000) {
+            result += char(0xe0 | (ucs >> 12));
+            result += char(0x80 | ((ucs >> 6) & 0x3f));
+            result += char(0x80 | (ucs & 0x3f));
+        } else {
+            result += char(0xf0 | (ucs >> 18));
+            result += char(0x80 | ((ucs >> 12) & 0x3f));
+            result += char(0x80 | ((ucs >> 6) & 0x3f));
+            result += char(0x80 | (ucs & 0x3f));
+        }
+    }
+    return result;
+}
+
+void tst_QStringConverter::utf8MultiByteRuns_data()
+{
+    QTest::addColumn<QString>("str");
+
+    // long enough to exercise the vectorized code and its tails
+    const auto row = [](const char *name, const char16_t *sample) {
+        const QString unit = QString::fromUtf16(sample);
+        QString str;
+        for (int i = 0; i < 7; ++i) {
+            str += unit;
+            QTest::addRow("%s-%d", name, i) << str;
+            QTest::addRow("%s-%d-offset", name, i) << str.mid(1);
+        }
+    };
+    row("cyrillic", u"Съешь же ещё этих мягких французских булок, да выпей чаю. ");
+    row("cjk", u"東京都の天気は晴れ、最高気温は二十五度です。我能吞下玻璃而不伤身体。");
+    row("hangul", u"다람쥐 헌 쳇바퀴에 타고파");
+    row("json", u"{\"name\": \"Жанна\", \"city\": \"北京\", \"tags\": [\"α\", \"β\"], \"n\": 42}");
+    row("mixed-lengths", u"a\u00e9\u20acb\u00ff\uffff\u0800\u07ff\u0080\x7f\ufffd");
+    row("supplementary", u"Привет \U0001F600 мир \U00010000\U0010FFFD 世界");
+}
+
+void tst_QStringConverter::utf8MultiByteRuns()
+{
+    QFETCH(QString, str);
+    const QByteArray utf8 = referenceUtf8(str);
+
+    QCOMPARE(str.toUtf8(), utf8);
+    QCOMPARE(QString::fromUtf8(utf8), str);
+
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    QCOMPARE(QByteArray(encoder(str)), utf8);
+    QVERIFY(!encoder.hasError());
+
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QCOMPARE(QString(decoder(utf8)), str);
+    QVERIFY(!decoder.hasError());
+}
+
+void tst_QStringConverter::utf8InvalidInMultiByteRun_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<QString>("res");
+
+    const QString run = u"Ёжик в тумане: 東京 Δ 東京 Ёжик в тумане: 東京 Δ 東京"_s;
+    const std::pair<const char *, QByteArray> invalid[] = {
+        { "continuation", "\x80"_ba },
+        { "overlong-2", "\xc0\xaf"_ba },
+        { "overlong-3", "\xe0\x80\xaf"_ba },
+        { "surrogate", "\xed\xa0\x80"_ba },
+        { "5-byte", "\xf8\x88\x80\x80\x80"_ba },
+        { "fe", "\xfe"_ba },
+    };
+    for (const auto &[name, sequence] : invalid) {
+        for (int pos = 0; pos < 20; ++pos) {
+            QTest::addRow("%s-at-%d", name, pos)
+                    << referenceUtf8(run.first(pos)) + sequence + referenceUtf8(run.sliced(pos))
+                    << run.first(pos) + fromInvalidUtf8Sequence(sequence) + run.sliced(pos);
+        }
+    }
+}
+
+void tst_QStringConverter::utf8InvalidInMultiByteRun()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(QString, res);
+
+    QCOMPARE(QString::fromUtf8(utf8), res);
+
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QCOMPARE(QString(decoder(utf8)), res);
+    QVERIFY(decoder.hasError());
+}
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
 void tst_QStringConverter::utf8bom_data()
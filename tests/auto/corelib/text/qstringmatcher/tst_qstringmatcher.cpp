@@ -16,6 +16,7 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void assignOperatorCaseInsensitive();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -117,6 +118,12 @@ void tst_QStringMatcher::setCaseSensitivity_data()
     QString needle = stringOf128 + stringOf128 + "CAse";
     QString haystack = stringOf128 + stringOf128 + "caSE";
     QTest::newRow("insensitive-9") << needle << haystack << 0 << 0 << (int)Qt::CaseInsensitive;
+    QTest::newRow("insensitive-latin1")
+            << QString(u"ÀÉÎÕÜ") << QString(u"xxàéîõü ÀÉÎÕÜ") << 0 << 2 << (int)Qt::CaseInsensitive;
+    QTest::newRow("insensitive-kelvin")
+            << QString("kelvin") << QString(u"degrees \u212Aelvin") << 0 << 8 << (int)Qt::CaseInsensitive;
+    QTest::newRow("insensitive-cyrillic")
+            << QString(u"привет") << QString(u"скажи ПРИВЕТ") << 0 << 6 << (int)Qt::CaseInsensitive;
 }
 
 void tst_QStringMatcher::setCaseSensitivity()
@@ -148,6 +155,30 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::assignOperatorCaseInsensitive()
+{
+    const QString haystack("abc ABCDEF abcdef");
+    QStringMatcher m1(QString("cdef"), Qt::CaseInsensitive);
+    QCOMPARE(m1.indexIn(haystack), 6);
+
+    QStringMatcher m2(QString("xyz"));
+    m2 = m1;
+    QCOMPARE(m2.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(m2.indexIn(haystack), 6);
+
+    m1.setPattern("ABC");
+    QCOMPARE(m1.indexIn(haystack), 0);
+    QCOMPARE(m2.indexIn(haystack), 6);
+
+    m2.setCaseSensitivity(Qt::CaseSensitive);
+    QCOMPARE(m2.indexIn(haystack), 13);
+    m2.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(m2.indexIn(haystack), 6);
+
+    m1 = QStringMatcher(QString("def"));
+    QCOMPARE(m1.indexIn(haystack), 14);
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
@@ -0,0 +1,215 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QStringPool>
+#include <QTest>
+
+#include <QList>
+#include <QThread>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+class tst_QStringPool : public QObject
+{
+    Q_OBJECT
+private slots:
+    void intern_data();
+    void intern();
+    void internSharesQString();
+    void internCopiesExcessCapacity();
+    void internCopiesRawData();
+    void empty();
+    void stableViews();
+    void squeeze();
+    void clear();
+    void threads();
+};
+
+void tst_QStringPool::intern_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::addRow("ascii") << u"name"_s;
+    QTest::addRow("latin1") << u"Straße"_s;
+    QTest::addRow("non-latin1") << u"имя"_s;
+    QTest::addRow("long") << QString(1000, u'x');
+}
+
+void tst_QStringPool::intern()
+{
+    QFETCH(const QString, string);
+
+    QStringPool pool;
+    QVERIFY(pool.isEmpty());
+    QVERIFY(!pool.contains(QStringView(string)));
+
+    const QString first = pool.intern(QStringView(string));
+    QCOMPARE(first, string);
+    QVERIFY(!first.isSharedWith(string));
+    QCOMPARE(pool.size(), 1);
+    QVERIFY(pool.contains(QStringView(string)));
+
+    // equal content from other sources comes back as the same instance
+    QVERIFY(pool.intern(QStringView(string)).isSharedWith(first));
+    QVERIFY(pool.intern(QString(string)).isSharedWith(first));
+    if (QtPrivate::isLatin1(QStringView(string))) {
+        const QByteArray latin1 = string.toLatin1();
+        QVERIFY(pool.contains(QLatin1StringView(latin1)));
+        QVERIFY(pool.intern(QLatin1StringView(latin1)).isSharedWith(first));
+    }
+    QCOMPARE(pool.size(), 1);
+
+    const QString other = pool.intern(string + u'!');
+    QCOMPARE(other, string + u'!');
+    QCOMPARE(pool.size(), 2);
+}
+
+void tst_QStringPool::internSharesQString()
+{
+    QStringPool pool;
+    const QString s = QString(20, u'a');
+    QVERIFY(pool.intern(s).isSharedWith(s));
+    QVERIFY(pool.intern(u"aaaaaaaaaaaaaaaaaaaa").isSharedWith(s));
+}
+
+void tst_QStringPool::internCopiesExcessCapacity()
+{
+    QStringPool pool;
+    QString s;
+    s.reserve(1000);
+    s.append(u"short");
+    const QString interned = pool.intern(s);
+    QCOMPARE(interned, s);
+    QVERIFY(!interned.isSharedWith(s));
+    QCOMPARE_LT(interned.capacity(), 1000);
+}
+
+void tst_QStringPool::internCopiesRawData()
+{
+    QStringPool pool;
+
+    // static data is copied, so that squeeze() can release it
+    const QString literal = u"literal"_s;
+    const QString internedLiteral = pool.intern(literal);
+    QCOMPARE(internedLiteral, literal);
+    QCOMPARE_NE(internedLiteral.constData(), literal.constData());
+    QVERIFY(internedLiteral.data_ptr().isMutable());
+
+    // raw data may go away before the pool does
+    auto buffer = std::make_unique<QChar[]>(3);
+    std::copy_n(u"raw", 3, buffer.get());
+    const QString internedRaw = pool.intern(QString::fromRawData(buffer.get(), 3));
+    QCOMPARE(internedRaw, u"raw");
+    QCOMPARE_NE(internedRaw.constData(), buffer.get());
+    buffer.reset();
+    QVERIFY(pool.contains(u"raw"));
+    QCOMPARE(pool.intern(u"raw"), u"raw");
+}
+
+void tst_QStringPool::empty()
+{
+    QStringPool pool;
+    QVERIFY(pool.intern(QString()).isNull());
+    QVERIFY(pool.intern(QStringView()).isEmpty());
+    QVERIFY(pool.intern(QStringView(u"")).isEmpty());
+    QVERIFY(pool.intern(QLatin1StringView()).isEmpty());
+    QVERIFY(!pool.intern(u""_s).isNull());
+    QVERIFY(pool.isEmpty());
+    QVERIFY(!pool.contains(QStringView()));
+}
+
+void tst_QStringPool::stableViews()
+{
+    QStringPool pool;
+    QList<QStringView> views;
+    for (int i = 0; i < 1000; ++i) {
+        // don't keep the returned QString
+        views.append(pool.intern(QString::number(i)));
+    }
+    QCOMPARE(pool.size(), 1000);
+    // the pool has grown (and rehashed) many times since the first views were taken
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(views.at(i), QString::number(i));
+        QCOMPARE(pool.intern(views.at(i)).constData(), views.at(i).constData());
+    }
+}
+
+void tst_QStringPool::squeeze()
+{
+    QStringPool pool;
+    QList<QString> kept;
+    // QString::number() may return static data for single digits
+    const auto key = [](int i) { return u"key"_s + QString::number(i); };
+    for (int i = 0; i < 100; ++i) {
+        const QString s = pool.intern(key(i));
+        if (i % 2)
+            kept.append(s);
+    }
+    const QString literal = u"literal"_s;
+    pool.intern(literal);
+    QCOMPARE(pool.size(), 101);
+
+    // the literal was copied into the pool, so nothing else references it
+    QCOMPARE(pool.squeeze(), 51);
+    QCOMPARE(pool.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(pool.contains(key(i)), bool(i % 2));
+    QVERIFY(!pool.contains(literal));
+    for (const QString &s : std::as_const(kept))
+        QVERIFY(pool.intern(QStringView(s)).isSharedWith(s));
+
+    kept.clear();
+    QCOMPARE(pool.squeeze(), 50);
+    QVERIFY(pool.isEmpty());
+    QCOMPARE(pool.squeeze(), 0);
+}
+
+void tst_QStringPool::clear()
+{
+    QStringPool pool;
+    const QString a = pool.intern(u"a"_s);
+    pool.intern(u"b"_s);
+    QCOMPARE(pool.size(), 2);
+    pool.clear();
+    QVERIFY(pool.isEmpty());
+    QCOMPARE(a, u"a"_s);
+    QVERIFY(!pool.intern(u"a").isSharedWith(a));
+}
+
+void tst_QStringPool::threads()
+{
+#if QT_CONFIG(thread)
+    constexpr int ThreadCount = 4;
+    constexpr int StringCount = 2000;
+
+    QStringPool pool;
+    QList<QString> results[ThreadCount];
+    std::unique_ptr<QThread> threads[ThreadCount];
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads[t].reset(QThread::create([&pool, &result = results[t]] {
+            result.reserve(StringCount);
+            for (int i = 0; i < StringCount; ++i)
+                result.append(pool.intern(QString::number(i % (StringCount / 2))));
+        }));
+        threads[t]->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(pool.size(), StringCount / 2);
+    for (int i = 0; i < StringCount; ++i) {
+        const QString &expected = results[0].at(i);
+        QCOMPARE(expected, QString::number(i % (StringCount / 2)));
+        for (int t = 1; t < ThreadCount; ++t)
+            QCOMPARE(results[t].at(i).constData(), expected.constData());
+    }
+#else
+    QSKIP("This test requires thread support");
+#endif
+}
+
+QTEST_APPLESS_MAIN(tst_QStringPool)
+
+#include "tst_qstringpool.moc"
@@ -209,6 +209,7 @@ private slots:
     void continuationsWithContext_data();
     void continuationsWithContext();
     void continuationsWithMoveOnlyLambda();
+    void continuationsWithExecutor();
 #if 0
     // TODO: enable when QFuture::takeResults() is enabled
     void takeResults();
@@ -3371,6 +3372,160 @@ void tst_QFuture::continuationsWithContext()
 #endif // QT_NO_EXCEPTIONS
 }
 
+// Queues the runnables, so that the test controls when they run
+struct QueueExecutor
+{
+    QList<QRunnable *> *queue;
+    void execute(QRunnable *runnable) { queue->append(runnable); }
+
+    static void runAll(QList<QRunnable *> &queue)
+    {
+        while (!queue.isEmpty()) {
+            QRunnable *runnable = queue.takeFirst();
+            runnable->run();
+            if (runnable->autoDelete())
+                delete runnable;
+        }
+    }
+};
+
+void tst_QFuture::continuationsWithExecutor()
+{
+    static_assert(QtPrivate::isExecutorV<QueueExecutor>);
+    static_assert(!QtPrivate::isExecutorV<QThreadPool *>);
+    static_assert(!QtPrivate::isExecutorV<QtFuture::Launch>);
+
+    QList<QRunnable *> queue;
+    QueueExecutor executor{&queue};
+
+    // .then() on a finished future hands the continuation to the executor right away
+    {
+        auto future = QtFuture::makeReadyValueFuture(1).then(executor, [](int value) {
+            return value + 1;
+        });
+        QCOMPARE(queue.size(), 1);
+        QVERIFY(!future.isFinished());
+        QueueExecutor::runAll(queue);
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 2);
+    }
+
+    // .then() on a pending future, with a move-only continuation
+    {
+        QPromise<int> promise;
+        std::unique_ptr<int> uniquePtr(new int(40));
+        auto future = promise.future().then(executor, [p = std::move(uniquePtr)](int value) {
+            return *p + value;
+        });
+        promise.start();
+        QVERIFY(queue.isEmpty());
+        promise.addResult(2);
+        promise.finish();
+        QCOMPARE(queue.size(), 1);
+        QueueExecutor::runAll(queue);
+        QCOMPARE(future.result(), 42);
+    }
+
+    // the executor can run the continuation in another thread
+    {
+        QThreadPool pool;
+        struct PoolExecutor
+        {
+            QThreadPool *pool;
+            void execute(QRunnable *runnable) { pool->start(runnable); }
+        };
+        Qt::HANDLE continuationThread = nullptr;
+        auto future = QtFuture::makeReadyVoidFuture().then(PoolExecutor{&pool}, [&] {
+            continuationThread = QThread::currentThreadId();
+        });
+        future.waitForFinished();
+        QVERIFY(continuationThread);
+        QVERIFY(continuationThread != QThread::currentThreadId());
+    }
+
+    // the continuation is not handed to the executor if the parent was canceled
+    {
+        QPromise<int> promise;
+        bool called = false;
+        auto future = promise.future().then(executor, [&](int) { called = true; });
+        promise.start();
+        promise.future().cancel();
+        promise.finish();
+        QVERIFY(queue.isEmpty());
+        QVERIFY(future.isCanceled());
+        QVERIFY(!called);
+    }
+
+    // an executor dropping the continuation cancels the result
+    {
+        struct DroppingExecutor
+        {
+            void execute(QRunnable *runnable) { delete runnable; }
+        };
+        auto future = QtFuture::makeReadyValueFuture(1).then(DroppingExecutor{},
+                                                              [](int value) { return value; });
+        QVERIFY(future.isCanceled());
+    }
+
+    // .onCanceled()
+    {
+        QPromise<int> promise;
+        auto future = promise.future().onCanceled(executor, [] { return -1; });
+        promise.start();
+        promise.future().cancel();
+        promise.finish();
+        QCOMPARE(queue.size(), 1);
+        QueueExecutor::runAll(queue);
+        QCOMPARE(future.result(), -1);
+    }
+
+    // results that don't need the handler are passed on without the executor
+    {
+        auto future = QtFuture::makeReadyValueFuture(1).onCanceled(executor, [] { return -1; });
+        QVERIFY(queue.isEmpty());
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 1);
+    }
+
+#ifndef QT_NO_EXCEPTIONS
+    // .onFailed()
+    {
+        auto future = QtFuture::makeReadyValueFuture(1)
+                .then([](int) -> int { throw std::runtime_error("error"); })
+                .onFailed(executor, [](const std::runtime_error &) { return -1; });
+        QCOMPARE(queue.size(), 1);
+        QueueExecutor::runAll(queue);
+        QCOMPARE(future.result(), -1);
+    }
+
+    {
+        auto future = QtFuture::makeReadyValueFuture(1)
+                .onFailed(executor, [](const std::runtime_error &) { return -1; });
+        QVERIFY(queue.isEmpty());
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 1);
+    }
+
+    {
+        // an exception is passed on by .onCanceled() without calling the handler
+        auto future = QtFuture::makeReadyValueFuture(1)
+                .then([](int) -> int { throw std::runtime_error("error"); })
+                .onCanceled(executor, [] { return -1; });
+        QVERIFY(queue.isEmpty());
+        QVERIFY_THROWS_EXCEPTION(std::runtime_error, future.result());
+    }
+
+    // exceptions thrown by the continuation are propagated
+    {
+        auto future = QtFuture::makeReadyValueFuture(1).then(executor, [](int) -> int {
+            throw std::runtime_error("error");
+        });
+        QueueExecutor::runAll(queue);
+        QVERIFY_THROWS_EXCEPTION(std::runtime_error, future.result());
+    }
+#endif
+}
+
 void tst_QFuture::continuationsWithMoveOnlyLambda()
 {
     // .then()
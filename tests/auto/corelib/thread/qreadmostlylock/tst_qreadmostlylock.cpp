@@ -0,0 +1,168 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QSemaphore>
+#include <qthread.h>
+#include <private/qreadmostlylock_p.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class tst_QReadMostlyLock : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readLockUnlock();
+    void writeLockUnlock();
+    void tryLock();
+    void writerWaitsForReaders();
+    void readersWaitForWriter();
+    void readersWritersLoop();
+};
+
+void tst_QReadMostlyLock::readLockUnlock()
+{
+    QReadMostlyLock lock;
+    lock.lockForRead();
+    lock.lockForRead(); // readers share the lock, even in the same thread
+    lock.unlock();
+    lock.unlock();
+    lock.lockForWrite();
+    lock.unlock();
+}
+
+void tst_QReadMostlyLock::writeLockUnlock()
+{
+    QReadMostlyLock lock;
+    for (int i = 0; i < 100; ++i) {
+        lock.lockForWrite();
+        lock.unlock();
+        lock.lockForRead();
+        lock.unlock();
+    }
+}
+
+void tst_QReadMostlyLock::tryLock()
+{
+    QReadMostlyLock lock;
+    QVERIFY(lock.tryLockForRead());
+    QVERIFY(!lock.tryLockForWrite());
+    QVERIFY(!lock.tryLockForWrite(QDeadlineTimer(10ms)));
+    QVERIFY(lock.tryLockForRead());     // the failed writer did not stay pending
+    lock.unlock();
+    lock.unlock();
+
+    QVERIFY(lock.tryLockForWrite());
+    QVERIFY(!lock.tryLockForRead());
+    QVERIFY(!lock.tryLockForRead(QDeadlineTimer(10ms)));
+    QVERIFY(!lock.tryLockForWrite());
+    lock.unlock();
+    QVERIFY(lock.tryLockForWrite());
+    lock.unlock();
+}
+
+void tst_QReadMostlyLock::writerWaitsForReaders()
+{
+    QReadMostlyLock lock;
+    QSemaphore readersIn;
+    QSemaphore release;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(QThread::create([&] {
+            lock.lockForRead();
+            readersIn.release();
+            release.acquire();
+            lock.unlock();
+        }));
+        readers.back()->start();
+    }
+    readersIn.acquire(4);
+
+    QVERIFY(!lock.tryLockForWrite(QDeadlineTimer(10ms)));
+    release.release(3);
+    QVERIFY(!lock.tryLockForWrite(QDeadlineTimer(10ms)));
+    release.release(1);
+    QVERIFY(lock.tryLockForWrite(QDeadlineTimer(10s)));
+    lock.unlock();
+    for (auto &t : readers)
+        QVERIFY(t->wait());
+}
+
+void tst_QReadMostlyLock::readersWaitForWriter()
+{
+    QReadMostlyLock lock;
+    std::atomic<bool> written = false;
+    lock.lockForWrite();
+
+    QSemaphore started;
+    std::atomic<int> sawWrite = 0;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(QThread::create([&] {
+            started.release();
+            lock.lockForRead();
+            if (written.load(std::memory_order_relaxed))
+                ++sawWrite;
+            lock.unlock();
+        }));
+        readers.back()->start();
+    }
+    started.acquire(4);
+    QTest::qSleep(10);
+    written.store(true, std::memory_order_relaxed);
+    lock.unlock();
+
+    for (auto &t : readers)
+        QVERIFY(t->wait());
+    QCOMPARE(sawWrite.load(), 4);
+}
+
+void tst_QReadMostlyLock::readersWritersLoop()
+{
+    QReadMostlyLock lock;
+    // the writers keep both halves equal, the readers check it
+    int first = 0;
+    int second = 0;
+    std::atomic<int> inconsistencies = 0;
+    constexpr int Iterations = 2000;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = 0; j < Iterations; ++j) {
+                lock.lockForRead();
+                if (first != second)
+                    ++inconsistencies;
+                lock.unlock();
+            }
+        }));
+    }
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = 0; j < Iterations / 10; ++j) {
+                lock.lockForWrite();
+                ++first;
+                QThread::yieldCurrentThread();
+                ++second;
+                lock.unlock();
+            }
+        }));
+    }
+    for (auto &t : threads)
+        t->start();
+    for (auto &t : threads)
+        QVERIFY(t->wait());
+
+    QCOMPARE(inconsistencies.load(), 0);
+    QCOMPARE(first, 2 * (Iterations / 10));
+    QCOMPARE(second, first);
+}
+
+QTEST_MAIN(tst_QReadMostlyLock)
+
+#include "tst_qreadmostlylock.moc"
@@ -88,6 +88,9 @@ private slots:
     void waitForDoneAfterTake();
     void threadReuse();
     void nullFunctions();
+    void workStealing();
+    void workStealingPriority();
+    void workStealingTryTake();
 
 private:
     QMutex m_functionTestMutex;
@@ -1488,5 +1491,80 @@ void tst_QThreadPool::nullFunctions()
     }
 }
 
+void tst_QThreadPool::workStealing()
+{
+    // tasks starting further tasks, as with recursive Qt Concurrent algorithms
+    QAtomicInt count;
+    TestThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    std::function<void(int)> spawn = [&](int depth) {
+        count.ref();
+        if (depth == 0)
+            return;
+        for (int i = 0; i < 4; ++i)
+            threadPool.start([&spawn, depth] { spawn(depth - 1); });
+    };
+    threadPool.start([&spawn] { spawn(6); });
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), (4 * 4 * 4 * 4 * 4 * 4 * 4 - 1) / 3);
+}
+
+void tst_QThreadPool::workStealingPriority()
+{
+    QSemaphore pushed;
+    QSemaphore proceed;
+    QAtomicPointer<QRunnable> firstStarted;
+    QRunnable *expected = nullptr;
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    threadPool.start([&] {
+        // these go to the local queue of the only thread
+        for (int i = 0; i < 3; ++i) {
+            threadPool.start([&firstStarted] {
+                firstStarted.testAndSetRelaxed(nullptr, reinterpret_cast<QRunnable *>(1));
+            });
+        }
+        pushed.release();
+        proceed.acquire();
+    });
+
+    pushed.acquire();
+    threadPool.start(expected = QRunnable::create([&firstStarted, &expected] {
+        firstStarted.testAndSetRelaxed(nullptr, expected);
+    }), 1);
+    proceed.release();
+
+    WAIT_FOR_DONE(threadPool);
+    QCOMPARE(firstStarted.loadRelaxed(), expected);
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    class Task : public QRunnable
+    {
+    public:
+        Task() { setAutoDelete(false); }
+        void run() override { ran.storeRelaxed(1); }
+        QAtomicInt ran;
+    };
+
+    Task task;
+    bool taken = false;
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+    threadPool.start([&] {
+        threadPool.start(&task);
+        taken = threadPool.tryTake(&task);
+    });
+    WAIT_FOR_DONE(threadPool);
+    QVERIFY(taken);
+    QCOMPARE(task.ran.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -23,6 +23,8 @@ private slots:
     void static_hash_data() { intermediary_result_data(); }
     void static_hash();
     void sha1();
+    void sha2_data();
+    void sha2();
     void sha3_data();
     void sha3();
     void keccak();
@@ -35,6 +37,10 @@ private slots:
     void hashLength();
     void addDataAcceptsNullByteArrayView_data() { all_methods(false); }
     void addDataAcceptsNullByteArrayView();
+    void chunkedAddData_data();
+    void chunkedAddData();
+    void hashMany_data() { all_methods(false); }
+    void hashMany();
     void move();
     void swap();
     // keep last
@@ -234,6 +240,37 @@ void tst_QCryptographicHash::sha1()
              QByteArray("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F"));
 }
 
+void tst_QCryptographicHash::sha2_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // test vectors from FIPS 180-2
+    const QByteArray twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    QTest::newRow("sha224_abc") << QCryptographicHash::Sha224 << QByteArray("abc")
+            << QByteArray::fromHex("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+    QTest::newRow("sha224_twoBlocks") << QCryptographicHash::Sha224 << twoBlocks
+            << QByteArray::fromHex("75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525");
+    QTest::newRow("sha224_millionA") << QCryptographicHash::Sha224 << QByteArray(1'000'000, 'a')
+            << QByteArray::fromHex("20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+    QTest::newRow("sha256_abc") << QCryptographicHash::Sha256 << QByteArray("abc")
+            << QByteArray::fromHex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    QTest::newRow("sha256_twoBlocks") << QCryptographicHash::Sha256 << twoBlocks
+            << QByteArray::fromHex("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    QTest::newRow("sha256_millionA") << QCryptographicHash::Sha256 << QByteArray(1'000'000, 'a')
+            << QByteArray::fromHex("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+void tst_QCryptographicHash::sha2()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expectedResult);
+
+    QCOMPARE(QCryptographicHash::hash(data, algorithm), expectedResult);
+}
+
 void tst_QCryptographicHash::sha3_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -542,6 +579,65 @@ void tst_QCryptographicHash::addDataAcceptsNullByteArrayView()
     QCOMPARE(hash2.resultView(), expected);
 }
 
+void tst_QCryptographicHash::chunkedAddData_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("chunkSize");
+
+    const auto me = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (auto algorithm : { QCryptographicHash::Sha1, QCryptographicHash::Sha224,
+                            QCryptographicHash::Sha256 }) {
+        // around the 64-byte block size of these algorithms
+        for (int chunkSize : { 1, 3, 55, 56, 63, 64, 65, 127, 128, 129, 1000 })
+            QTest::addRow("%s-%d", me.valueToKey(algorithm), chunkSize) << algorithm << chunkSize;
+    }
+}
+
+void tst_QCryptographicHash::chunkedAddData()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const int, chunkSize);
+
+    QByteArray data(1000, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); ++i)
+        data[i] = char(i * 131 + (i >> 3));
+
+    // every prefix of the data, so the final block has every possible fill level
+    for (qsizetype size = 0; size <= data.size(); size += 7) {
+        const QByteArrayView prefix = QByteArrayView(data).first(size);
+        QCryptographicHash hash(algorithm);
+        for (qsizetype pos = 0; pos < size; pos += chunkSize)
+            hash.addData(prefix.sliced(pos, qMin<qsizetype>(chunkSize, size - pos)));
+        QCOMPARE(hash.resultView(), QCryptographicHash::hash(prefix, algorithm));
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    if (!QCryptographicHash::supportsAlgorithm(algorithm))
+        QSKIP("QCryptographicHash doesn't support this algorithm");
+
+    const QByteArray data(300, 'x');
+    QList<QByteArrayView> messages;
+    for (qsizetype size : { 0, 1, 55, 64, 65, 300, 3 })
+        messages.append(QByteArrayView(data).first(size));
+
+    const QByteArrayList result = QCryptographicHash::hashMany(messages, algorithm);
+    QCOMPARE(result.size(), messages.size());
+    for (qsizetype i = 0; i < messages.size(); ++i)
+        QCOMPARE(result.at(i), QCryptographicHash::hash(messages.at(i), algorithm));
+
+    const qsizetype length = QCryptographicHash::hashLength(algorithm);
+    QByteArray buffer(length * messages.size(), Qt::Uninitialized);
+    QCOMPARE(QCryptographicHash::hashManyInto(buffer, messages, algorithm), result.join());
+    QVERIFY(QCryptographicHash::hashManyInto(QSpan(buffer).first(buffer.size() - 1), messages,
+                                             algorithm).isNull());
+
+    QVERIFY(QCryptographicHash::hashMany({}, algorithm).isEmpty());
+}
+
 void tst_QCryptographicHash::move()
 {
     QCryptographicHash hash1(QCryptographicHash::Sha1);
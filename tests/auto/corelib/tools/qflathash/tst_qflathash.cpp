@@ -0,0 +1,275 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <private/qflathash_p.h>
+#include <qhash.h>
+#include <qstring.h>
+
+#include <random>
+
+using namespace Qt::StringLiterals;
+
+// all keys collide in the 7-bit tag and in the first group
+struct BadKey
+{
+    int k;
+    friend bool operator==(BadKey lhs, BadKey rhs) noexcept { return lhs.k == rhs.k; }
+    friend size_t qHash(BadKey, size_t = 0) noexcept { return 0; }
+};
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void construction();
+    void insertAndFind();
+    void operatorBracket();
+    void removeAndTake();
+    void eraseWhileIterating();
+    void implicitSharing();
+    void reserveAndSqueeze();
+    void collidingKeys();
+    void randomOperations();
+    void insertReferenceToOwnElement();
+};
+
+void tst_QFlatHash::construction()
+{
+    QFlatHash<int, QString> empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.capacity(), 0);
+    QVERIFY(empty.constBegin() == empty.constEnd());
+    QVERIFY(!empty.contains(1));
+    QCOMPARE(empty.value(1, u"default"_s), u"default"_s);
+    QVERIFY(!empty.isDetached()); // lookups don't allocate
+
+    const QFlatHash<int, QString> list = { { 1, u"one"_s }, { 2, u"two"_s }, { 1, u"uno"_s } };
+    QCOMPARE(list.size(), 2);
+    QCOMPARE(list.value(1), u"uno"_s);
+    QCOMPARE(list.value(2), u"two"_s);
+}
+
+void tst_QFlatHash::insertAndFind()
+{
+    QFlatHash<QString, int> hash;
+    for (int i = 0; i < 1000; ++i) {
+        const auto it = hash.insert(QString::number(i), i);
+        QCOMPARE(it.key(), QString::number(i));
+        QCOMPARE(it.value(), i);
+    }
+    QCOMPARE(hash.size(), 1000);
+    QVERIFY(hash.capacity() >= 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        const auto it = hash.constFind(QString::number(i));
+        QVERIFY(it != hash.constEnd());
+        QCOMPARE(*it, i);
+        QVERIFY(hash.contains(QString::number(i)));
+    }
+    QVERIFY(hash.constFind(u"missing"_s) == hash.constEnd());
+
+    // inserting an existing key replaces the value
+    hash.insert(u"7"_s, -7);
+    QCOMPARE(hash.size(), 1000);
+    QCOMPARE(hash.value(u"7"_s), -7);
+
+    auto it = hash.find(u"8"_s);
+    QVERIFY(it != hash.end());
+    *it = -8;
+    QCOMPARE(hash.value(u"8"_s), -8);
+
+    qsizetype count = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+        ++count;
+    QCOMPARE(count, hash.size());
+}
+
+void tst_QFlatHash::operatorBracket()
+{
+    QFlatHash<int, QString> hash;
+    hash[1] = u"one"_s;
+    hash[2] += u"two"_s;
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash[1], u"one"_s);
+    QCOMPARE(hash[2], u"two"_s);
+
+    const auto &constHash = hash;
+    QCOMPARE(constHash[3], QString());
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QFlatHash::removeAndTake()
+{
+    QFlatHash<int, QString> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, QString::number(i));
+
+    QVERIFY(hash.remove(5));
+    QVERIFY(!hash.remove(5));
+    QVERIFY(!hash.contains(5));
+    QCOMPARE(hash.size(), 99);
+
+    QCOMPARE(hash.take(6), u"6"_s);
+    QCOMPARE(hash.take(6), QString());
+    QCOMPARE(hash.size(), 98);
+
+    // removed slots can be reused
+    hash.insert(5, u"five"_s);
+    QCOMPARE(hash.value(5), u"five"_s);
+    QCOMPARE(hash.size(), 99);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.remove(1));
+}
+
+void tst_QFlatHash::eraseWhileIterating()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 500; ++i)
+        hash.insert(i, i);
+
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 500 - 167);
+    for (int i = 0; i < 500; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, QString> hash;
+    for (int i = 0; i < 50; ++i)
+        hash.insert(i, QString::number(i));
+
+    QFlatHash<int, QString> copy = hash;
+    QVERIFY(copy.isSharedWith(hash));
+    QVERIFY(!hash.isDetached());
+
+    // const access doesn't detach
+    QCOMPARE(copy.value(3), u"3"_s);
+    QVERIFY(copy.constFind(4) != copy.constEnd());
+    QVERIFY(copy.isSharedWith(hash));
+
+    // neither does failing to find something
+    QVERIFY(!copy.remove(1000));
+    QVERIFY(copy.isSharedWith(hash));
+
+    copy.insert(1000, u"1000"_s);
+    QVERIFY(!copy.isSharedWith(hash));
+    QVERIFY(copy.isDetached());
+    QVERIFY(hash.isDetached());
+    QCOMPARE(copy.size(), 51);
+    QCOMPARE(hash.size(), 50);
+    QVERIFY(!hash.contains(1000));
+
+    // detaching keeps iterators usable
+    QFlatHash<int, QString> copy2 = hash;
+    auto it = copy2.find(7);
+    QVERIFY(!copy2.isSharedWith(hash));
+    *it = u"seven"_s;
+    QCOMPARE(copy2.value(7), u"seven"_s);
+    QCOMPARE(hash.value(7), u"7"_s);
+
+    copy2 = hash;
+    QVERIFY(copy2 == hash);
+    copy2.remove(7);
+    QVERIFY(copy2 != hash);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    QVERIFY(hash.capacity() >= 1000);
+    const qsizetype capacity = hash.capacity();
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity); // no rehashing needed
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QCOMPARE(hash.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+}
+
+void tst_QFlatHash::collidingKeys()
+{
+    QFlatHash<BadKey, int> hash;
+    for (int i = 0; i < 200; ++i)
+        hash.insert(BadKey{i}, i);
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 200; i += 2)
+        QVERIFY(hash.remove(BadKey{i}));
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.contains(BadKey{i}), i % 2 != 0);
+    // fill the erased slots again
+    for (int i = 200; i < 300; ++i)
+        hash.insert(BadKey{i}, i);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(hash.value(BadKey{i}, -1), i < 200 && i % 2 == 0 ? -1 : i);
+}
+
+void tst_QFlatHash::randomOperations()
+{
+    // compare with QHash under a mix of insertions, removals and copies
+    std::mt19937 rng(42);
+    QFlatHash<int, int> hash;
+    QHash<int, int> reference;
+    QFlatHash<int, int> snapshot;
+    QHash<int, int> snapshotReference;
+    for (int i = 0; i < 100000; ++i) {
+        const int key = int(rng() % 2000);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            hash.insert(key, i);
+            reference.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        case 3:
+            QCOMPARE(hash.value(key, -1), reference.value(key, -1));
+            break;
+        }
+        QCOMPARE(hash.size(), reference.size());
+        if (i % 10000 == 0) {
+            snapshot = hash;
+            snapshotReference = reference;
+        }
+    }
+
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+        QCOMPARE(it.value(), reference.value(it.key()));
+    QCOMPARE(snapshot.size(), snapshotReference.size());
+    for (auto it = snapshotReference.cbegin(); it != snapshotReference.cend(); ++it)
+        QCOMPARE(snapshot.value(it.key(), -1), it.value());
+}
+
+void tst_QFlatHash::insertReferenceToOwnElement()
+{
+    QFlatHash<int, QString> hash;
+    while (hash.size() < hash.capacity() || hash.isEmpty())
+        hash.insert(int(hash.size()), QString::number(hash.size()));
+
+    // the next insertion rehashes, moving the value we pass
+    const qsizetype capacity = hash.capacity();
+    hash.insert(-1, hash[3]);
+    QVERIFY(hash.capacity() > capacity);
+    QCOMPARE(hash.value(-1), u"3"_s);
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+
+#include "tst_qflathash.moc"
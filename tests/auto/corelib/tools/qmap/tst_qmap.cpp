@@ -64,6 +64,10 @@ private slots:
     void eraseValidIteratorOnSharedMap();
     void removeElementsInMap();
     void toStdMap();
+    void toStdMapTransparentKeys();
+    void heterogeneousSearchString();
+    void heterogeneousSearchLatin1String();
+    void heterogeneousSearchByteArray();
 
     void multiMapStoresInReverseInsertionOrder();
 
@@ -2560,6 +2564,115 @@ void tst_QMap::toStdMap()
     toStdMapTestMethod<QMultiMap<int, QString>>(expectedMultiMap);
 }
 
+void tst_QMap::toStdMapTransparentKeys()
+{
+    // std::less<QString> is transparent, but still the default comparator
+    static_assert(std::is_same_v<std::less<QString>::is_transparent, void>);
+    static_assert(std::is_same_v<std::less<QByteArray>::is_transparent, void>);
+    const std::map<QString, int> stdMap { {u"b"_s, 2}, {u"a"_s, 1}, {u"c"_s, 3} };
+    QMap<QString, int> map(stdMap);
+    QCOMPARE(map.keys(), QStringList({ u"a"_s, u"b"_s, u"c"_s }));
+    QCOMPARE(map.toStdMap(), stdMap);
+    QCOMPARE(std::move(map).toStdMap(), stdMap);
+
+    // moving in and out doesn't copy the nodes
+    std::map<QString, int> movedFrom = stdMap;
+    const int *node = &movedFrom.find(u"b"_s)->second;
+    QMap<QString, int> fromMoved(std::move(movedFrom));
+    QCOMPARE(&*std::as_const(fromMoved).find(u"b"_s), node);
+    std::map<QString, int> movedOut = std::move(fromMoved).toStdMap();
+    QCOMPARE(&movedOut.find(u"b"_s)->second, node);
+    QCOMPARE(movedOut, stdMap);
+
+    const std::multimap<QByteArray, int> stdMultiMap { {"a", 1}, {"b", 2}, {"a", 3} };
+    QMultiMap<QByteArray, int> multiMap(stdMultiMap);
+    QCOMPARE(multiMap.values("a"), (QList<int>{ 1, 3 }));
+    QCOMPARE(multiMap.toStdMultiMap(), stdMultiMap);
+    QCOMPARE(std::move(multiMap).toStdMultiMap(), stdMultiMap);
+}
+
+template <typename String, typename View>
+static void heterogeneousSearchTest(const QList<String> &keys, const QList<View> &views,
+                                    View missing)
+{
+#ifdef __cpp_concepts
+    QCOMPARE(keys.size(), 3);
+    QMap<String, qsizetype> map;
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        map.insert(keys.at(i), i);
+
+    for (qsizetype i = 0; i < views.size(); ++i) {
+        const View view = views.at(i);
+        QVERIFY(map.contains(view));
+        QCOMPARE(map.count(view), 1);
+        QCOMPARE(map.value(view), i);
+        QCOMPARE(map.value(view, -1), i);
+        QCOMPARE(std::as_const(map)[view], i);
+        QCOMPARE(map.find(view).key(), keys.at(i));
+        QCOMPARE(std::as_const(map).find(view).key(), keys.at(i));
+        QCOMPARE(map.constFind(view).key(), keys.at(i));
+        QCOMPARE(map.lowerBound(view).key(), keys.at(i));
+        QCOMPARE(std::as_const(map).upperBound(view), std::next(map.constFind(keys.at(i))));
+        const auto range = std::as_const(map).equal_range(view);
+        QCOMPARE(std::distance(range.first, range.second), 1);
+    }
+    QVERIFY(!map.contains(missing));
+    QCOMPARE(map.count(missing), 0);
+    QCOMPARE(map.value(missing, -1), -1);
+    QVERIFY(map.constFind(missing) == map.constEnd());
+
+    // modifying functions detach as usual
+    QMap<String, qsizetype> copy = map;
+    QCOMPARE(copy.take(views.first()), 0);
+    QCOMPARE(copy.remove(views.last()), 1);
+    QCOMPARE(copy.remove(missing), 0);
+    QCOMPARE(copy.size(), 1);
+    QCOMPARE(map.size(), 3);
+    copy[missing] = 42;
+    QCOMPARE(copy.value(String(missing)), 42);
+    QCOMPARE(copy.size(), 2);
+
+    QMultiMap<String, qsizetype> multiMap(map);
+    multiMap.insert(keys.first(), -1);
+    const View view = views.first();
+    QVERIFY(multiMap.contains(view));
+    QCOMPARE(multiMap.count(view), 2);
+    QCOMPARE(multiMap.value(view), -1);
+    QCOMPARE(multiMap.values(view), (QList<qsizetype>{ -1, 0 }));
+    QCOMPARE(multiMap.find(view).value(), -1);
+    QCOMPARE(std::distance(multiMap.lowerBound(view), multiMap.upperBound(view)), 2);
+    QCOMPARE(multiMap.value(missing, -2), -2);
+    QMultiMap<String, qsizetype> multiCopy = multiMap;
+    QCOMPARE(multiCopy.remove(view), 2);
+    QCOMPARE(multiCopy.size(), 2);
+    QCOMPARE(multiMap.size(), 4);
+#else
+    Q_UNUSED(keys);
+    Q_UNUSED(views);
+    Q_UNUSED(missing);
+    QSKIP("This feature requires C++20 (concepts)");
+#endif
+}
+
+void tst_QMap::heterogeneousSearchString()
+{
+    heterogeneousSearchTest<QString, QStringView>({ u"Hello"_s, u"World"_s, u"\u00fcber"_s },
+                                                  { u"Hello", u"World", u"\u00fcber" }, u"Hell");
+}
+
+void tst_QMap::heterogeneousSearchLatin1String()
+{
+    heterogeneousSearchTest<QString, QLatin1StringView>({ u"Hello"_s, u"World"_s, u"\u00fcber"_s },
+                                                        { "Hello"_L1, "World"_L1, "\xfc" "ber"_L1 },
+                                                        "Hell"_L1);
+}
+
+void tst_QMap::heterogeneousSearchByteArray()
+{
+    heterogeneousSearchTest<QByteArray, QByteArrayView>({ "Hello"_ba, "World"_ba, "\xfc" "ber"_ba },
+                                                        { "Hello", "World", "\xfc" "ber" }, "Hell");
+}
+
 void tst_QMap::multiMapStoresInReverseInsertionOrder()
 {
     const QString strings[] = {
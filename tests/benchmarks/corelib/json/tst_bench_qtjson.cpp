@@ -3,8 +3,13 @@
 
 #include <QTest>
 #include <QVariantMap>
+#include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
+#include <qjsonstreamwriter.h>
+
+using namespace Qt::StringLiterals;
 
 class BenchmarkQtJson: public QObject
 {
@@ -21,6 +26,16 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseGeneratedJson_data();
+    void parseGeneratedJson();
+    void streamReadJson();
+    void streamReadJsonToValue();
+    void streamReadGeneratedJson_data();
+    void streamReadGeneratedJson();
+    void toJson_data();
+    void toJson();
+    void streamWriteJson_data();
+    void streamWriteJson();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -93,6 +108,164 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+// A document shaped like a social media API response: objects with many
+// string members, long free-form text, some of it non-ASCII or escaped.
+static QByteArray stringHeavyJson(QJsonDocument::JsonFormat format)
+{
+    QJsonArray statuses;
+    for (int i = 0; i < 2000; ++i) {
+        QJsonObject user;
+        user["id_str"_L1] = QString::number(1000000 + i * 7919);
+        user["name"_L1] = u"User Nämé %1"_s.arg(i);
+        user["screen_name"_L1] = u"user_%1"_s.arg(i);
+        user["location"_L1] = u"Oslo, Norway"_s;
+        user["description"_L1] = u"Writes about \"software\", music and travel.\n"
+                                  "Opinions are my own. ☕"_s;
+        user["verified"_L1] = (i % 13) == 0;
+        user["followers_count"_L1] = i * 31;
+
+        QJsonObject status;
+        status["created_at"_L1] = u"Sun Aug 31 00:29:15 +0000 2014"_s;
+        status["id_str"_L1] = QString::number(505874924095815681LL + i);
+        status["text"_L1] = u"@friend_%1 This is a fairly typical message, long enough to span "
+                             "a few vector blocks, with a link https://example.com/%1 and a "
+                             "hashtag #json"_s.arg(i);
+        status["source"_L1] = u"<a href=\"https://example.com/app\" rel=\"nofollow\">App</a>"_s;
+        status["lang"_L1] = u"en"_s;
+        status["user"_L1] = user;
+        status["retweet_count"_L1] = i % 17;
+        status["favorited"_L1] = false;
+        statuses.append(status);
+    }
+    return QJsonDocument(QJsonObject{ { "statuses"_L1, statuses } }).toJson(format);
+}
+
+// A document shaped like GeoJSON map data: deeply nested arrays of
+// coordinate pairs and very little else.
+static QByteArray numberHeavyJson(QJsonDocument::JsonFormat format)
+{
+    QJsonArray rings;
+    for (int ring = 0; ring < 50; ++ring) {
+        QJsonArray points;
+        for (int i = 0; i < 1000; ++i) {
+            const double t = ring * 1000 + i;
+            points.append(QJsonArray{ -65.613616999999977 + t / 7919.0,
+                                      43.420273000000009 - t / 104729.0 });
+        }
+        rings.append(points);
+    }
+    QJsonObject geometry{ { "type"_L1, "Polygon"_L1 }, { "coordinates"_L1, rings } };
+    return QJsonDocument(QJsonObject{ { "type"_L1, "Feature"_L1 },
+                                      { "geometry"_L1, geometry } }).toJson(format);
+}
+
+static void generatedJsonData()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("strings-indented") << stringHeavyJson(QJsonDocument::Indented);
+    QTest::newRow("strings-compact") << stringHeavyJson(QJsonDocument::Compact);
+    QTest::newRow("numbers-indented") << numberHeavyJson(QJsonDocument::Indented);
+    QTest::newRow("numbers-compact") << numberHeavyJson(QJsonDocument::Compact);
+}
+
+void BenchmarkQtJson::parseGeneratedJson_data()
+{
+    generatedJsonData();
+}
+
+void BenchmarkQtJson::parseGeneratedJson()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void BenchmarkQtJson::streamReadJson()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        while (!reader.atEnd())
+            reader.readNext();
+        QVERIFY(!reader.hasError());
+    }
+}
+
+void BenchmarkQtJson::streamReadJsonToValue()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        reader.readNext();
+        QJsonValue value = reader.readValue();
+    }
+}
+
+void BenchmarkQtJson::streamReadGeneratedJson_data()
+{
+    generatedJsonData();
+}
+
+void BenchmarkQtJson::streamReadGeneratedJson()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonStreamReader reader(json);
+        while (!reader.atEnd())
+            reader.readNext();
+        QVERIFY(!reader.hasError());
+    }
+}
+
+void BenchmarkQtJson::toJson_data()
+{
+    generatedJsonData();
+}
+
+void BenchmarkQtJson::toJson()
+{
+    QFETCH(QByteArray, json);
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+
+    QBENCHMARK {
+        QByteArray output = doc.toJson(QJsonDocument::Compact);
+    }
+}
+
+void BenchmarkQtJson::streamWriteJson_data()
+{
+    generatedJsonData();
+}
+
+void BenchmarkQtJson::streamWriteJson()
+{
+    QFETCH(QByteArray, json);
+    const QJsonObject object = QJsonDocument::fromJson(json).object();
+
+    QBENCHMARK {
+        QByteArray output;
+        QJsonStreamWriter writer(&output);
+        writer.setFormat(QJsonDocument::Compact);
+        writer.writeValue(object);
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
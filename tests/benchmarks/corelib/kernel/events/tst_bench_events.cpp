@@ -58,6 +58,28 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class SignalEmitter : public QObject
+{
+    Q_OBJECT
+signals:
+    void ping();
+};
+
+class SignalCounter : public QObject
+{
+    Q_OBJECT
+public:
+    int expected = 0;
+    int received = 0;
+
+public slots:
+    void count()
+    {
+        if (++received == expected)
+            QTestEventLoop::instance().exitLoop();
+    }
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -71,6 +93,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void queuedSignals_data();
+    void queuedSignals();
 };
 
 void EventsBench::initTestCase()
@@ -145,6 +169,51 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::queuedSignals_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("16 threads") << 16;
+    QTest::newRow("64 threads") << 64;
+}
+
+// Several threads emitting a queued signal to one receiver: measures the
+// contention on the receiving thread's posted event list.
+void EventsBench::queuedSignals()
+{
+    QFETCH(int, producers);
+    const int signalsPerProducer = 64 * 1024 / producers;
+
+    SignalCounter counter;
+    std::vector<std::unique_ptr<SignalEmitter>> emitters;
+    for (int i = 0; i < producers; ++i) {
+        emitters.push_back(std::make_unique<SignalEmitter>());
+        connect(emitters.back().get(), &SignalEmitter::ping,
+                &counter, &SignalCounter::count, Qt::QueuedConnection);
+    }
+
+    QBENCHMARK {
+        counter.received = 0;
+        counter.expected = producers * signalsPerProducer;
+
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (const auto &emitter : emitters) {
+            threads.emplace_back(QThread::create([emitter = emitter.get(), signalsPerProducer] {
+                for (int i = 0; i < signalsPerProducer; ++i)
+                    emit emitter->ping();
+            }));
+        }
+        for (const auto &thread : threads)
+            thread->start();
+
+        QTestEventLoop::instance().enterLoop(60);
+        for (const auto &thread : threads)
+            thread->wait();
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "tst_bench_events.moc"
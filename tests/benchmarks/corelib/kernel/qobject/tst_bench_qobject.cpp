@@ -6,6 +6,9 @@
 #include "object.h"
 #include <qcoreapplication.h>
 #include <qdatetime.h>
+#include <private/qobject_p.h>
+
+using namespace Qt::StringLiterals;
 
 enum {
     CreationDeletionBenckmarkConstant = 34567,
@@ -26,6 +29,8 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_signal_benchmark_data();
+    void queued_signal_benchmark();
 
     void stdAllocator();
 };
@@ -280,6 +285,44 @@ void tst_QObject::receiver_destroyed_benchmark()
     }
 }
 
+void tst_QObject::queued_signal_benchmark_data()
+{
+    QTest::addColumn<bool>("withArgument");
+    QTest::newRow("no arguments") << false;
+    QTest::newRow("QString argument") << true;
+}
+
+void tst_QObject::queued_signal_benchmark()
+{
+    QFETCH(bool, withArgument);
+    Object sender;
+    Object receiver;
+    QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0, Qt::QueuedConnection);
+    QObject::connect(&sender, &QObject::objectNameChanged, &receiver, [](const QString &) {},
+                     Qt::QueuedConnection);
+
+    // stays within the capacity of the thread's QMetaCallEvent pool
+    constexpr int EmissionsPerRound = 256;
+    const QString names[] = { u"even"_s, u"odd"_s };
+    const auto before = QMetaCallEvent::allocationCounters();
+    QBENCHMARK {
+        for (int i = 0; i < EmissionsPerRound; ++i) {
+            if (withArgument)
+                sender.setObjectName(names[i % 2]);
+            else
+                sender.emitSignal0();
+        }
+        QCoreApplication::processEvents();
+    }
+    const auto after = QMetaCallEvent::allocationCounters();
+
+    // only the first round needs to allocate
+    const quint64 allocated = after.allocated - before.allocated;
+    QVERIFY(after.reused - before.reused >= allocated - EmissionsPerRound);
+    if (withArgument)
+        QCOMPARE(after.inlineArgs - before.inlineArgs, allocated);
+}
+
 QTEST_MAIN(tst_QObject)
 
 #include "tst_bench_qobject.moc"
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <QtCore>
+#include <qtest.h>
+
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// The dispatcher backend is chosen when a thread's event dispatcher is
+// created, so each data row runs its notifiers in a freshly started thread.
+static bool glibDisabled = []() {
+    qputenv("QT_NO_GLIB", "1");
+    return true;
+}();
+
+class NotifierSet : public QObject
+{
+    Q_OBJECT
+public:
+    QList<int> fds;
+    QSemaphore activations;
+
+public slots:
+    bool create(int count)
+    {
+        fds.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fd == -1)
+                return false;
+            fds.append(fd);
+            auto notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+            connect(notifier, &QSocketNotifier::activated, this, &NotifierSet::activated);
+        }
+        return true;
+    }
+
+    void destroy()
+    {
+        qDeleteAll(findChildren<QSocketNotifier *>());
+        for (int fd : std::as_const(fds))
+            ::close(fd);
+        fds.clear();
+    }
+
+private:
+    void activated(QSocketDescriptor fd)
+    {
+        eventfd_t value;
+        eventfd_read(fd, &value);
+        activations.release();
+    }
+};
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void wakeUpLatency_data();
+    void wakeUpLatency();
+};
+
+void tst_QSocketNotifier::initTestCase()
+{
+    // 10k notifiers need more descriptors than the usual soft limit
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QSocketNotifier::wakeUpLatency_data()
+{
+    QTest::addColumn<bool>("epoll");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 100, 1000, 10000 }) {
+        QTest::addRow("poll-%d", count) << false << count;
+        QTest::addRow("epoll-%d", count) << true << count;
+    }
+}
+
+void tst_QSocketNotifier::wakeUpLatency()
+{
+    QFETCH(bool, epoll);
+    QFETCH(int, count);
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < rlim_t(count + 64))
+        QSKIP("Not enough file descriptors available");
+
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", epoll ? "1" : "0");
+    QThread thread;
+    thread.start();
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    NotifierSet set;
+    set.moveToThread(&thread);
+    bool created = false;
+    QMetaObject::invokeMethod(&set, "create", Qt::BlockingQueuedConnection,
+                              qReturnArg(created), count);
+    auto cleanup = qScopeGuard([&] {
+        QMetaObject::invokeMethod(&set, "destroy", Qt::BlockingQueuedConnection);
+        thread.quit();
+        thread.wait();
+    });
+    QVERIFY(created);
+
+    // signal a different descriptor every time, so the cost of scanning the
+    // whole set is part of each round trip
+    qsizetype next = 0;
+    QBENCHMARK {
+        eventfd_write(set.fds.at(next), 1);
+        set.activations.acquire();
+        next = (next + 1) % set.fds.size();
+    }
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "tst_bench_qsocketnotifier.moc"
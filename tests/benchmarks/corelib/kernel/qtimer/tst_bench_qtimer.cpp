@@ -0,0 +1,108 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include <QtCore>
+#include <qtest.h>
+
+using namespace std::chrono_literals;
+
+// Many objects with a timeout each, like the connections of a server
+class TimeoutSet : public QObject
+{
+public:
+    QList<int> ids;
+    int fired = 0;
+
+    void start(int count, Qt::TimerType type)
+    {
+        ids.reserve(count);
+        for (int i = 0; i < count; ++i)
+            ids.append(startTimer(interval(i), type));
+    }
+
+    void stop()
+    {
+        for (int id : std::as_const(ids))
+            killTimer(id);
+        ids.clear();
+    }
+
+    // spread the timeouts over a few minutes
+    static std::chrono::milliseconds interval(int i) { return 60s + (i % 1000) * 100ms; }
+
+protected:
+    void timerEvent(QTimerEvent *) override { ++fired; }
+};
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void registerTimers_data();
+    void registerTimers();
+    void restartTimer_data() { registerTimers_data(); }
+    void restartTimer();
+    void activateWithPendingTimers_data() { registerTimers_data(); }
+    void activateWithPendingTimers();
+};
+
+void tst_QTimer::registerTimers_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("type");
+    for (int count : { 1000, 10000, 100000 }) {
+        QTest::addRow("%d precise", count) << count << Qt::PreciseTimer;
+        QTest::addRow("%d coarse", count) << count << Qt::CoarseTimer;
+    }
+}
+
+void tst_QTimer::registerTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    TimeoutSet set;
+    QBENCHMARK {
+        set.start(count, type);
+        set.stop();
+    }
+}
+
+void tst_QTimer::restartTimer()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    TimeoutSet set;
+    set.start(count, type);
+
+    // what a server does when a connection receives data
+    int i = 0;
+    QBENCHMARK {
+        set.killTimer(set.ids[i]);
+        set.ids[i] = set.startTimer(TimeoutSet::interval(i), type);
+        i = (i + 1) % count;
+    }
+    set.stop();
+}
+
+void tst_QTimer::activateWithPendingTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    TimeoutSet set;
+    set.start(count, type);
+
+    TimeoutSet zeroTimer;
+    zeroTimer.startTimer(0ms);
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+    QVERIFY(zeroTimer.fired > 0);
+    QCOMPARE(set.fired, 0);
+    set.stop();
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
@@ -1,11 +1,15 @@
 // Copyright (C) 2023 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
+#include <QCborArray>
 #include <QCborMap>
 #include <QCborValue>
+#include <QCborValueView>
 
 #include <QTest>
 
+using namespace Qt::StringLiterals;
+
 template <typename Char>
 struct SampleStrings
 {
@@ -51,6 +55,11 @@ private slots:
     void constructString() { doConstruct<QString>(); }
     void constructStringView() { doConstruct<QStringView>(); }
     void constructConstCharPtr() { doConstruct<char>(); }
+
+    void lookupInEncoded_data();
+    void lookupInEncoded();
+    void lookupInEncodedView_data() { lookupInEncoded_data(); }
+    void lookupInEncodedView();
 };
 
 template <typename Type>
@@ -90,6 +99,48 @@ void tst_QCborValue::doConstruct()
     }
 }
 
+void tst_QCborValue::lookupInEncoded_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    for (int count : { 10, 1000, 100000 }) {
+        QCborArray records;
+        for (int i = 0; i < count; ++i) {
+            records.append(QCborMap{
+                    { u"id"_s, i },
+                    { u"name"_s, u"record %1"_s.arg(i) },
+                    { u"values"_s, QCborArray{ i * 0.5, i * 0.25, -i } } });
+        }
+        const QCborMap document{ { u"records"_s, records }, { u"count"_s, count } };
+        QTest::addRow("%d-records", count) << QCborValue(document).toCbor();
+    }
+}
+
+// Decodes the whole document to read a single value
+void tst_QCborValue::lookupInEncoded()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        const QCborValue document = QCborValue::fromCbor(data);
+        const QCborArray records = document[u"records"_s].toArray();
+        [[maybe_unused]] const QString name = records.last()[u"name"_s].toString();
+    }
+}
+
+// Reads a single value in place
+void tst_QCborValue::lookupInEncodedView()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        const QCborValueView document(data);
+        const QCborArrayView records = document.toMap()[u"records"].toArray();
+        [[maybe_unused]] const QString name =
+                records.at(records.size() - 1).toMap()[u"name"].toString();
+    }
+}
+
 QTEST_MAIN(tst_QCborValue)
 
 #include "tst_bench_qcborvalue.moc"
@@ -0,0 +1,188 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QList>
+
+#include <QTest>
+
+class tst_QDataStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeDoubleList_data();
+    void writeDoubleList();
+    void writeDoubleListPerElement_data() { writeDoubleList_data(); }
+    void writeDoubleListPerElement();
+    void readDoubleList_data() { writeDoubleList_data(); }
+    void readDoubleList();
+    void readDoubleListPerElement_data() { writeDoubleList_data(); }
+    void readDoubleListPerElement();
+
+    void writeByteArrayList_data();
+    void writeByteArrayList();
+    void readByteArrayList_data() { writeByteArrayList_data(); }
+    void readByteArrayList();
+};
+
+static QList<double> doubleList(qsizetype size)
+{
+    QList<double> list;
+    list.reserve(size);
+    for (qsizetype i = 0; i < size; ++i)
+        list.append(i * 0.125 - 1000);
+    return list;
+}
+
+void tst_QDataStream::writeDoubleList_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<qsizetype>("size");
+
+    for (qsizetype size : { 100, 10'000, 1'000'000 }) {
+        QTest::addRow("BE-%lld", qlonglong(size)) << QDataStream::BigEndian << size;
+        QTest::addRow("LE-%lld", qlonglong(size)) << QDataStream::LittleEndian << size;
+    }
+}
+
+void tst_QDataStream::writeDoubleList()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(qsizetype, size);
+    const QList<double> list = doubleList(size);
+
+    QByteArray data;
+    QBENCHMARK {
+        data.clear();
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream << list;
+    }
+}
+
+// What operator<<() did before it streamed lists of arithmetic types in bulk
+void tst_QDataStream::writeDoubleListPerElement()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(qsizetype, size);
+    const QList<double> list = doubleList(size);
+
+    QByteArray data;
+    QBENCHMARK {
+        data.clear();
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream << quint32(list.size());
+        for (double d : list)
+            stream << d;
+    }
+}
+
+void tst_QDataStream::readDoubleList()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(qsizetype, size);
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream << doubleList(size);
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QList<double> list;
+    QBENCHMARK {
+        buffer.seek(0);
+        QDataStream stream(&buffer);
+        stream.setByteOrder(byteOrder);
+        stream >> list;
+    }
+    QCOMPARE(list.size(), size);
+}
+
+// What operator>>() did before it streamed lists of arithmetic types in bulk
+void tst_QDataStream::readDoubleListPerElement()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(qsizetype, size);
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream << doubleList(size);
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QList<double> list;
+    QBENCHMARK {
+        buffer.seek(0);
+        QDataStream stream(&buffer);
+        stream.setByteOrder(byteOrder);
+        quint32 n;
+        stream >> n;
+        list.clear();
+        list.reserve(n);
+        for (quint32 i = 0; i < n; ++i) {
+            double d;
+            stream >> d;
+            list.append(d);
+        }
+    }
+    QCOMPARE(list.size(), size);
+}
+
+void tst_QDataStream::writeByteArrayList_data()
+{
+    QTest::addColumn<qsizetype>("count");
+    QTest::addColumn<qsizetype>("length");
+
+    QTest::newRow("10000x16") << qsizetype(10'000) << qsizetype(16);
+    QTest::newRow("1000x1024") << qsizetype(1'000) << qsizetype(1024);
+    QTest::newRow("10x1M") << qsizetype(10) << qsizetype(1024 * 1024);
+}
+
+void tst_QDataStream::writeByteArrayList()
+{
+    QFETCH(qsizetype, count);
+    QFETCH(qsizetype, length);
+    const QList<QByteArray> list(count, QByteArray(length, 'x'));
+
+    QByteArray data;
+    QBENCHMARK {
+        data.clear();
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << list;
+    }
+}
+
+void tst_QDataStream::readByteArrayList()
+{
+    QFETCH(qsizetype, count);
+    QFETCH(qsizetype, length);
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << QList<QByteArray>(count, QByteArray(length, 'x'));
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QList<QByteArray> list;
+    QBENCHMARK {
+        buffer.seek(0);
+        QDataStream stream(&buffer);
+        stream >> list;
+    }
+    QCOMPARE(list.size(), count);
+}
+
+QTEST_MAIN(tst_QDataStream)
+
+#include "tst_bench_qdatastream.moc"
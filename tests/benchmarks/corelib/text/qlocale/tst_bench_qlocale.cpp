@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QLocale>
+#include <QStringList>
 #include <QTest>
 
+#include <cmath>
+
 using namespace Qt::StringLiterals;
 
 class tst_QLocale : public QObject
@@ -37,6 +40,14 @@ private Q_SLOTS:
     void toULongLong();
     void toDouble_data();
     void toDouble();
+    void doubleToString_data();
+    void doubleToString();
+    void numberDouble_QString_data() { doubleToString_data(); }
+    void numberDouble_QString();
+    void numberDouble_QByteArray_data() { doubleToString_data(); }
+    void numberDouble_QByteArray();
+    void doubleRoundTrip_data() { doubleToString_data(); }
+    void doubleRoundTrip();
 };
 
 static QString data()
@@ -588,6 +599,103 @@ void tst_QLocale::toDouble()
     QCOMPARE(actual, expected);
 }
 
+// A mix of magnitudes and digit counts, as found in CSV or JSON exports:
+static QList<double> sampleDoubles()
+{
+    QList<double> values;
+    values.reserve(1000);
+    double x = 0.1;
+    for (int i = 0; i < 1000; ++i) {
+        x = x * 1.618033988749895 + 0.7;
+        if (x > 1e12)
+            x /= 1e13;
+        values.append(i % 3 ? x : std::round(x * 100) / 100);
+    }
+    return values;
+}
+
+void tst_QLocale::doubleToString_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+
+    QTest::newRow("C: g shortest") << u"C"_s << 'g' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("C: e shortest") << u"C"_s << 'e' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("C: f shortest") << u"C"_s << 'f' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("C: g 6") << u"C"_s << 'g' << 6;
+    QTest::newRow("C: f 2") << u"C"_s << 'f' << 2;
+    QTest::newRow("C: g 17") << u"C"_s << 'g' << 17;
+    // Generic localized formatting, for comparison:
+    QTest::newRow("en: g shortest") << u"en"_s << 'g' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("en: f 2") << u"en"_s << 'f' << 2;
+    QTest::newRow("de: g shortest") << u"de"_s << 'g' << int(QLocale::FloatingPointShortest);
+}
+
+void tst_QLocale::doubleToString()
+{
+    QFETCH(QString, locale);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+
+    const QLocale loc(locale);
+    const QList<double> values = sampleDoubles();
+    QString s;
+    QBENCHMARK {
+        for (double value : values)
+            s = loc.toString(value, format, precision);
+    }
+}
+
+void tst_QLocale::numberDouble_QString()
+{
+    QFETCH(char, format);
+    QFETCH(int, precision);
+
+    const QList<double> values = sampleDoubles();
+    QString s;
+    QBENCHMARK {
+        for (double value : values)
+            s = QString::number(value, format, precision);
+    }
+}
+
+void tst_QLocale::numberDouble_QByteArray()
+{
+    QFETCH(char, format);
+    QFETCH(int, precision);
+
+    const QList<double> values = sampleDoubles();
+    QByteArray s;
+    QBENCHMARK {
+        for (double value : values)
+            s = QByteArray::number(value, format, precision);
+    }
+}
+
+void tst_QLocale::doubleRoundTrip()
+{
+    QFETCH(QString, locale);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+
+    const QLocale loc(locale);
+    const QList<double> values = sampleDoubles();
+    QStringList texts;
+    for (double value : values)
+        texts.append(loc.toString(value, format, precision));
+
+    bool allOk = true;
+    QBENCHMARK {
+        for (const QString &text : std::as_const(texts)) {
+            bool ok = false;
+            const double value = loc.toDouble(text, &ok);
+            allOk = allOk && ok && qIsFinite(value);
+        }
+    }
+    QVERIFY(allOk);
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -0,0 +1,140 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QByteArrayMatcher>
+#include <QMultiStringMatcher>
+#include <QRandomGenerator>
+#include <QStringMatcher>
+#include <QTest>
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void byteArray_data();
+    void byteArray();
+    void string_data();
+    void string();
+
+private:
+    static QByteArrayList keywords(int count);
+    static QByteArray text();
+};
+
+QByteArrayList tst_QMultiStringMatcher::keywords(int count)
+{
+    QByteArrayList result;
+    for (int i = 0; i < count; ++i)
+        result.append("keyword" + QByteArray::number(i, 36));
+    return result;
+}
+
+// 1 MiB of random words, a few of which are keywords
+QByteArray tst_QMultiStringMatcher::text()
+{
+    QRandomGenerator rng(1);
+    QByteArray result;
+    while (result.size() < 1024 * 1024) {
+        if (rng.bounded(100) == 0) {
+            result += "keyword" + QByteArray::number(rng.bounded(1000), 36);
+        } else {
+            for (int i = 0, length = rng.bounded(2, 10); i < length; ++i)
+                result += char('a' + rng.bounded(26));
+        }
+        result += ' ';
+    }
+    return result;
+}
+
+void tst_QMultiStringMatcher::byteArray_data()
+{
+    QTest::addColumn<bool>("multi");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 1, 10, 100 }) {
+        QTest::addRow("QByteArrayMatcher:%d", count) << false << count;
+        QTest::addRow("QMultiByteArrayMatcher:%d", count) << true << count;
+    }
+}
+
+void tst_QMultiStringMatcher::byteArray()
+{
+    QFETCH(const bool, multi);
+    QFETCH(const int, count);
+
+    const QByteArrayList needles = keywords(count);
+    const QByteArray haystack = text();
+    qsizetype found = 0;
+    if (multi) {
+        const QMultiByteArrayMatcher matcher(needles);
+        QBENCHMARK {
+            found = matcher.matches(haystack).size();
+        }
+    } else {
+        QList<QByteArrayMatcher> matchers;
+        for (const QByteArray &needle : needles)
+            matchers.append(QByteArrayMatcher(needle));
+        QBENCHMARK {
+            found = 0;
+            for (const QByteArrayMatcher &matcher : std::as_const(matchers)) {
+                for (qsizetype i = matcher.indexIn(haystack); i >= 0;
+                     i = matcher.indexIn(haystack, i + 1)) {
+                    ++found;
+                }
+            }
+        }
+    }
+    QCOMPARE_GT(found, 0);
+}
+
+void tst_QMultiStringMatcher::string_data()
+{
+    QTest::addColumn<bool>("multi");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 10, 100 }) {
+        QTest::addRow("QStringMatcher:%d", count) << false << count << Qt::CaseSensitive;
+        QTest::addRow("QMultiStringMatcher:%d", count) << true << count << Qt::CaseSensitive;
+        QTest::addRow("QStringMatcher:%d:ci", count) << false << count << Qt::CaseInsensitive;
+        QTest::addRow("QMultiStringMatcher:%d:ci", count) << true << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QMultiStringMatcher::string()
+{
+    QFETCH(const bool, multi);
+    QFETCH(const int, count);
+    QFETCH(const Qt::CaseSensitivity, cs);
+
+    QStringList needles;
+    for (const QByteArray &keyword : keywords(count))
+        needles.append(QString::fromLatin1(keyword));
+    const QString haystack = QString::fromLatin1(text());
+    qsizetype found = 0;
+    if (multi) {
+        const QMultiStringMatcher matcher(needles, cs);
+        QBENCHMARK {
+            found = matcher.matches(haystack).size();
+        }
+    } else {
+        QList<QStringMatcher> matchers;
+        for (const QString &needle : std::as_const(needles))
+            matchers.append(QStringMatcher(needle, cs));
+        QBENCHMARK {
+            found = 0;
+            for (const QStringMatcher &matcher : std::as_const(matchers)) {
+                for (qsizetype i = matcher.indexIn(haystack); i >= 0;
+                     i = matcher.indexIn(haystack, i + 1)) {
+                    ++found;
+                }
+            }
+        }
+    }
+    QCOMPARE_GT(found, 0);
+}
+
+QTEST_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_bench_qmultistringmatcher.moc"
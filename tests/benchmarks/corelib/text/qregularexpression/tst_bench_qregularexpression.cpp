@@ -4,6 +4,8 @@
 #include <QRegularExpression>
 #include <QTest>
 
+using namespace Qt::StringLiterals;
+
 /*!
     \internal
     The main idea of the benchmark is to compare performance of QRE classes
@@ -45,6 +47,16 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void createFromStringAndMatch();
+
+    void matchSetOneByOne_data() { matchSet_data(); }
+    void matchSetOneByOne();
+    void matchSet_data();
+    void matchSet();
+
+private:
+    static QList<QRegularExpression> routes();
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -270,6 +282,73 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+/*!
+    \internal This benchmark measures the creation of a regular expression
+    from a string followed by a match, as done by applications that build
+    their patterns from configuration or user input over and over. The
+    compiled patterns are shared through a process-wide cache.
+*/
+void tst_QRegularExpressionBenchmark::createFromStringAndMatch()
+{
+    QBENCHMARK {
+        QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+}
+
+QList<QRegularExpression> tst_QRegularExpressionBenchmark::routes()
+{
+    // a routing table
+    QList<QRegularExpression> expressions;
+    const char *const resources[] = { "users", "groups", "projects", "issues", "comments",
+                                      "files", "tags", "releases", "builds", "jobs" };
+    for (const char *resource : resources) {
+        const QString r = QString::fromLatin1(resource);
+        expressions.append(QRegularExpression(u"^/api/v1/"_s + r + u"$"_s));
+        expressions.append(QRegularExpression(u"^/api/v1/"_s + r + u"/(?<id>\\d+)$"_s));
+        expressions.append(QRegularExpression(u"^/api/v1/"_s + r + u"/\\d+/history$"_s));
+        expressions.append(QRegularExpression(u"^/api/v2/"_s + r + u"(?:/\\w+)*$"_s,
+                                              QRegularExpression::CaseInsensitiveOption));
+    }
+    return expressions;
+}
+
+void tst_QRegularExpressionBenchmark::matchSet_data()
+{
+    QTest::addColumn<QString>("subject");
+
+    QTest::newRow("no-match") << u"/static/css/main.css"_s;
+    QTest::newRow("match-early") << u"/api/v1/users/42"_s;
+    QTest::newRow("match-late") << u"/api/v2/JOBS/abc/def"_s;
+}
+
+void tst_QRegularExpressionBenchmark::matchSetOneByOne()
+{
+    QFETCH(QString, subject);
+    const QList<QRegularExpression> expressions = routes();
+    for (const QRegularExpression &re : expressions)
+        re.optimize();
+    QBENCHMARK {
+        QList<qsizetype> matching;
+        for (qsizetype i = 0; i < expressions.size(); ++i) {
+            if (expressions.at(i).match(subject).hasMatch())
+                matching.append(i);
+        }
+        Q_UNUSED(matching);
+    }
+}
+
+void tst_QRegularExpressionBenchmark::matchSet()
+{
+    QFETCH(QString, subject);
+    const QRegularExpressionSet set(routes());
+    QBENCHMARK {
+        auto matching = set.matchingIndexes(subject);
+        Q_UNUSED(matching);
+    }
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
@@ -0,0 +1,250 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSmallString>
+#include <QString>
+#include <QTest>
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#endif
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data() { data(); }
+    void construct();
+    void copy_data() { data(); }
+    void copy();
+    void compare_data() { data(); }
+    void compare();
+    void hashLookup_data() { data(); }
+    void hashLookup();
+    void memory_data();
+    void memory();
+
+private:
+    void data();
+    static QList<QString> strings(int length);
+};
+
+static constexpr int Count = 10'000;
+
+void tst_QSmallString::data()
+{
+    QTest::addColumn<bool>("small");
+    QTest::addColumn<int>("length");
+
+    for (int length : { 4, 12, 40 }) {
+        QTest::addRow("QString:%d", length) << false << length;
+        QTest::addRow("QSmallString:%d", length) << true << length;
+    }
+}
+
+QList<QString> tst_QSmallString::strings(int length)
+{
+    QList<QString> result;
+    result.reserve(Count);
+    for (int i = 0; i < Count; ++i) {
+        QString s = QString::number(i, 36);
+        result.append(s.leftJustified(length, u'_'));
+    }
+    return result;
+}
+
+// Always copies, like reading the strings from a file would.
+template <typename String> static String makeString(QStringView s)
+{
+    if constexpr (std::is_same_v<String, QString>)
+        return s.toString();
+    else if constexpr (std::is_same_v<String, QByteArray>)
+        return s.toLatin1();
+    else if constexpr (std::is_same_v<String, QSmallByteArray>)
+        return QSmallByteArray(s.toLatin1());
+    else
+        return QSmallString(s);
+}
+
+template <typename String> static void constructImpl(const QList<QString> &input)
+{
+    QBENCHMARK {
+        QList<String> list;
+        list.reserve(input.size());
+        for (const QString &s : input)
+            list.append(makeString<String>(s));
+    }
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(const bool, small);
+    QFETCH(const int, length);
+    const QList<QString> input = strings(length);
+
+    if (small)
+        constructImpl<QSmallString>(input);
+    else
+        constructImpl<QString>(input);
+}
+
+template <typename String> static void copyImpl(const QList<String> &input)
+{
+    QBENCHMARK {
+        QList<String> copy;
+        copy.reserve(input.size());
+        for (const String &s : input)
+            copy.append(s);
+    }
+}
+
+void tst_QSmallString::copy()
+{
+    QFETCH(const bool, small);
+    QFETCH(const int, length);
+    const QList<QString> input = strings(length);
+
+    if (small) {
+        QList<QSmallString> list;
+        for (const QString &s : input)
+            list.append(makeString<QSmallString>(s));
+        copyImpl(list);
+    } else {
+        QList<QString> list;
+        for (const QString &s : input)
+            list.append(makeString<QString>(s));
+        copyImpl(list);
+    }
+}
+
+template <typename String> static qsizetype compareImpl(const QList<String> &input)
+{
+    qsizetype less = 0;
+    QBENCHMARK {
+        less = 0;
+        for (qsizetype i = 1; i < input.size(); ++i)
+            less += input.at(i - 1) < input.at(i);
+    }
+    return less;
+}
+
+void tst_QSmallString::compare()
+{
+    QFETCH(const bool, small);
+    QFETCH(const int, length);
+    const QList<QString> input = strings(length);
+
+    qsizetype less = 0;
+    if (small) {
+        QList<QSmallString> list;
+        for (const QString &s : input)
+            list.append(makeString<QSmallString>(s));
+        less = compareImpl(list);
+    } else {
+        less = compareImpl(input);
+    }
+    QCOMPARE_GT(less, 0);
+}
+
+template <typename String> static qsizetype hashLookupImpl(const QList<QString> &input)
+{
+    QHash<String, int> hash;
+    for (const QString &s : input)
+        hash.insert(makeString<String>(s), 0);
+    QList<String> keys;
+    for (const QString &s : input)
+        keys.append(makeString<String>(s));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const String &key : keys)
+            found += hash.contains(key);
+    }
+    return found;
+}
+
+void tst_QSmallString::hashLookup()
+{
+    QFETCH(const bool, small);
+    QFETCH(const int, length);
+    const QList<QString> input = strings(length);
+
+    const qsizetype found = small ? hashLookupImpl<QSmallString>(input)
+                                  : hashLookupImpl<QString>(input);
+    QCOMPARE(found, input.size());
+}
+
+// Bytes currently allocated from the heap, including the allocator's own
+// bookkeeping, or -1 if that can't be determined on this platform.
+static qsizetype allocatedBytes()
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    const struct mallinfo2 info = mallinfo2();
+    return qsizetype(info.uordblks + info.hblkhd); // hblkhd: mmap()ed blocks
+#else
+    return -1;
+#endif
+}
+
+enum Type { StringType, SmallStringType, ByteArrayType, SmallByteArrayType };
+
+void tst_QSmallString::memory_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("length");
+
+    for (int length : { 4, 12, 40 }) {
+        QTest::addRow("QString:%d", length) << int(StringType) << length;
+        QTest::addRow("QSmallString:%d", length) << int(SmallStringType) << length;
+        QTest::addRow("QByteArray:%d", length) << int(ByteArrayType) << length;
+        QTest::addRow("QSmallByteArray:%d", length) << int(SmallByteArrayType) << length;
+    }
+}
+
+// Heap bytes needed to hold Count strings in a QList, list included
+template <typename String> static qsizetype memoryImpl(const QList<QString> &input)
+{
+    const qsizetype before = allocatedBytes();
+    QList<String> list;
+    list.reserve(input.size());
+    for (const QString &s : input)
+        list.append(makeString<String>(s));
+    return allocatedBytes() - before;
+}
+
+void tst_QSmallString::memory()
+{
+    QFETCH(const int, type);
+    QFETCH(const int, length);
+    const QList<QString> input = strings(length);
+
+    if (allocatedBytes() < 0)
+        QSKIP("Allocated memory can't be measured on this platform");
+
+    qsizetype bytes = 0;
+    switch (Type(type)) {
+    case StringType:
+        bytes = memoryImpl<QString>(input);
+        break;
+    case SmallStringType:
+        bytes = memoryImpl<QSmallString>(input);
+        break;
+    case ByteArrayType:
+        bytes = memoryImpl<QByteArray>(input);
+        break;
+    case SmallByteArrayType:
+        bytes = memoryImpl<QSmallByteArray>(input);
+        break;
+    }
+    QCOMPARE_GT(bytes, 0);
+    QTest::setBenchmarkResult(qreal(bytes) / input.size(), QTest::BytesAllocated);
+}
+
+QTEST_MAIN(tst_QSmallString)
+
+#include "tst_bench_qsmallstring.moc"
@@ -1,6 +1,7 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 #include <QStringList>
+#include <QStringMatcher>
 #include <QByteArray>
 #include <QLatin1StringView>
 #include <QFile>
@@ -55,6 +56,13 @@ private slots:
     void operator_assign_L1SV() { operator_assign<QLatin1StringView>(); }
     void operator_assign_L1SV_data() { operator_assign_data(); }
 
+    void compareCaseInsensitive_data();
+    void compareCaseInsensitive();
+    void indexOfCaseInsensitive_data();
+    void indexOfCaseInsensitive();
+    void matcherCaseInsensitive_data() { indexOfCaseInsensitive_data(); }
+    void matcherCaseInsensitive();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -505,6 +513,77 @@ void tst_QString::operator_assign_data()
     QTest::newRow("length: 1'000") << data;
 }
 
+void tst_QString::compareCaseInsensitive_data()
+{
+    QTest::addColumn<QString>("lhs");
+    QTest::addColumn<QString>("rhs");
+
+    const QString ascii = u"The quick brown fox jumps over the lazy dog. "_s.repeated(6);
+    const QString latin1 = u"Voilà l'été, où les élèves révisent à côté. "_s.repeated(6);
+    const QString cyrillic = u"Съешь же ещё этих мягких французских булок. "_s.repeated(6);
+
+    QTest::newRow("ascii-16") << ascii.left(16) << ascii.left(16).toUpper();
+    QTest::newRow("ascii-same") << ascii << ascii;
+    QTest::newRow("ascii-upper") << ascii << ascii.toUpper();
+    QTest::newRow("ascii-differ-at-end") << ascii + u'a' << ascii.toUpper() + u'b';
+    QTest::newRow("latin1-upper") << latin1 << latin1.toUpper();
+    QTest::newRow("cyrillic-upper") << cyrillic << cyrillic.toUpper();
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(const QString, lhs);
+    QFETCH(const QString, rhs);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = QString::compare(lhs, rhs, Qt::CaseInsensitive);
+    }
+}
+
+void tst_QString::indexOfCaseInsensitive_data()
+{
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QString>("needle");
+
+    // what a filter over a list of file or contact names looks at
+    QString ascii;
+    QString latin1;
+    QString cyrillic;
+    for (int i = 0; i < 20; ++i) {
+        ascii += u"Document %1 (final version).txt; "_s.arg(i);
+        latin1 += u"Résumé de la réunion n°%1 à Genève; "_s.arg(i);
+        cyrillic += u"Отчёт о совещании номер %1; "_s.arg(i);
+    }
+
+    QTest::newRow("ascii-short-miss") << ascii.left(120) << u"REPORT"_s;
+    QTest::newRow("ascii-miss") << ascii << u"REPORT"_s;
+    QTest::newRow("ascii-hit-at-end") << ascii + u"Report"_s << u"REPORT"_s;
+    QTest::newRow("ascii-long-needle-miss") << ascii << u"Final Version).TXT; Report"_s;
+    QTest::newRow("latin1-miss") << latin1 << u"GENÈVE 2"_s;
+    QTest::newRow("cyrillic-miss") << cyrillic << u"ПРОТОКОЛ"_s;
+}
+
+void tst_QString::indexOfCaseInsensitive()
+{
+    QFETCH(const QString, haystack);
+    QFETCH(const QString, needle);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = haystack.indexOf(needle, 0, Qt::CaseInsensitive);
+    }
+}
+
+void tst_QString::matcherCaseInsensitive()
+{
+    QFETCH(const QString, haystack);
+    QFETCH(const QString, needle);
+
+    const QStringMatcher matcher(needle, Qt::CaseInsensitive);
+    QBENCHMARK {
+        [[maybe_unused]] auto r = matcher.indexIn(haystack);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
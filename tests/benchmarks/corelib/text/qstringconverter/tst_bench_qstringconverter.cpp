@@ -0,0 +1,94 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <qbytearray.h>
+#include <qstring.h>
+#include <qstringconverter.h>
+#include <qtest.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QStringConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encodeUtf8_data() { corpus_data(); }
+    void encodeUtf8();
+    void decodeUtf8_data() { corpus_data(); }
+    void decodeUtf8();
+    void encodeUtf8Stateful_data() { corpus_data(); }
+    void encodeUtf8Stateful();
+    void decodeUtf8Stateful_data() { corpus_data(); }
+    void decodeUtf8Stateful();
+
+private:
+    void corpus_data();
+};
+
+void tst_QStringConverter::corpus_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // about 64 kB of UTF-16 for each corpus
+    const auto row = [](const char *name, QStringView sample) {
+        QString text;
+        while (text.size() < 32 * 1024)
+            text += sample;
+        QTest::newRow(name) << text;
+    };
+    row("ascii", u"The quick brown fox jumps over the lazy dog. 0123456789\n");
+    row("latin1", u"Größenwahn à la française, señor: über café crème brûlée.\n");
+    row("cyrillic", u"Съешь же ещё этих мягких французских булок, да выпей чаю.\n");
+    row("greek", u"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία.\n");
+    row("cjk", u"東京都の天気は晴れ、最高気温は二十五度です。我能吞下玻璃而不伤身体。\n");
+    row("json-cyrillic", uR"({"id": 1024, "name": "Иван Петров", "city": "Новосибирск", "active": true},
+)");
+    row("json-cjk", uR"({"id": 1024, "name": "山田太郎", "city": "北京市", "tags": ["東京", "大阪"]},
+)");
+    row("emoji", u"Status \U0001F600 \U0001F680 ok \U0001F44D\n");
+}
+
+void tst_QStringConverter::encodeUtf8()
+{
+    QFETCH(QString, text);
+    QBENCHMARK {
+        QByteArray utf8 = text.toUtf8();
+        Q_UNUSED(utf8);
+    }
+}
+
+void tst_QStringConverter::decodeUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    QBENCHMARK {
+        QString decoded = QString::fromUtf8(utf8);
+        Q_UNUSED(decoded);
+    }
+}
+
+void tst_QStringConverter::encodeUtf8Stateful()
+{
+    QFETCH(QString, text);
+    QBENCHMARK {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        QByteArray utf8 = encoder(text);
+        Q_UNUSED(utf8);
+    }
+}
+
+void tst_QStringConverter::decodeUtf8Stateful()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QString decoded = decoder(utf8);
+        Q_UNUSED(decoded);
+    }
+}
+
+QTEST_MAIN(tst_QStringConverter)
+
+#include "tst_bench_qstringconverter.moc"
@@ -3,6 +3,7 @@
 
 #include <QtCore/QtCore>
 #include <QTest>
+#include <private/qreadmostlylock_p.h>
 #include <mutex>
 #if __has_include(<shared_mutex>)
 #include <shared_mutex>
@@ -19,6 +20,21 @@ struct LockerWrapper : T
     }
 };
 
+// QReadLocker/QWriteLocker equivalents for QReadMostlyLock
+struct ReadMostlyReadLocker
+{
+    ReadMostlyReadLocker(QReadMostlyLock *lock) : lock(lock) { lock->lockForRead(); }
+    ~ReadMostlyReadLocker() { lock->unlock(); }
+    QReadMostlyLock *lock;
+};
+
+struct ReadMostlyWriteLocker
+{
+    ReadMostlyWriteLocker(QReadMostlyLock *lock) : lock(lock) { lock->lockForWrite(); }
+    ~ReadMostlyWriteLocker() { lock->unlock(); }
+    QReadMostlyLock *lock;
+};
+
 struct QRecursiveReadWriteLock : QReadWriteLock
 {
     QRecursiveReadWriteLock() : QReadWriteLock(Recursive) {}
@@ -82,6 +98,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readerScaling_data();
+    void readerScaling();
     // void readWrite();
 };
 
@@ -95,6 +113,12 @@ struct FunctionPtrHolder
 };
 Q_DECLARE_METATYPE(FunctionPtrHolder)
 
+struct ScalingFunction
+{
+    void (*value)(int) = nullptr;
+};
+Q_DECLARE_METATYPE(ScalingFunction)
+
 struct FakeLock
 {
     FakeLock(volatile int *i) { *i = 0; }
@@ -123,6 +147,10 @@ void tst_QReadWriteLock::uncontended_data()
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QReadLocker>);
     QTest::newRow("QReadWriteLock, write")
         << FunctionPtrHolder(testUncontended<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("QReadMostlyLock, read")
+        << FunctionPtrHolder(testUncontended<QReadMostlyLock, ReadMostlyReadLocker>);
+    QTest::newRow("QReadMostlyLock, write")
+        << FunctionPtrHolder(testUncontended<QReadMostlyLock, ReadMostlyWriteLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, %s, recursive: %d", "read", n) \
         << FunctionPtrHolder(testUncontended<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>); \
@@ -199,6 +227,8 @@ void tst_QReadWriteLock::readOnly_data()
     QTest::newRow("nothing") << FunctionPtrHolder(testReadOnly<int, FakeLock>);
     QTest::newRow("QMutex") << FunctionPtrHolder(testReadOnly<QMutex, QMutexLocker<QMutex>>);
     QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testReadOnly<QReadWriteLock, QReadLocker>);
+    QTest::newRow("QReadMostlyLock")
+        << FunctionPtrHolder(testReadOnly<QReadMostlyLock, ReadMostlyReadLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, recursive: %d", n) \
         << FunctionPtrHolder(testReadOnly<QRecursiveReadWriteLock, QRecursiveReadLocker<n>>)
@@ -267,6 +297,8 @@ void tst_QReadWriteLock::writeOnly_data()
     // QTest::newRow("nothing") << FunctionPtrHolder(testWriteOnly<int, FakeLock>);
     QTest::newRow("QMutex") << FunctionPtrHolder(testWriteOnly<QMutex, QMutexLocker<QMutex>>);
     QTest::newRow("QReadWriteLock") << FunctionPtrHolder(testWriteOnly<QReadWriteLock, QWriteLocker>);
+    QTest::newRow("QReadMostlyLock")
+        << FunctionPtrHolder(testWriteOnly<QReadMostlyLock, ReadMostlyWriteLocker>);
 #define ROW(n) \
     QTest::addRow("QReadWriteLock, recursive: %d", n) \
         << FunctionPtrHolder(testWriteOnly<QRecursiveReadWriteLock, QRecursiveWriteLocker<n>>)
@@ -294,5 +326,80 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+// A short read-side critical section with a write every WriteInterval reads,
+// run by a varying number of threads, like a shared configuration cache.
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReaderScaling(int readers)
+{
+    enum { ReadsPerThread = 200000, WriteInterval = 10000 };
+    static QHash<int, int> cache;
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        int sum = 0;
+        void run() override
+        {
+            for (int i = 0; i < ReadsPerThread; ++i) {
+                if (i % WriteInterval == WriteInterval - 1) {
+                    WriteLocker locker(lock);
+                    cache[i % 64] = i;
+                } else {
+                    ReadLocker locker(lock);
+                    sum += cache.value(i % 64);
+                }
+            }
+        }
+    };
+    for (int i = 0; i < 64; ++i)
+        cache[i] = i;
+    Mutex lock;
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < readers; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        threads.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : threads)
+            t->start();
+        for (auto &t : threads)
+            t->wait();
+    }
+}
+
+void tst_QReadWriteLock::readerScaling_data()
+{
+    QTest::addColumn<ScalingFunction>("function");
+    QTest::addColumn<int>("readers");
+
+    const struct {
+        const char *name;
+        void (*function)(int);
+    } locks[] = {
+        { "QReadWriteLock", testReaderScaling<QReadWriteLock, QReadLocker, QWriteLocker> },
+        { "QReadMostlyLock",
+          testReaderScaling<QReadMostlyLock, ReadMostlyReadLocker, ReadMostlyWriteLocker> },
+#ifdef __cpp_lib_shared_mutex
+        { "std::shared_mutex",
+          testReaderScaling<std::shared_mutex,
+                            LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                            LockerWrapper<std::unique_lock<std::shared_mutex>>> },
+#endif
+    };
+    for (const auto &lock : locks) {
+        for (int readers : { 1, 2, 4, 8, 16, 32, 64 }) {
+            QTest::addRow("%s, %d threads", lock.name, readers)
+                    << ScalingFunction{lock.function} << readers;
+        }
+    }
+}
+
+void tst_QReadWriteLock::readerScaling()
+{
+    QFETCH(ScalingFunction, function);
+    QFETCH(int, readers);
+    function.value(readers);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void nestedTasks_data();
+    void nestedTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,39 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::nestedTasks_data()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::newRow("shared queue") << false;
+    QTest::newRow("work stealing") << true;
+}
+
+// Many tiny tasks started from the pool's own threads, so that the pool
+// threads contend for the queue with each other
+void tst_QThreadPool::nestedTasks()
+{
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(workStealing);
+    QAtomicInt count;
+
+    std::function<void(int)> spawn = [&](int depth) {
+        count.ref();
+        if (depth == 0)
+            return;
+        for (int i = 0; i < 8; ++i)
+            threadPool.start([&spawn, depth] { spawn(depth - 1); });
+    };
+
+    QBENCHMARK {
+        count.storeRelaxed(0);
+        threadPool.start([&spawn] { spawn(5); });
+        threadPool.waitForDone();
+    }
+    QCOMPARE(count.loadRelaxed(), (8 * 8 * 8 * 8 * 8 * 8 - 1) / 7);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
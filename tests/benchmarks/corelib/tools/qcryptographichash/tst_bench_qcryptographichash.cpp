@@ -33,6 +33,10 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashOneByOne_data() { hashMany_data(); }
+    void hashOneByOne();
+    void hashMany_data();
+    void hashMany();
 
     // QMessageAuthenticationCode:
     void hmac_hash_data() { hash_data(); }
@@ -142,6 +146,59 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    QTest::addColumn<int>("messageSize");
+
+    for (int messageSize : { 16, 64, 256 }) {
+        for_each_algorithm([&] (Algorithm algo, const char *name) {
+            if (algo == Algorithm::NumAlgorithms)
+                return;
+            QTest::addRow("%s-%d", name, messageSize) << algo << messageSize;
+        });
+    }
+}
+
+static QList<QByteArrayView> messages(const QByteArray &data, int messageSize)
+{
+    QList<QByteArrayView> result;
+    for (qsizetype i = 0; i + messageSize <= data.size(); i += messageSize)
+        result.append(QByteArrayView(data).sliced(i, messageSize));
+    return result;
+}
+
+void tst_QCryptographicHash::hashOneByOne()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const int, messageSize);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    const QList<QByteArrayView> list = messages(blockOfData, messageSize);
+    QByteArray buffer(QCryptographicHash::hashLength(algo) * list.size(), Qt::Uninitialized);
+    QBENCHMARK {
+        char *out = buffer.data();
+        for (QByteArrayView message : list)
+            out += QCryptographicHash::hashInto(QSpan(out, buffer.end()), message, algo).size();
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const int, messageSize);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    const QList<QByteArrayView> list = messages(blockOfData, messageSize);
+    QByteArray buffer(QCryptographicHash::hashLength(algo) * list.size(), Qt::Uninitialized);
+    QBENCHMARK {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hashManyInto(buffer, list, algo);
+    }
+}
+
 static QByteArray hmacKey() {
     static QByteArray key = [] {
             QByteArray result(277, Qt::Uninitialized);
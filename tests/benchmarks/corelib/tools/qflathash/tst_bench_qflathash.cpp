@@ -0,0 +1,159 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QTest>
+
+#include <private/qflathash_p.h>
+
+#include <random>
+#include <unordered_map>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+    template <typename Key> using StdHash = std::unordered_map<Key, int>;
+
+private slots:
+    void initTestCase();
+
+    void insert_int_data() { data(10'000'000); }
+    void insert_int();
+    void insert_string_data() { data(1'000'000); }
+    void insert_string();
+    void findHit_int_data() { data(10'000'000); }
+    void findHit_int();
+    void findHit_string_data() { data(1'000'000); }
+    void findHit_string();
+    void findMiss_int_data() { data(10'000'000); }
+    void findMiss_int();
+    void findMiss_string_data() { data(1'000'000); }
+    void findMiss_string();
+
+private:
+    void data(int maxSize);
+    template <typename Key> static QList<Key> keys(int count, int offset = 0);
+    template <typename Key> void insert_impl();
+    template <typename Key> void find_impl(bool hit);
+};
+
+void tst_QFlatHash::initTestCase()
+{
+    QHashSeed::setDeterministicGlobalSeed();
+}
+
+void tst_QFlatHash::data(int maxSize)
+{
+    QTest::addColumn<QByteArray>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size = 1000; size <= maxSize; size *= 10) {
+        for (const char *container : { "QHash", "QFlatHash", "std::unordered_map" })
+            QTest::addRow("%s:%d", container, size) << QByteArray(container) << size;
+    }
+}
+
+template <>
+QList<int> tst_QFlatHash::keys<int>(int count, int offset)
+{
+    // spread out, but deterministic
+    std::mt19937 rng(count + offset);
+    QList<int> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i)
+        result.append(int(rng() >> 1) | (offset ? 1 : 0));
+    if (!offset) {
+        for (int &k : result)
+            k &= ~1;
+    }
+    return result;
+}
+
+template <>
+QList<QString> tst_QFlatHash::keys<QString>(int count, int offset)
+{
+    QList<QString> result;
+    result.reserve(count);
+    for (const int k : keys<int>(count, offset))
+        result.append(QLatin1StringView("/some/path/to/file-") + QString::number(k, 16));
+    return result;
+}
+
+template <typename Container, typename Key>
+static void insertAll(const QList<Key> &keys)
+{
+    Container c;
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        c[keys.at(i)] = int(i);
+}
+
+template <typename Key>
+void tst_QFlatHash::insert_impl()
+{
+    QFETCH(const QByteArray, container);
+    QFETCH(const int, size);
+    const QList<Key> list = keys<Key>(size);
+
+    if (container == "QHash") {
+        QBENCHMARK { insertAll<QHash<Key, int>>(list); }
+    } else if (container == "QFlatHash") {
+        QBENCHMARK { insertAll<QFlatHash<Key, int>>(list); }
+    } else {
+        QBENCHMARK { insertAll<StdHash<Key>>(list); }
+    }
+}
+
+template <typename Container, typename Key>
+static qsizetype findAll(const Container &c, const QList<Key> &keys)
+{
+    qsizetype found = 0;
+    for (const Key &key : keys)
+        found += c.find(key) != c.end();
+    return found;
+}
+
+template <typename Container, typename Key>
+static Container filled(const QList<Key> &keys)
+{
+    Container c;
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        c[keys.at(i)] = int(i);
+    return c;
+}
+
+template <typename Key>
+void tst_QFlatHash::find_impl(bool hit)
+{
+    QFETCH(const QByteArray, container);
+    QFETCH(const int, size);
+    const QList<Key> inserted = keys<Key>(size);
+    // inserted keys are all even, the missing ones all odd
+    const QList<Key> lookedUp = hit ? inserted : keys<Key>(size, 1);
+    qsizetype found = 0;
+
+    if (container == "QHash") {
+        const auto c = filled<QHash<Key, int>>(inserted);
+        QBENCHMARK { found = findAll(c, lookedUp); }
+    } else if (container == "QFlatHash") {
+        const auto c = filled<QFlatHash<Key, int>>(inserted);
+        QBENCHMARK { found = findAll(c, lookedUp); }
+    } else {
+        const auto c = filled<StdHash<Key>>(inserted);
+        QBENCHMARK { found = findAll(c, lookedUp); }
+    }
+    QCOMPARE(found, hit ? size : 0);
+}
+
+void tst_QFlatHash::insert_int() { insert_impl<int>(); }
+void tst_QFlatHash::insert_string() { insert_impl<QString>(); }
+void tst_QFlatHash::findHit_int() { find_impl<int>(true); }
+void tst_QFlatHash::findHit_string() { find_impl<QString>(true); }
+void tst_QFlatHash::findMiss_int() { find_impl<int>(false); }
+void tst_QFlatHash::findMiss_string() { find_impl<QString>(false); }
+
+QTEST_MAIN(tst_QFlatHash)
+
+#include "tst_bench_qflathash.moc"